@@ -96,8 +96,8 @@ if (CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
 		>
 
 		/openmp	# -> enable openmp
-		/arch:AVX
-		/arch:AVX2
+		# Kernels are compiled for several instruction sets and selected at
+		# runtime, so no /arch flag is set globally
 		# No manual c++11 enable for MSVC as all supported MSVC versions for cmake-init have C++11 implicitly enabled (MSVC >=2013)
 	)
 endif ()
@@ -107,13 +107,13 @@ if (CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang"
 	set(DEFAULT_COMPILE_OPTIONS ${DEFAULT_COMPILE_OPTIONS}
 		-Wall
 		-Wno-missing-braces
-		-mveclibabi=svml
 		-fopenmp
-		-mavx
-		-mavx2
+		# Kernels are compiled for several instruction sets and selected at
+		# runtime, so no -m<isa> flag is set globally
 		${WARN_AS_ERROR_FLAGS}
 		-std=c++1z
-		-O0
+		$<$<CONFIG:Debug>:-O0>
+		$<$<NOT:$<CONFIG:Debug>>:-O3>
 	)
 endif ()
 
@@ -128,9 +128,6 @@ if (CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_SYSTEM_NAME MATCHES "Linux")
 	set(DEFAULT_LINKER_OPTIONS
 		-pthread
 		-lstdc++fs
-		-mavx
-		-mavx2
 		-fopenmp
-		-O0
 	)
 endif()
\ No newline at end of file
@@ -0,0 +1,68 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_BINARYGEMM_HPP
+#define TAKION_COMPUTE_BINARYGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Utils/Span.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Takion::Compute
+{
+//! NumRow x NumCol matrix approximated by Scale[r] * sign of element (r, c)
+//! where Scale[r] is the mean magnitude of row r, so that it takes 1 bit
+//! per element (binarized weights and activations of XNOR networks)
+//! Bit c % 64 of Words[r * NumWords() + c / 64] is set if element (r, c) is
+//! negative. Zero has the sign of positive values, and bits past NumCol are
+//! zero, so that they never differ between rows
+struct BinaryMatrix
+{
+    static constexpr std::size_t WordBits = 64;
+
+    [[nodiscard]] std::size_t NumWords() const
+    {
+        return (NumCol + WordBits - 1) / WordBits;
+    }
+
+    std::size_t NumRow = 0;
+    std::size_t NumCol = 0;
+    std::vector<std::uint64_t> Words;
+    std::vector<float> Scale;
+};
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU::Binary
+{
+using namespace Util;
+
+//! Packs signs of numRow rows of numCol values with row length ldInput into
+//! out, with one row of out per row of input
+//! If transpose is true, input is a single matrix and out holds one row per
+//! column of input instead (e.g. weights multiplied by MultiplyAddCpu)
+void PackSignsCpu(const Span<float> input, BinaryMatrix& out,
+                  std::size_t numRow, std::size_t numCol,
+                  std::size_t ldInput, bool transpose);
+
+//! Writes Scale[r] * sign of every element (r, c) of input to out, whose
+//! rows have length ldOut
+void UnpackSignsCpu(const BinaryMatrix& input, Span<float> out,
+                    std::size_t ldOut);
+
+//! out = activation(A * B^T + bias) where A and B are the approximations
+//! stored by BinaryMatrix, with the same number of columns. out holds one
+//! row of length ldOut per row of A, and bias holds one value per row of B,
+//! or is empty
+//! Every product is a count of differing bits (XOR and popcount), which
+//! the scales of the row of A and of B multiply
+void MultiplyAddCpu(const BinaryMatrix& inputA, const BinaryMatrix& inputB,
+                    const Span<float> bias, Span<float> out,
+                    std::size_t ldOut, ActivationType activation);
+} // namespace Takion::Compute::CPU::Binary
+
+#endif
@@ -0,0 +1,107 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_CSRGEMM_HPP
+#define TAKION_COMPUTE_CSRGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Utils/Span.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Takion::Compute
+{
+//! NumRow() x NumCol matrix in compressed sparse row format (e.g. batch of
+//! sparse input features with one row per sample)
+//! Row r holds Values[RowOffsets[r]] to Values[RowOffsets[r + 1] - 1] at
+//! columns Columns[RowOffsets[r]] to Columns[RowOffsets[r + 1] - 1]
+template <typename T>
+struct CsrMatrix
+{
+    [[nodiscard]] std::size_t NumRow() const
+    {
+        return RowOffsets.size() - 1;
+    }
+
+    [[nodiscard]] std::size_t NumNonZeros() const
+    {
+        return Values.size();
+    }
+
+    //! Appends row holding values at columns
+    void AppendRow(const std::vector<std::uint32_t>& columns,
+                   const std::vector<T>& values)
+    {
+        Columns.insert(Columns.end(), columns.begin(), columns.end());
+        Values.insert(Values.end(), values.begin(), values.end());
+        RowOffsets.emplace_back(Values.size());
+    }
+
+    std::size_t NumCol = 0;
+    std::vector<std::size_t> RowOffsets = { 0 };
+    std::vector<std::uint32_t> Columns;
+    std::vector<T> Values;
+};
+
+//! NumRow x NumCol matrix of which only rows Rows are stored, and the
+//! others are zero (e.g. gradient of weights read by sparse inputs)
+//! Values holds row Rows[i] in elements i * NumCol to (i + 1) * NumCol - 1
+template <typename T>
+struct RowSparseMatrix
+{
+    std::size_t NumRow = 0;
+    std::size_t NumCol = 0;
+    std::vector<std::uint32_t> Rows;
+    std::vector<T> Values;
+};
+} // namespace Takion::Compute
+
+//! Products of CsrMatrix A with dense B, which only read rows of B at the
+//! columns of the non-zero elements of A
+//! Rows of dense operands are ld elements apart
+namespace Takion::Compute::CPU::Float
+{
+using namespace Util;
+
+//! out = activation(scale * A * B + C) where B is k x n and out holds
+//! A.NumRow() rows, m rows per matrix. C has the layout of out, or holds a
+//! single matrix added to every matrix of out if broadCastC is true
+//! No C is added if inputC is empty
+void CsrMultiplyAddCpu(const CsrMatrix<float>& inputA,
+                       const Span<float> inputB, const Span<float> inputC,
+                       Span<float> out, std::size_t m, std::size_t n,
+                       std::size_t ldB, std::size_t ldOut, bool broadCastC,
+                       ActivationType activation, float scale);
+
+//! out = A^T * B / batchSize where B holds A.NumRow() rows of n elements
+//! Only rows of A^T at columns of A which have a non-zero element are
+//! computed, and their indices are written to out.Rows in ascending order
+void CsrMultiplyTransposedMeanCpu(const CsrMatrix<float>& inputA,
+                                  const Span<float> inputB, std::size_t n,
+                                  std::size_t ldB, std::size_t batchSize,
+                                  RowSparseMatrix<float>& out);
+} // namespace Takion::Compute::CPU::Float
+
+namespace Takion::Compute::CPU::Double
+{
+using namespace Util;
+
+//! See Float::CsrMultiplyAddCpu
+void CsrMultiplyAddCpu(const CsrMatrix<double>& inputA,
+                       const Span<double> inputB, const Span<double> inputC,
+                       Span<double> out, std::size_t m, std::size_t n,
+                       std::size_t ldB, std::size_t ldOut, bool broadCastC,
+                       ActivationType activation, double scale);
+
+//! See Float::CsrMultiplyTransposedMeanCpu
+void CsrMultiplyTransposedMeanCpu(const CsrMatrix<double>& inputA,
+                                  const Span<double> inputB, std::size_t n,
+                                  std::size_t ldB, std::size_t batchSize,
+                                  RowSparseMatrix<double>& out);
+} // namespace Takion::Compute::CPU::Double
+
+#endif
@@ -0,0 +1,98 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_GEMMEPILOGUE_HPP
+#define TAKION_COMPUTE_GEMMEPILOGUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Takion::Compute
+{
+//! Activations which can be applied to the output of GEMM in the same pass
+enum class ActivationType
+{
+    None,
+    ReLU,
+    //! Same as ReLU unit (slope of LeakyReLUSlope for negative inputs)
+    LeakyReLU,
+    Sigmoid,
+};
+
+constexpr float LeakyReLUSlope = 0.1f;
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU
+{
+//! Work applied to each tile of C while it is still in registers, after
+//! the last block of k has been accumulated
+//! C = Activation(Scale * A * B + C (if accumulating) + Bias)
+template <typename T>
+struct GemmEpilogue
+{
+    //! Element (i, j) of bias is Bias[i * BiasRowStride + j], so a stride of
+    //! zero adds the same row to every row of C. No bias is added if nullptr
+    const T* Bias = nullptr;
+    std::size_t BiasRowStride = 0;
+    T Scale = static_cast<T>(1);
+    ActivationType Activation = ActivationType::None;
+};
+
+//! Type of the values u8 x s8 GEMM writes
+enum class QuantizedOutput
+{
+    //! Accumulators themselves
+    Int32,
+    //! Requantized real values
+    Float,
+    //! Requantized values quantized again to uint8
+    UInt8,
+};
+
+//! Work applied to each tile of int32 accumulators of u8 x s8 GEMM once
+//! the last block of k has been accumulated
+//! If Output is not Int32, column j of the result is
+//! real = Activation(Scale[j * ScaleStride] *
+//!                   (acc - ZeroPointA * ColumnSumB[j]) + Bias[j])
+//! which is written to FloatOut, or to UInt8Out as
+//! clamp(round(real / OutputScale) + OutputZeroPoint, 0, 255)
+struct QuantizedEpilogue
+{
+    QuantizedOutput Output = QuantizedOutput::Int32;
+    float* FloatOut = nullptr;
+    std::uint8_t* UInt8Out = nullptr;
+    //! Row length of FloatOut or UInt8Out
+    std::size_t LdOut = 0;
+
+    //! Stride of zero uses the same scale for every column (per tensor)
+    const float* Scale = nullptr;
+    std::size_t ScaleStride = 0;
+    std::int32_t ZeroPointA = 0;
+    //! Sum of every column of B. Only read if ZeroPointA is not zero
+    const std::int32_t* ColumnSumB = nullptr;
+    //! One value per column. No bias is added if nullptr
+    const float* Bias = nullptr;
+    ActivationType Activation = ActivationType::None;
+    float OutputScale = 1.0f;
+    std::int32_t OutputZeroPoint = 0;
+};
+
+//! Converts dot products of signs computed by binary GEMM to real values
+//! Element (i, j) of the result is
+//! Activation(RowScale[i] * ColumnScale[j] * dot + Bias[j])
+struct BinaryEpilogue
+{
+    //! One value per row of A
+    const float* RowScale = nullptr;
+    //! One value per column of the result
+    const float* ColumnScale = nullptr;
+    //! One value per column. No bias is added if nullptr
+    const float* Bias = nullptr;
+    ActivationType Activation = ActivationType::None;
+};
+} // namespace Takion::Compute::CPU
+
+#endif
@@ -0,0 +1,135 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_GEMMTUNER_HPP
+#define TAKION_COMPUTE_GEMMTUNER_HPP
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelRegistry.hpp>
+#include <Takion/Computations/Simd/InstructionSet.hpp>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Takion::Compute
+{
+//! GEMM blocking is tuned for. M, N and K are dimensions of the product
+//! after the batch is folded into rows (see KernelRegistry.cpp)
+struct GemmTuningKey
+{
+    DataType Type = DataType::Float32;
+    CPU::InstructionSet Isa = CPU::InstructionSet::Scalar;
+    KernelLayout Layout = KernelLayout::RowMajor;
+    std::size_t M = 0;
+    std::size_t N = 0;
+    std::size_t K = 0;
+
+    bool operator==(const GemmTuningKey& other) const
+    {
+        return Type == other.Type && Isa == other.Isa &&
+               Layout == other.Layout && M == other.M && N == other.N &&
+               K == other.K;
+    }
+};
+
+struct GemmTuningKeyHash
+{
+    std::size_t operator()(const GemmTuningKey& key) const
+    {
+        auto hash = KernelKeyHash()(
+            { KernelOp::Multiply, key.Type, key.Isa, BroadcastMode::None,
+              key.Layout });
+        for (const auto dimension : { key.M, key.N, key.K })
+            hash = hash * 1000003 ^ dimension;
+        return hash;
+    }
+};
+
+//! Chooses cache blocking of GEMMs by benchmarking candidate blockings for
+//! every shape units run (see UnitManager::Compile)
+//! Tuning is enabled by SetEnabled or TAKION_GEMM_TUNING=1. Tuned blockings
+//! are kept in the cache file given by SetCachePath or
+//! TAKION_GEMM_TUNING_CACHE, which is loaded when the tuner is first used.
+//! Shapes are therefore benchmarked once, and later runs reuse the cached
+//! results without enabling tuning
+class GemmTuner
+{
+public:
+    static GemmTuner& Get();
+
+    void SetEnabled(bool enabled);
+
+    [[nodiscard]] bool IsEnabled() const;
+
+    //! Loads blockings cached in path and saves newly tuned ones to it
+    //! Empty path keeps tuned blockings in memory only
+    //! Throws std::runtime_error if the file exists but cannot be parsed
+    void SetCachePath(const std::string& path);
+
+    [[nodiscard]] std::string CachePath() const;
+
+    //! Returns cached blocking for key. If there is none, key is tuned when
+    //! tuning is enabled, and default blocking is returned otherwise
+    [[nodiscard]] CPU::GemmBlocking Resolve(const GemmTuningKey& key);
+
+    //! Benchmarks candidate blockings for key and caches the fastest one
+    //! Keys of instruction sets the processor does not support are not
+    //! benchmarked and get default blocking
+    CPU::GemmBlocking Tune(const GemmTuningKey& key);
+
+    [[nodiscard]] std::optional<CPU::GemmBlocking> Find(
+        const GemmTuningKey& key) const;
+
+    //! Adds blockings cached in path, replacing ones of the same keys
+    //! Missing file is treated as an empty cache
+    //! Throws std::runtime_error if the file cannot be parsed
+    void Load(const std::string& path);
+
+    //! Writes every cached blocking to path
+    //! Throws std::runtime_error if the file cannot be written
+    void Save(const std::string& path) const;
+
+    //! Forgets cached blockings without touching the cache file
+    void Clear();
+
+    //! Blockings benchmarked by Tune
+    [[nodiscard]] static std::vector<CPU::GemmBlocking> Candidates();
+
+private:
+    GemmTuner();
+
+    mutable std::mutex m_mutex;
+    bool m_enabled = false;
+    std::string m_cachePath;
+    std::unordered_map<GemmTuningKey, CPU::GemmBlocking, GemmTuningKeyHash>
+        m_blockings;
+};
+
+//! Returns key of the GEMM run by the kernel of given broadcast mode and
+//! layout for arguments, on the instruction set kernels are currently
+//! dispatched to. Batches the kernel folds into rows are folded into M
+template <typename T>
+GemmTuningKey MakeGemmTuningKey(const GemmArguments<T>& arguments,
+                                BroadcastMode broadcast, KernelLayout layout)
+{
+    const bool transposeA = layout == KernelLayout::TransposeA ||
+                            layout == KernelLayout::TransposeAB;
+    const bool folded = broadcast == BroadcastMode::BroadcastB &&
+                        !transposeA &&
+                        (!arguments.BroadCastC || arguments.M == 1);
+    return { DataTypeOfV<T>,
+             CPU::GetInstructionSet(),
+             layout,
+             folded ? arguments.M * arguments.NumMatrices : arguments.M,
+             arguments.N,
+             arguments.K };
+}
+} // namespace Takion::Compute
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_HALFGEMM_HPP
+#define TAKION_COMPUTE_HALFGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/Kernels/MathFunction.hpp>
+#include <Takion/Utils/HalfPrecision.hpp>
+#include <Takion/Utils/Span.hpp>
+
+//! Computations on tensors stored in 16 bit types (Float16 or BFloat16)
+//! Operands are converted to float when they are loaded, products are
+//! accumulated in float and results are rounded only when they are stored.
+//! Operands of GEMM may also be stored in float, so that float gradients can
+//! be multiplied with 16 bit weights and activations
+//! Every function is instantiated for both 16 bit types
+namespace Takion::Compute::CPU::Half
+{
+using namespace Util;
+
+//! out = op(A) * op(B) (see GemmArguments)
+//! At least one of TA and TB is a 16 bit type. TOut is float or the 16 bit
+//! type of the operands
+template <typename TA, typename TB, typename TOut>
+void MultiplyCpu(const Span<TA> inputA, const Span<TB> inputB,
+                 Span<TOut> out, std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastA, bool broadCastB,
+                 bool transposeA, bool transposeB);
+
+//! out = activation(scale * A * B + C) (see GemmArguments)
+//! C is stored in TOut
+template <typename TA, typename TB, typename TOut>
+void MultiplyAddCpu(const Span<TA> inputA, const Span<TB> inputB,
+                    const Span<TOut> inputC, Span<TOut> out, std::size_t m,
+                    std::size_t n, std::size_t k, std::size_t ldA,
+                    std::size_t ldB, std::size_t ldOut,
+                    std::size_t numMatrices, bool broadCastA, bool broadCastB,
+                    bool broadCastC, ActivationType activation, float scale);
+
+//! out = A^T * B / batchSize (see KernelOp::MultiplyTransposedMean)
+template <typename TA, typename TB, typename TOut>
+void MultiplyTransposedMeanCpu(const Span<TA> inputA, const Span<TB> inputB,
+                               Span<TOut> out, std::size_t m, std::size_t n,
+                               std::size_t k, std::size_t ldA,
+                               std::size_t ldB, std::size_t ldOut,
+                               std::size_t batchSize);
+
+//! Converts numRow rows of numCol elements between float and a 16 bit type,
+//! rounding to nearest even. ldInput and ldOut are row lengths of the stored
+//! rows, which differ as rows are padded to a number of bytes
+template <typename TIn, typename TOut>
+void ConvertCpu(const Span<TIn> input, Span<TOut> out, std::size_t numRow,
+                std::size_t numCol, std::size_t ldInput, std::size_t ldOut);
+
+//! Elementwise operations over batchSize blocks of size elements
+//! Broadcast operands hold a single block shared by the whole batch
+template <typename T16>
+void AddCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB);
+
+template <typename T16>
+void SubCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB);
+
+template <typename T16>
+void DotCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB);
+
+template <typename T16>
+void DivCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB);
+
+template <typename T16>
+void ScalarMulCpu(const Span<T16> input, float toMul, Span<T16> out,
+                  std::size_t size, std::size_t batchSize);
+
+template <typename T16>
+void ScalarDivCpu(const Span<T16> input, float toDiv, Span<T16> out,
+                  std::size_t size, std::size_t batchSize);
+
+template <typename T16>
+void SetCpu(Span<T16> data, float toSet, std::size_t size,
+            std::size_t batchSize);
+
+//! out = function(input) evaluated in float with SIMD approximations
+template <typename T16>
+void ApplyCpu(const Span<T16> input, Span<T16> out, std::size_t size,
+              std::size_t batchSize, MathFunction function);
+} // namespace Takion::Compute::CPU::Half
+
+#endif
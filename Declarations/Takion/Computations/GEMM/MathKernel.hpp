@@ -7,252 +7,817 @@
 #ifndef TAKION_COMPUTE_MATHKERNEL_HPP
 #define TAKION_COMPUTE_MATHKERNEL_HPP
 
-#include <Takion/Computations/GEMM/FloatGemm.hpp>
-#include <Takion/Computations/GEMM/IntegerGemm.hpp>
+#include <Takion/Computations/GEMM/BinaryGemm.hpp>
+#include <Takion/Computations/GEMM/CsrGemm.hpp>
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/HalfGemm.hpp>
+#include <Takion/Computations/GEMM/QuantizedGemm.hpp>
+#include <Takion/Computations/GEMM/SparseGemm.hpp>
+#include <Takion/Computations/Kernels/KernelRegistry.hpp>
+#include <Takion/Computations/Kernels/MathFunction.hpp>
+#include <Takion/Computations/Reductions/Reduction.hpp>
 #include <Takion/Tensors/Tensor.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <type_traits>
 
 namespace Takion::Compute
 {
+//! Throws std::invalid_argument unless out can hold op(A) * op(B), where A or
+//! B may have batch size of 1 to be shared by every sample of the other
 template <typename T>
-void MultiplyAdd(const Tensor<T>& A, const Tensor<T>& B, const Tensor<T>& C,
-                 Tensor<T>& out)
+void CheckMultiplyArguments(const Tensor<T>& A, const Tensor<T>& B,
+                            const Tensor<T>& out, bool transposeA,
+                            bool transposeB)
 {
-    const auto device = out.Device;
     const auto outputShape = out.TensorShape;
     const auto inputShapeA = A.TensorShape;
     const auto inputShapeB = B.TensorShape;
+    const auto m = outputShape.NumRow();
+    const auto n = outputShape.NumCol();
+    const auto k = transposeA ? inputShapeA.NumRow() : inputShapeA.NumCol();
+    const auto numRowA =
+        transposeA ? inputShapeA.NumCol() : inputShapeA.NumRow();
+    const auto numRowB =
+        transposeB ? inputShapeB.NumCol() : inputShapeB.NumRow();
+    const auto numColB =
+        transposeB ? inputShapeB.NumRow() : inputShapeB.NumCol();
 
-    if (device.Type() == DeviceType::CPU)
+    if (numRowA != m || numRowB != k || numColB != n)
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : " +
+            inputShapeA.ToString() + " B : " + inputShapeB.ToString() +
+            " out : " + outputShape.ToString());
+
+    if (A.BatchSize != B.BatchSize && A.BatchSize != 1 && B.BatchSize != 1)
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+
+    const auto matricesPerSample = out.NumMatrix() / out.BatchSize;
+    if (out.BatchSize != std::max(A.BatchSize, B.BatchSize) ||
+        A.NumMatrix() / A.BatchSize != matricesPerSample ||
+        B.NumMatrix() / B.BatchSize != matricesPerSample)
+        throw std::invalid_argument(
+            "Number of matrices mismatch between given tensors");
+}
+
+//! Returns which of A and B holds a single sample shared by the batch of the
+//! other
+//! Throws std::invalid_argument if batch sizes differ and neither of them
+//! is 1
+template <typename TA, typename TB>
+BroadcastMode GetBroadcastMode(const Tensor<TA>& A, const Tensor<TB>& B)
+{
+    if (A.BatchSize == B.BatchSize)
+        return BroadcastMode::None;
+    if (A.BatchSize == 1)
+        return BroadcastMode::BroadcastA;
+    if (B.BatchSize == 1)
+        return BroadcastMode::BroadcastB;
+    throw std::invalid_argument("Batch size mismatch between given tensors");
+}
+
+//! Returns operands of GEMM kernels for out = op(A) * op(B)
+//! Throws std::invalid_argument if shapes or batch sizes of tensors mismatch
+template <typename T>
+GemmArguments<T> MakeGemmArguments(const Tensor<T>& A, const Tensor<T>& B,
+                                   Tensor<T>& out, bool transposeA,
+                                   bool transposeB)
+{
+    CheckMultiplyArguments(A, B, out, transposeA, transposeB);
+
+    GemmArguments<T> arguments;
+    arguments.A = A.Data.Address(0);
+    arguments.B = B.Data.Address(0);
+    arguments.Out = out.Data.Address(0);
+    arguments.M = out.TensorShape.NumRow();
+    arguments.N = out.TensorShape.NumCol();
+    arguments.K =
+        transposeA ? A.TensorShape.NumRow() : A.TensorShape.NumCol();
+    arguments.LdA = A.ColumnElementSize();
+    arguments.LdB = B.ColumnElementSize();
+    arguments.LdOut = out.ColumnElementSize();
+    arguments.NumMatrices = out.NumMatrix();
+    arguments.BatchSize = out.BatchSize;
+    return arguments;
+}
+
+//! Returns operands of GEMM kernels for out = activation(scale * A * B + C)
+//! C may have batch size of 1, in which case it is added to every sample
+//! (e.g. bias)
+//! Throws std::invalid_argument if shapes or batch sizes of tensors mismatch
+template <typename T>
+GemmArguments<T> MakeGemmArguments(const Tensor<T>& A, const Tensor<T>& B,
+                                   const Tensor<T>& C, Tensor<T>& out,
+                                   ActivationType activation, T scale)
+{
+    if (C.BatchSize != out.BatchSize && C.BatchSize != 1)
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+
+    auto arguments = MakeGemmArguments(A, B, out, false, false);
+    arguments.C = C.Data.Address(0);
+    arguments.BroadCastC = C.BatchSize != out.BatchSize;
+    arguments.Activation = activation;
+    arguments.Scale = scale;
+    return arguments;
+}
+
+//! Returns operands of elementwise kernels computing every sample of out
+//! from A and B
+template <typename T>
+ElementwiseArguments<T> MakeElementwiseArguments(const Tensor<T>& A,
+                                                 const Tensor<T>& B,
+                                                 Tensor<T>& out)
+{
+    ElementwiseArguments<T> arguments;
+    arguments.A = A.Data.Address(0);
+    arguments.B = B.Data.Address(0);
+    arguments.Out = out.Data.Address(0);
+    arguments.Size = out.ElementSize();
+    arguments.BatchSize = out.BatchSize;
+    return arguments;
+}
+
+//! out = activation(scale * A * B + C)
+//! C and activation are applied to every tile of out while it is computed,
+//! so out is written only once. C may have batch size of 1, in which case it
+//! is added to every sample (e.g. bias)
+template <typename T>
+void MultiplyAdd(const Tensor<T>& A, const Tensor<T>& B, const Tensor<T>& C,
+                 Tensor<T>& out,
+                 ActivationType activation = ActivationType::None,
+                 T scale = static_cast<T>(1))
+{
+    if (out.Device.Type() != DeviceType::CPU)
+        throw std::runtime_error("Not implemented");
+
+    if constexpr (IsHalfPrecisionV<T>)
     {
-        if (A.BatchSize == B.BatchSize)
-        {
-            if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            {
-                CPU::Float::MultiplyCpu(
-                    A.Data, B.Data, out.Data, inputShapeA.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix());
-
-                CPU::Float::AddCpu(out.Data, C.Data, out.Data,
-                                   out.ElementSize(), out.BatchSize);
-            }
-            else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            {
-                CPU::Int::MultiplyCpu(
-                    A.Data, B.Data, out.Data, inputShapeA.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix());
-
-                CPU::Int::AddCpu(out.Data, C.Data, out.Data,
-                                 out.ElementSize(), out.BatchSize);
-            }
-        }
-        else if (A.BatchSize == 1)
-        {
-            if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            {
-                CPU::Float::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), true);
-
-                CPU::Int::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), true);
-            }
-            else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            {
-                CPU::Int::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), true);
-
-                CPU::Int::AddWithBroadcastCpu(out.Data, C.Data, out.Data,
-                                              out.ElementSize(), out.BatchSize,
-                                              true);
-            }
-        }
-        else if (B.BatchSize == 1)
-        {
-            if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            {
-                CPU::Float::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), false);
-
-                CPU::Float::AddWithBroadcastCpu(out.Data, C.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize, false);
-            }
-            else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            {
-                CPU::Int::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), false);
-
-                CPU::Int::AddWithBroadcastCpu(out.Data, C.Data, out.Data,
-                                              out.ElementSize(), out.BatchSize,
-                                              false);
-            }
-        }
-        else
-        {
+        if (C.BatchSize != out.BatchSize && C.BatchSize != 1)
             throw std::invalid_argument(
                 "Batch size mismatch between given tensors");
-        }
+        const auto broadcast = GetBroadcastMode(A, B);
+        CPU::Half::MultiplyAddCpu(
+            A.Data, B.Data, C.Data, out.Data, A.TensorShape.NumRow(),
+            B.TensorShape.NumCol(), B.TensorShape.NumRow(),
+            A.ColumnElementSize(), B.ColumnElementSize(),
+            out.ColumnElementSize(), out.NumMatrix(),
+            broadcast == BroadcastMode::BroadcastA,
+            broadcast == BroadcastMode::BroadcastB,
+            C.BatchSize != out.BatchSize, activation,
+            static_cast<float>(scale));
     }
     else
     {
-        std::runtime_error("Not implemented");
+        const auto arguments =
+            MakeGemmArguments(A, B, C, out, activation, scale);
+        ResolveGemmKernel<T>(KernelOp::MultiplyAdd, GetBroadcastMode(A, B),
+                             KernelLayout::RowMajor)(arguments);
     }
 }
 
+//! out = op(A) * op(B) where op(X) is X, or X transposed if its transpose
+//! flag is set. Transposed operands are read in place, so no transposed copy
+//! of them is made
 template <typename T>
-void Multiply(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
+void Multiply(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out,
+              bool transposeA, bool transposeB)
 {
-    const auto device = out.Device;
-    const auto outputShape = out.TensorShape;
-    const auto inputShapeA = A.TensorShape;
-    const auto inputShapeB = B.TensorShape;;
+    if (out.Device.Type() != DeviceType::CPU)
+        throw std::runtime_error("Not implemented");
 
-    if (device.Type() == DeviceType::CPU)
+    if constexpr (IsHalfPrecisionV<T>)
     {
-        if (A.BatchSize == B.BatchSize)
-        {
-            if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-                CPU::Float::MultiplyCpu(
-                    A.Data, B.Data, out.Data, inputShapeA.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix());
-            else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-                CPU::Int::MultiplyCpu(
-                    A.Data, B.Data, out.Data, inputShapeA.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix());
-        }
-        else if (A.BatchSize == 1)
-        {
-            if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-                CPU::Float::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), true);
-            else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-                CPU::Int::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), true);
-        }
-        else if (B.BatchSize == 1)
-        {
-            if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-                CPU::Float::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), false);
-            else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-                CPU::Int::MultiplyWithBroadcastCpu(
-                    A.Data, B.Data, out.Data, outputShape.NumRow(),
-                    A.ColumnElementSize(), inputShapeB.NumRow(),
-                    B.ColumnElementSize(), out.NumMatrix(), false);
-        }
-        else
-        {
-            throw std::invalid_argument(
-                "Batch size mismatch between given tensors");
-        }
+        CheckMultiplyArguments(A, B, out, transposeA, transposeB);
+        const auto broadcast = GetBroadcastMode(A, B);
+        CPU::Half::MultiplyCpu(
+            A.Data, B.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(),
+            transposeA ? A.TensorShape.NumRow() : A.TensorShape.NumCol(),
+            A.ColumnElementSize(), B.ColumnElementSize(),
+            out.ColumnElementSize(), out.NumMatrix(),
+            broadcast == BroadcastMode::BroadcastA,
+            broadcast == BroadcastMode::BroadcastB, transposeA, transposeB);
     }
     else
     {
-        throw std::runtime_error("Not implemented");
+        const auto arguments =
+            MakeGemmArguments(A, B, out, transposeA, transposeB);
+        ResolveGemmKernel<T>(KernelOp::Multiply, GetBroadcastMode(A, B),
+                             ToKernelLayout(transposeA, transposeB))(
+            arguments);
     }
 }
 
 template <typename T>
-void Transpose(const Tensor<T>& in, Tensor<T>& out)
+void Multiply(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
 {
-    const auto matSize = out.NumMatrix();
-    const auto inputShape = in.TensorShape;
-    const auto numRow = inputShape.NumRow();
-    const auto numCol = inputShape.NumCol();
+    Multiply(A, B, out, false, false);
+}
 
-#pragma omp parallel for schedule(static) default(shared)
-    for (long matIdx = 0; static_cast<std::size_t>(matIdx) < matSize; ++matIdx)
+//! Throws std::invalid_argument unless out can hold A * B, where B may be a
+//! single matrix with batch size of 1 shared by every sample of A
+template <typename TA, typename TB, typename TOut>
+void CheckQuantizedMultiplyArguments(const Tensor<TA>& A, const Tensor<TB>& B,
+                                     const Tensor<TOut>& out)
+{
+    if (A.TensorShape.NumCol() != B.TensorShape.NumRow() ||
+        A.TensorShape.NumRow() != out.TensorShape.NumRow() ||
+        B.TensorShape.NumCol() != out.TensorShape.NumCol())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : " +
+            A.TensorShape.ToString() + " B : " + B.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if ((B.BatchSize != A.BatchSize && B.BatchSize != 1) ||
+        out.BatchSize != A.BatchSize)
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+
+    // Shared B is a single matrix multiplied with every matrix of A
+    const auto numMatricesB =
+        B.BatchSize != A.BatchSize ? std::size_t(1) : out.NumMatrix();
+    if (A.NumMatrix() != out.NumMatrix() || B.NumMatrix() != numMatricesB)
+        throw std::invalid_argument(
+            "Number of matrices mismatch between given tensors");
+}
+
+//! out = A * B for uint8 A and int8 B, accumulated in int32
+//! B may have batch size of 1, in which case it is shared by every sample
+//! (e.g. weights). See QuantizedGemm.hpp for the range of exact weights
+inline void Multiply(const Tensor<std::uint8_t>& A,
+                     const Tensor<std::int8_t>& B, Tensor<std::int32_t>& out)
+{
+    CheckQuantizedMultiplyArguments(A, B, out);
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Quantized::MultiplyCpu(
+            A.Data, B.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), A.TensorShape.NumCol(),
+            A.ColumnElementSize(), B.ColumnElementSize(),
+            out.ColumnElementSize(), out.NumMatrix(),
+            B.BatchSize != A.BatchSize);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = A * B for uint8 A and int8 B, with int32 accumulators converted by
+//! requantization (see Requantization) before they are stored
+//! T is float for real outputs, or uint8 to feed the next quantized layer
+template <typename T>
+void Multiply(const Tensor<std::uint8_t>& A, const Tensor<std::int8_t>& B,
+              Tensor<T>& out, const Requantization& requantization)
+{
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, std::uint8_t>,
+                  "Requantized output should be float or uint8");
+    CheckQuantizedMultiplyArguments(A, B, out);
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Quantized::MultiplyCpu(
+            A.Data, B.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), A.TensorShape.NumCol(),
+            A.ColumnElementSize(), B.ColumnElementSize(),
+            out.ColumnElementSize(), out.NumMatrix(),
+            B.BatchSize != A.BatchSize, requantization);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Throws std::invalid_argument unless out can hold A * B for sparse B
+inline void CheckSparseMultiplyArguments(const Tensor<float>& A,
+                                         const SparseMatrix& B,
+                                         const Tensor<float>& out)
+{
+    if (A.TensorShape.NumCol() != B.NumRow ||
+        A.TensorShape.NumRow() != out.TensorShape.NumRow() ||
+        B.NumCol != out.TensorShape.NumCol())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : " +
+            A.TensorShape.ToString() + " B : (" + std::to_string(B.NumRow) +
+            ", " + std::to_string(B.NumCol) +
+            ") out : " + out.TensorShape.ToString());
+
+    if (out.BatchSize != A.BatchSize || A.NumMatrix() != out.NumMatrix())
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+}
+
+//! out = activation(scale * A * B + C) for sparse B shared by every sample
+//! (e.g. pruned weights). C may have batch size of 1, in which case it is
+//! added to every sample (e.g. bias). See SparseGemm.hpp
+inline void MultiplyAdd(const Tensor<float>& A, const SparseMatrix& B,
+                        const Tensor<float>& C, Tensor<float>& out,
+                        ActivationType activation = ActivationType::None,
+                        float scale = 1.0f)
+{
+    CheckSparseMultiplyArguments(A, B, out);
+    if (C.TensorShape != out.TensorShape ||
+        (C.BatchSize != out.BatchSize && C.BatchSize != 1))
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. C : " +
+            C.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Sparse::MultiplyAddCpu(
+            A.Data, B, C.Data, out.Data, out.TensorShape.NumRow(),
+            A.ColumnElementSize(), out.ColumnElementSize(), out.NumMatrix(),
+            C.BatchSize != out.BatchSize, activation, scale);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = A * B for sparse B shared by every sample of A
+inline void Multiply(const Tensor<float>& A, const SparseMatrix& B,
+                     Tensor<float>& out)
+{
+    CheckSparseMultiplyArguments(A, B, out);
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Sparse::MultiplyAddCpu(
+            A.Data, B, {}, out.Data, out.TensorShape.NumRow(),
+            A.ColumnElementSize(), out.ColumnElementSize(), out.NumMatrix(),
+            false, ActivationType::None, 1.0f);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Throws std::invalid_argument unless out can hold A * B for A in
+//! compressed sparse row format with one row per row of out, and B with a
+//! single matrix shared by every row
+template <typename T>
+void CheckCsrMultiplyArguments(const CsrMatrix<T>& A, const Tensor<T>& B,
+                               const Tensor<T>& out)
+{
+    if (A.NumCol != B.TensorShape.NumRow() ||
+        A.NumRow() != out.NumMatrix() * out.TensorShape.NumRow() ||
+        B.TensorShape.NumCol() != out.TensorShape.NumCol())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : (" +
+            std::to_string(A.NumRow()) + ", " + std::to_string(A.NumCol) +
+            ") B : " + B.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (B.NumMatrix() != 1)
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+}
+
+//! out = activation(scale * A * B + C) for A in compressed sparse row format
+//! with one row per row of out (e.g. batch of sparse input features) and B
+//! shared by every row (e.g. weights). Only rows of B at columns of the
+//! non-zero elements of A are read. C may have batch size of 1, in which
+//! case it is added to every sample (e.g. bias)
+template <typename T>
+void MultiplyAdd(const CsrMatrix<T>& A, const Tensor<T>& B,
+                 const Tensor<T>& C, Tensor<T>& out,
+                 ActivationType activation = ActivationType::None,
+                 T scale = static_cast<T>(1))
+{
+    CheckCsrMultiplyArguments(A, B, out);
+    if (C.TensorShape != out.TensorShape ||
+        (C.BatchSize != out.BatchSize && C.BatchSize != 1))
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. C : " +
+            C.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (out.Device.Type() != DeviceType::CPU)
+        throw std::runtime_error("Not implemented");
+
+    if constexpr (std::is_same_v<T, float>)
+        CPU::Float::CsrMultiplyAddCpu(
+            A, B.Data, C.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), B.ColumnElementSize(),
+            out.ColumnElementSize(), C.BatchSize != out.BatchSize, activation,
+            scale);
+    else if constexpr (std::is_same_v<T, double>)
+        CPU::Double::CsrMultiplyAddCpu(
+            A, B.Data, C.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), B.ColumnElementSize(),
+            out.ColumnElementSize(), C.BatchSize != out.BatchSize, activation,
+            scale);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = A * B for A in compressed sparse row format (see MultiplyAdd)
+template <typename T>
+void Multiply(const CsrMatrix<T>& A, const Tensor<T>& B, Tensor<T>& out)
+{
+    CheckCsrMultiplyArguments(A, B, out);
+
+    if (out.Device.Type() != DeviceType::CPU)
+        throw std::runtime_error("Not implemented");
+
+    if constexpr (std::is_same_v<T, float>)
+        CPU::Float::CsrMultiplyAddCpu(
+            A, B.Data, {}, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), B.ColumnElementSize(),
+            out.ColumnElementSize(), false, ActivationType::None, 1.0f);
+    else if constexpr (std::is_same_v<T, double>)
+        CPU::Double::CsrMultiplyAddCpu(
+            A, B.Data, {}, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), B.ColumnElementSize(),
+            out.ColumnElementSize(), false, ActivationType::None, 1.0);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = mean of A^T * B over the batch of B, for A in compressed sparse row
+//! format with one row per row of B (e.g. weight gradient of sparse input
+//! features). Only rows of out at columns of A which hold a non-zero
+//! element are computed, so the other rows of the gradient are never
+//! touched
+template <typename T>
+void MultiplyTransposedMean(const CsrMatrix<T>& A, const Tensor<T>& B,
+                            RowSparseMatrix<T>& out)
+{
+    if (A.NumRow() != B.NumMatrix() * B.TensorShape.NumRow())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : (" +
+            std::to_string(A.NumRow()) + ", " + std::to_string(A.NumCol) +
+            ") B : " + B.TensorShape.ToString());
+
+    if (B.Device.Type() != DeviceType::CPU)
+        throw std::runtime_error("Not implemented");
+
+    if constexpr (std::is_same_v<T, float>)
+        CPU::Float::CsrMultiplyTransposedMeanCpu(
+            A, B.Data, B.TensorShape.NumCol(), B.ColumnElementSize(),
+            B.BatchSize, out);
+    else if constexpr (std::is_same_v<T, double>)
+        CPU::Double::CsrMultiplyTransposedMeanCpu(
+            A, B.Data, B.TensorShape.NumCol(), B.ColumnElementSize(),
+            B.BatchSize, out);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Packs signs of every row of input into out (see BinaryMatrix)
+//! If transpose is true, input should hold a single matrix and out holds one
+//! row per column of it (e.g. weights multiplied by MultiplyAdd)
+inline void PackSigns(const Tensor<float>& input, BinaryMatrix& out,
+                      bool transpose = false)
+{
+    if (transpose && input.NumMatrix() != 1)
+        throw std::invalid_argument(
+            "Only a single matrix can be packed by columns");
+
+    if (input.Device.Type() == DeviceType::CPU)
+        CPU::Binary::PackSignsCpu(
+            input.Data, out,
+            input.TotalElementSize() / input.ColumnElementSize(),
+            input.TensorShape.NumCol(), input.ColumnElementSize(), transpose);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Writes the values binary matrix input stands for (scale times sign) to
+//! out, which holds one row per row of input
+inline void UnpackSigns(const BinaryMatrix& input, Tensor<float>& out)
+{
+    if (input.NumRow != out.TotalElementSize() / out.ColumnElementSize() ||
+        input.NumCol != out.TensorShape.NumCol())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. input : (" +
+            std::to_string(input.NumRow) + ", " +
+            std::to_string(input.NumCol) +
+            ") out : " + out.TensorShape.ToString());
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Binary::UnpackSignsCpu(input, out.Data, out.ColumnElementSize());
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Throws std::invalid_argument unless out can hold A * B^T for binary A
+//! and B, with one row per row of A
+inline void CheckBinaryMultiplyArguments(const BinaryMatrix& A,
+                                         const BinaryMatrix& B,
+                                         const Tensor<float>& out)
+{
+    if (A.NumCol != B.NumCol ||
+        A.NumRow != out.TotalElementSize() / out.ColumnElementSize() ||
+        B.NumRow != out.TensorShape.NumCol())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : (" +
+            std::to_string(A.NumRow) + ", " + std::to_string(A.NumCol) +
+            ") B : (" + std::to_string(B.NumRow) + ", " +
+            std::to_string(B.NumCol) +
+            ") out : " + out.TensorShape.ToString());
+}
+
+//! out = activation(A * B^T + bias) for binary A and B (see
+//! CPU::Binary::MultiplyAddCpu), where A holds one row per row of out
+//! (e.g. binarized inputs) and B one row per column of out (e.g. weights
+//! packed by columns). bias has one value per column of out
+inline void MultiplyAdd(const BinaryMatrix& A, const BinaryMatrix& B,
+                        const Tensor<float>& bias, Tensor<float>& out,
+                        ActivationType activation = ActivationType::None)
+{
+    CheckBinaryMultiplyArguments(A, B, out);
+    if (bias.TensorShape.Size() != B.NumRow || bias.BatchSize != 1)
+        throw std::invalid_argument(
+            "Bias should hold one value per column of out. bias : " +
+            bias.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Binary::MultiplyAddCpu(A, B, bias.Data, out.Data,
+                                    out.ColumnElementSize(), activation);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = A * B^T for binary A and B (see MultiplyAdd)
+inline void Multiply(const BinaryMatrix& A, const BinaryMatrix& B,
+                     Tensor<float>& out)
+{
+    CheckBinaryMultiplyArguments(A, B, out);
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Binary::MultiplyAddCpu(A, B, {}, out.Data,
+                                    out.ColumnElementSize(),
+                                    ActivationType::None);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Quantizes input to uint8 as
+//! out = clamp(round(input / Scale) + ZeroPoint, 0, 255)
+inline void Quantize(const Tensor<float>& input, Tensor<std::uint8_t>& out,
+                     const QuantizationParameters& parameters)
+{
+    if (input.TensorShape != out.TensorShape ||
+        input.BatchSize != out.BatchSize)
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. input : " +
+            input.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Quantized::QuantizeCpu(
+            input.Data, out.Data,
+            input.TotalElementSize() / input.ColumnElementSize(),
+            input.TensorShape.NumCol(), input.ColumnElementSize(),
+            out.ColumnElementSize(), parameters);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = op(A) * op(B) accumulated and stored in float, where A or B is
+//! stored in a 16 bit type (e.g. float gradients multiplied with 16 bit
+//! weights). Other operand may be float or the same 16 bit type
+template <typename TA, typename TB,
+          std::enable_if_t<IsHalfPrecisionV<TA> || IsHalfPrecisionV<TB>,
+                           int> = 0>
+void Multiply(const Tensor<TA>& A, const Tensor<TB>& B, Tensor<float>& out,
+              bool transposeA, bool transposeB)
+{
+    static_assert(std::is_same_v<TA, TB> || std::is_same_v<TA, float> ||
+                      std::is_same_v<TB, float>,
+                  "Operands should be stored in float or the same 16 bit "
+                  "type");
+    const auto m = out.TensorShape.NumRow();
+    const auto n = out.TensorShape.NumCol();
+    const auto k =
+        transposeA ? A.TensorShape.NumRow() : A.TensorShape.NumCol();
+    const auto numRowA =
+        transposeA ? A.TensorShape.NumCol() : A.TensorShape.NumRow();
+    const auto numRowB =
+        transposeB ? B.TensorShape.NumCol() : B.TensorShape.NumRow();
+    const auto numColB =
+        transposeB ? B.TensorShape.NumRow() : B.TensorShape.NumCol();
+
+    if (numRowA != m || numRowB != k || numColB != n)
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : " +
+            A.TensorShape.ToString() + " B : " + B.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (A.BatchSize != B.BatchSize && A.BatchSize != 1 && B.BatchSize != 1)
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+
+    const auto matricesPerSample = out.NumMatrix() / out.BatchSize;
+    if (out.BatchSize != std::max(A.BatchSize, B.BatchSize) ||
+        A.NumMatrix() / A.BatchSize != matricesPerSample ||
+        B.NumMatrix() / B.BatchSize != matricesPerSample)
+        throw std::invalid_argument(
+            "Number of matrices mismatch between given tensors");
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Half::MultiplyCpu(
+            A.Data, B.Data, out.Data, m, n, k, A.ColumnElementSize(),
+            B.ColumnElementSize(), out.ColumnElementSize(), out.NumMatrix(),
+            A.BatchSize != B.BatchSize && A.BatchSize == 1,
+            A.BatchSize != B.BatchSize && B.BatchSize == 1, transposeA,
+            transposeB);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! out = activation(scale * A * B + C) for A and B stored in a 16 bit type,
+//! accumulated and stored in float with float C (e.g. bias)
+template <typename T16, std::enable_if_t<IsHalfPrecisionV<T16>, int> = 0>
+void MultiplyAdd(const Tensor<T16>& A, const Tensor<T16>& B,
+                 const Tensor<float>& C, Tensor<float>& out,
+                 ActivationType activation = ActivationType::None,
+                 float scale = 1.0f)
+{
+    if (A.TensorShape.NumCol() != B.TensorShape.NumRow() ||
+        A.TensorShape.NumRow() != out.TensorShape.NumRow() ||
+        B.TensorShape.NumCol() != out.TensorShape.NumCol() ||
+        C.TensorShape != out.TensorShape)
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : " +
+            A.TensorShape.ToString() + " B : " + B.TensorShape.ToString() +
+            " C : " + C.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if ((A.BatchSize != B.BatchSize && A.BatchSize != 1 &&
+         B.BatchSize != 1) ||
+        (C.BatchSize != out.BatchSize && C.BatchSize != 1))
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Half::MultiplyAddCpu(
+            A.Data, B.Data, C.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), A.TensorShape.NumCol(),
+            A.ColumnElementSize(), B.ColumnElementSize(),
+            out.ColumnElementSize(), out.NumMatrix(),
+            A.BatchSize != B.BatchSize && A.BatchSize == 1,
+            A.BatchSize != B.BatchSize && B.BatchSize == 1,
+            C.BatchSize != out.BatchSize, activation, scale);
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Converts input between float and a 16 bit type, rounding to nearest even
+template <typename TIn, typename TOut>
+void Convert(const Tensor<TIn>& input, Tensor<TOut>& out)
+{
+    static_assert((std::is_same_v<TIn, float> && IsHalfPrecisionV<TOut>) ||
+                      (IsHalfPrecisionV<TIn> && std::is_same_v<TOut, float>),
+                  "Conversion should be between float and a 16 bit type");
+    if (input.TensorShape != out.TensorShape ||
+        input.BatchSize != out.BatchSize)
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. input : " +
+            input.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Half::ConvertCpu(
+            input.Data, out.Data,
+            input.TotalElementSize() / input.ColumnElementSize(),
+            input.TensorShape.NumCol(), input.ColumnElementSize(),
+            out.ColumnElementSize());
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Throws std::invalid_argument unless out can hold mean of A^T * B over the
+//! batch
+template <typename TA, typename TB, typename TOut>
+void CheckMultiplyTransposedMeanArguments(const Tensor<TA>& A,
+                                          const Tensor<TB>& B,
+                                          const Tensor<TOut>& out)
+{
+    if (A.BatchSize != B.BatchSize)
+        throw std::invalid_argument(
+            "Batch size mismatch between given tensors");
+
+    if (A.TensorShape.NumRow() != B.TensorShape.NumRow() ||
+        A.NumMatrix() != B.NumMatrix() || out.NumMatrix() != 1 ||
+        out.TensorShape.NumRow() != A.TensorShape.NumCol() ||
+        out.TensorShape.NumCol() != B.TensorShape.NumCol())
+        throw std::invalid_argument(
+            "Shape mismatch between given tensors. A : " +
+            A.TensorShape.ToString() + " B : " + B.TensorShape.ToString() +
+            " out : " + out.TensorShape.ToString());
+}
+
+//! Returns operands of GEMM kernels for out = mean of A^T * B over the batch
+//! Throws std::invalid_argument if shapes or batch sizes of tensors mismatch
+template <typename T>
+GemmArguments<T> MakeMultiplyTransposedMeanArguments(const Tensor<T>& A,
+                                                     const Tensor<T>& B,
+                                                     Tensor<T>& out)
+{
+    CheckMultiplyTransposedMeanArguments(A, B, out);
+
+    GemmArguments<T> arguments;
+    arguments.A = A.Data.Address(0);
+    arguments.B = B.Data.Address(0);
+    arguments.Out = out.Data.Address(0);
+    arguments.M = out.TensorShape.NumRow();
+    arguments.N = out.TensorShape.NumCol();
+    arguments.K = A.TensorShape.NumRow() * A.NumMatrix();
+    arguments.LdA = A.ColumnElementSize();
+    arguments.LdB = B.ColumnElementSize();
+    arguments.LdOut = out.ColumnElementSize();
+    arguments.BatchSize = A.BatchSize;
+    return arguments;
+}
+
+//! out = mean of A^T * B over the batch
+//! Rows of every sample are stacked into the reduced dimension of a single
+//! GEMM, so products of individual samples are never stored
+template <typename T>
+void MultiplyTransposedMean(const Tensor<T>& A, const Tensor<T>& B,
+                            Tensor<T>& out)
+{
+    if (out.Device.Type() != DeviceType::CPU)
+        throw std::runtime_error("Not implemented");
+
+    if constexpr (IsHalfPrecisionV<T>)
     {
-        const auto matOffset = numRow * numCol * matIdx;
-        for (std::size_t rowIdx = 0; rowIdx < numRow; ++rowIdx)
-            for (std::size_t colIdx = 0; colIdx < numCol; ++colIdx)
-            {
-                out.At(matOffset + numCol * rowIdx + colIdx) =
-                    in.At(matOffset + numRow * colIdx + rowIdx);
-            }
+        CheckMultiplyTransposedMeanArguments(A, B, out);
+        CPU::Half::MultiplyTransposedMeanCpu(
+            A.Data, B.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(), A.TensorShape.NumRow() * A.NumMatrix(),
+            A.ColumnElementSize(), B.ColumnElementSize(),
+            out.ColumnElementSize(), A.BatchSize);
     }
+    else
+        ResolveGemmKernel<T>(KernelOp::MultiplyTransposedMean,
+                             BroadcastMode::None, KernelLayout::TransposeA)(
+            MakeMultiplyTransposedMeanArguments(A, B, out));
+}
+
+//! out = mean of A^T * B over the batch, accumulated and stored in float,
+//! where A or B is stored in a 16 bit type
+template <typename TA, typename TB,
+          std::enable_if_t<IsHalfPrecisionV<TA> || IsHalfPrecisionV<TB>,
+                           int> = 0>
+void MultiplyTransposedMean(const Tensor<TA>& A, const Tensor<TB>& B,
+                            Tensor<float>& out)
+{
+    static_assert(std::is_same_v<TA, TB> || std::is_same_v<TA, float> ||
+                      std::is_same_v<TB, float>,
+                  "Operands should be stored in float or the same 16 bit "
+                  "type");
+    CheckMultiplyTransposedMeanArguments(A, B, out);
+
+    if (out.Device.Type() == DeviceType::CPU)
+        CPU::Half::MultiplyTransposedMeanCpu(
+            A.Data, B.Data, out.Data, out.TensorShape.NumRow(),
+            out.TensorShape.NumCol(),
+            A.TensorShape.NumRow() * A.NumMatrix(), A.ColumnElementSize(),
+            B.ColumnElementSize(), out.ColumnElementSize(), A.BatchSize);
+    else
+        throw std::runtime_error("Not implemented");
 }
 
+//! Writes transpose of every matrix of in to out
 template <typename T>
-void Shrink(const Tensor<T>& input, Tensor<T>& output)
+void Transpose(const Tensor<T>& in, Tensor<T>& out)
 {
-    const auto device = output.Device;
-    const auto size = output.ElementSize();
+    const auto device = out.Device;
+    const auto inputShape = in.TensorShape;
+
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::ShrinkCpu(input.Data, output.Data, size,
-                                  input.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::ShrinkCpu(input.Data, output.Data, size,
-                                input.BatchSize);
+        TransposeArguments<T> arguments;
+        arguments.Input = in.Data.Address(0);
+        arguments.Output = out.Data.Address(0);
+        arguments.NumRow = inputShape.NumRow();
+        arguments.NumCol = inputShape.NumCol();
+        arguments.LdInput = in.ColumnElementSize();
+        arguments.LdOutput = out.ColumnElementSize();
+        arguments.NumMatrices = in.NumMatrix();
+        ResolveTransposeKernel<T>()(arguments);
     }
     else
         throw std::runtime_error("Not implemented");
 }
 
+//! output = mean of input over the batch
+template <typename T>
+void Shrink(const Tensor<T>& input, Tensor<T>& output)
+{
+    Reduce(input, output, BatchAxis, ReduceOp::Mean);
+}
+
 template <typename T>
 void Add(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
 {
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Float::AddCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                   out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Float::AddWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                true);
-            else if (B.BatchSize == 1)
-                CPU::Float::AddWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                false);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Int::AddCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                 out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Int::AddWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(),
-                                              out.BatchSize, true);
-            else if (B.BatchSize == 1)
-                CPU::Int::AddWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(),
-                                              out.BatchSize, false);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
+        const auto broadcast = GetBroadcastMode(A, B);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::AddCpu(A.Data, B.Data, out.Data, out.ElementSize(),
+                          out.BatchSize,
+                          broadcast == BroadcastMode::BroadcastA,
+                          broadcast == BroadcastMode::BroadcastB);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Add, broadcast)(
+                MakeElementwiseArguments(A, B, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -264,25 +829,15 @@ void Add(const Tensor<T>& A, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == out.BatchSize)
-                CPU::Float::AddCpu(out.Data, A.Data, out.Data,
-                                   out.ElementSize(),
-                                   out.BatchSize);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == out.BatchSize)
-                CPU::Int::AddCpu(out.Data, A.Data, out.Data, out.ElementSize(),
-                                 out.BatchSize);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
+        if (A.BatchSize != out.BatchSize)
+            throw std::invalid_argument(
+                "Batch size mismatch between given tensors");
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::AddCpu(out.Data, A.Data, out.Data, out.ElementSize(),
+                          out.BatchSize, false, false);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Add)(
+                MakeElementwiseArguments(out, A, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -294,42 +849,15 @@ void Sub(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Float::SubCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                   out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Float::SubWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                true);
-            else if (B.BatchSize == 1)
-                CPU::Float::SubWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                false);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Int::SubCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                 out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Int::SubWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(), out.BatchSize,
-                                              true);
-            else if (B.BatchSize == 1)
-                CPU::Int::SubWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(), out.BatchSize,
-                                              false);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
+        const auto broadcast = GetBroadcastMode(A, B);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::SubCpu(A.Data, B.Data, out.Data, out.ElementSize(),
+                          out.BatchSize,
+                          broadcast == BroadcastMode::BroadcastA,
+                          broadcast == BroadcastMode::BroadcastB);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Sub, broadcast)(
+                MakeElementwiseArguments(A, B, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -341,25 +869,15 @@ void Sub(const Tensor<T>& A, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == out.BatchSize)
-                CPU::Float::SubCpu(out.Data, A.Data, out.Data,
-                                   out.ElementSize(),
-                                   out.BatchSize);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == out.BatchSize)
-                CPU::Int::SubCpu(out.Data, A.Data, out.Data,
-                                 out.ElementSize(), out.BatchSize);
-            else
-                throw std::invalid_argument(
-                    "Batch size mismatch between given tensors");
-        }
+        if (A.BatchSize != out.BatchSize)
+            throw std::invalid_argument(
+                "Batch size mismatch between given tensors");
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::SubCpu(out.Data, A.Data, out.Data, out.ElementSize(),
+                          out.BatchSize, false, false);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Sub)(
+                MakeElementwiseArguments(out, A, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -371,36 +889,15 @@ void Dot(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Float::DotCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                   out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Float::DotWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                true);
-            else if (B.BatchSize == 1)
-                CPU::Float::DotWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                false);
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Int::DotCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                 out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Int::DotWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(),
-                                              out.BatchSize, true);
-            else if (B.BatchSize == 1)
-                CPU::Int::DotWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(),
-                                              out.BatchSize, false);
-        }
+        const auto broadcast = GetBroadcastMode(A, B);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::DotCpu(A.Data, B.Data, out.Data, out.ElementSize(),
+                          out.BatchSize,
+                          broadcast == BroadcastMode::BroadcastA,
+                          broadcast == BroadcastMode::BroadcastB);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Dot, broadcast)(
+                MakeElementwiseArguments(A, B, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -412,16 +909,15 @@ void Dot(const Tensor<T>& in, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            CPU::Float::DotCpu(out.Data, in.Data, out.Data, out.ElementSize(),
-                               out.BatchSize);
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            CPU::Int::DotCpu(out.Data, in.Data, out.Data, out.ElementSize(),
-                             out.BatchSize);
-        }
+        if (in.BatchSize != out.BatchSize)
+            throw std::invalid_argument(
+                "Batch size mismatch between given tensors");
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::DotCpu(out.Data, in.Data, out.Data, out.ElementSize(),
+                          out.BatchSize, false, false);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Dot)(
+                MakeElementwiseArguments(out, in, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -433,36 +929,15 @@ void Div(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Float::DivCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                   out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Float::DivWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                true);
-            else if (B.BatchSize == 1)
-                CPU::Float::DivWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                                out.ElementSize(),
-                                                out.BatchSize,
-                                                false);
-        }
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-        {
-            if (A.BatchSize == B.BatchSize)
-                CPU::Int::DivCpu(A.Data, B.Data, out.Data, out.ElementSize(),
-                                 out.BatchSize);
-            else if (A.BatchSize == 1)
-                CPU::Int::DivWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(),
-                                              out.BatchSize, true);
-            else if (B.BatchSize == 1)
-                CPU::Int::DivWithBroadcastCpu(A.Data, B.Data, out.Data,
-                                              out.ElementSize(),
-                                              out.BatchSize, false);
-        }
+        const auto broadcast = GetBroadcastMode(A, B);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::DivCpu(A.Data, B.Data, out.Data, out.ElementSize(),
+                          out.BatchSize,
+                          broadcast == BroadcastMode::BroadcastA,
+                          broadcast == BroadcastMode::BroadcastB);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Div, broadcast)(
+                MakeElementwiseArguments(A, B, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -474,12 +949,15 @@ void Div(const Tensor<T>& in, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::DivCpu(out.Data, in.Data, out.Data, out.ElementSize(),
-                               out.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::DivCpu(out.Data, in.Data, out.Data, out.ElementSize(),
-                             out.BatchSize);
+        if (in.BatchSize != out.BatchSize)
+            throw std::invalid_argument(
+                "Batch size mismatch between given tensors");
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::DivCpu(out.Data, in.Data, out.Data, out.ElementSize(),
+                          out.BatchSize, false, false);
+        else
+            ResolveElementwiseKernel<T>(KernelOp::Div)(
+                MakeElementwiseArguments(out, in, out));
     }
     else
         throw std::runtime_error("Not implemented");
@@ -491,34 +969,25 @@ void ScalarMul(const Tensor<T>& in, T toMul, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::ScalarMulCpu(in.Data, toMul, out.Data,
-                                     out.ElementSize(),
-                                     out.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::ScalarMulCpu(in.Data, toMul, out.Data, out.ElementSize(),
-                                   out.BatchSize);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::ScalarMulCpu(in.Data, static_cast<float>(toMul),
+                                    out.Data, out.ElementSize(),
+                                    out.BatchSize);
+        else
+        {
+            auto arguments = MakeElementwiseArguments(in, in, out);
+            arguments.Scalar = toMul;
+            ResolveElementwiseKernel<T>(KernelOp::ScalarMul)(arguments);
+        }
     }
     else
         throw std::runtime_error("Not implemented");
 }
 
 template <typename T>
-void ScalarMul(const Tensor<T>& tensor, T toMul)
+void ScalarMul(Tensor<T>& tensor, T toMul)
 {
-    const auto device = tensor.Device;
-    if (device.Type() == DeviceType::CPU)
-    {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::ScalarMulCpu(tensor.Data, toMul, tensor.Data,
-                                     tensor.ElementSize(),
-                                     tensor.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::ScalarMulCpu(tensor.Data, toMul, tensor.Data,
-                                   tensor.ElementSize(), tensor.BatchSize);
-    }
-    else
-        throw std::runtime_error("Not implemented");
+    ScalarMul(tensor, toMul, tensor);
 }
 
 template <typename T>
@@ -527,13 +996,16 @@ void ScalarDiv(const Tensor<T>& in, T toDiv, Tensor<T>& out)
     const auto device = out.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::ScalarDivCpu(in.Data, toDiv, out.Data,
-                                     out.ElementSize(),
-                                     out.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::ScalarDivCpu(in.Data, toDiv, out.Data, out.ElementSize(),
-                                   out.BatchSize);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::ScalarDivCpu(in.Data, static_cast<float>(toDiv),
+                                    out.Data, out.ElementSize(),
+                                    out.BatchSize);
+        else
+        {
+            auto arguments = MakeElementwiseArguments(in, in, out);
+            arguments.Scalar = toDiv;
+            ResolveElementwiseKernel<T>(KernelOp::ScalarDiv)(arguments);
+        }
     }
     else
         throw std::runtime_error("Not implemented");
@@ -542,19 +1014,7 @@ void ScalarDiv(const Tensor<T>& in, T toDiv, Tensor<T>& out)
 template <typename T>
 void ScalarDiv(Tensor<T>& tensor, T toDiv)
 {
-    const auto device = tensor.Device;
-    if (device.Type() == DeviceType::CPU)
-    {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::ScalarDivCpu(tensor.Data, toDiv, tensor.Data,
-                                     tensor.ElementSize(),
-                                     tensor.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::ScalarDivCpu(tensor.Data, toDiv, tensor.Data,
-                                   tensor.ElementSize(), tensor.BatchSize);
-    }
-    else
-        throw std::runtime_error("Not implemented");
+    ScalarDiv(tensor, toDiv, tensor);
 }
 
 template <typename T>
@@ -563,23 +1023,52 @@ void Set(Tensor<T>& tensor, T toSet)
     const auto device = tensor.Device;
     if (device.Type() == DeviceType::CPU)
     {
-        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
-            CPU::Float::SetCpu(tensor.Data, toSet, tensor.ElementSize(),
-                               tensor.BatchSize);
-        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
-            CPU::Int::SetCpu(tensor.Data, toSet, tensor.ElementSize(),
-                             tensor.BatchSize);
+        if constexpr (IsHalfPrecisionV<T>)
+            CPU::Half::SetCpu(tensor.Data, static_cast<float>(toSet),
+                              tensor.ElementSize(), tensor.BatchSize);
+        else
+        {
+            auto arguments = MakeElementwiseArguments(tensor, tensor, tensor);
+            arguments.Scalar = toSet;
+            ResolveElementwiseKernel<T>(KernelOp::Set)(arguments);
+        }
     }
     else
         throw std::runtime_error("Not implemented");
 }
 
+//! output = lambda(input) elementwise
+//! Functors from MathFunction.hpp are evaluated with registered kernels for
+//! floating point and 16 bit tensors, other functions are called one element
+//! at a time
 template <typename T, typename Function>
 void Apply(const Tensor<T>& input, Tensor<T>& output, Function lambda)
 {
     const auto device = input.Device;
     const auto size = output.ElementSize();
     const auto batchSize = output.BatchSize;
+
+    if constexpr (IsMathFunctionV<Function> && std::is_floating_point_v<T> &&
+                  DataTypeOfV<T> != DataType::Unsupported)
+    {
+        if (device.Type() == DeviceType::CPU)
+        {
+            auto arguments = MakeElementwiseArguments(input, input, output);
+            arguments.Function = Function::Function;
+            ResolveElementwiseKernel<T>(KernelOp::Apply)(arguments);
+            return;
+        }
+    }
+    else if constexpr (IsMathFunctionV<Function> && IsHalfPrecisionV<T>)
+    {
+        if (device.Type() == DeviceType::CPU)
+        {
+            CPU::Half::ApplyCpu(input.Data, output.Data, size, batchSize,
+                                Function::Function);
+            return;
+        }
+    }
+
 #pragma omp parallel for schedule(static) default(shared)
     for (long batchIdx = 0; batchIdx < static_cast<long>(batchSize); batchIdx++)
     {
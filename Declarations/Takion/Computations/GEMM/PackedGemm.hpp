@@ -0,0 +1,76 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_PACKEDGEMM_HPP
+#define TAKION_COMPUTE_PACKEDGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <cstddef>
+
+namespace Takion::Compute::CPU
+{
+//! Default cache blocking parameters
+//! KC x NR panel of B stays in L1, MC x KC block of A stays in L2
+//! and KC x NC block of B stays in L3
+//! NC is a multiple of every NR, so only the last block of C can end in a
+//! partial panel
+constexpr std::size_t GemmMC = 168;
+constexpr std::size_t GemmKC = 256;
+constexpr std::size_t GemmNC = 4096;
+
+//! Cache blocking parameters of a single GEMM (see GemmTuner)
+//! MC and NC are rounded down to multiples of MR and NR of the instruction
+//! set, and none of them is smaller than a single panel
+struct GemmBlocking
+{
+    std::size_t MC = GemmMC;
+    std::size_t KC = GemmKC;
+    std::size_t NC = GemmNC;
+
+    bool operator==(const GemmBlocking& other) const
+    {
+        return MC == other.MC && KC == other.KC && NC == other.NC;
+    }
+};
+
+//! Block of k used by u8 x s8 GEMM. Panels of B hold the same number of
+//! bytes as float panels of GemmKC rows
+constexpr std::size_t QuantizedGemmKC = 4 * GemmKC;
+
+//! Without AVX-512 VNNI, u8 x s8 GEMM adds pairs of byte products with int16
+//! saturation. Products are exact on every instruction set as long as
+//! weights stay within [-QuantizedWeightMax, QuantizedWeightMax]
+constexpr int QuantizedWeightMax = 64;
+
+//! Returns 64 byte aligned scratch memory of at least byteSize bytes owned
+//! by the calling thread. GEMM kernels keep packed A in slot 0 and packed B
+//! in slot 1
+void* GemmScratchBuffer(std::size_t slot, std::size_t byteSize);
+} // namespace Takion::Compute::CPU
+
+namespace Takion::Compute::CPU::Float
+{
+//! Computes C = A * B (or C += A * B if accumulate is true) where A is m x k,
+//! B is k x n and C is m x n with row stride ldc
+//! Element (i, p) of A is read from A[i * rowStrideA + p * colStrideA] and
+//! element (p, j) of B from B[p * rowStrideB + j * colStrideB], so transposed
+//! operands only need swapped strides
+//! Both operands are packed into contiguous panels which are consumed by a
+//! register blocked FMA micro kernel of the active instruction set
+//! Single row of A (e.g. batch size of 1) is multiplied by a GEMV kernel
+//! streaming B instead, unless neither rows nor columns of B are contiguous
+//! If parallel is true, blocks of C are distributed over OpenMP threads
+//! epilogue is applied to every tile of C before it leaves registers
+//! blocking gives the size of packed blocks of A and B
+void PackedGemm(std::size_t m, std::size_t n, std::size_t k, const float* A,
+                std::size_t rowStrideA, std::size_t colStrideA, const float* B,
+                std::size_t rowStrideB, std::size_t colStrideB, float* C,
+                std::size_t ldc, bool accumulate, bool parallel,
+                const GemmEpilogue<float>& epilogue = GemmEpilogue<float>(),
+                const GemmBlocking& blocking = GemmBlocking());
+} // namespace Takion::Compute::CPU::Float
+
+#endif
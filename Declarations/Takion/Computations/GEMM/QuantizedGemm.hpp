@@ -0,0 +1,89 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_QUANTIZEDGEMM_HPP
+#define TAKION_COMPUTE_QUANTIZEDGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Utils/Span.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Takion::Compute
+{
+//! Converts int32 accumulators of uint8 x int8 multiplication to real
+//! values. Column j of the result is
+//! Activation(Scale[j] * (acc - ZeroPointA * sum of column j of B) + Bias[j])
+//! Scale is scale of A times scale of B, given either once for the whole
+//! tensor or once per output column (channel). Bias is empty or has one
+//! value per column
+//! uint8 outputs are quantized again as
+//! clamp(round(real / OutputScale) + OutputZeroPoint, 0, 255)
+struct Requantization
+{
+    std::vector<float> Scale = { 1.0f };
+    std::int32_t ZeroPointA = 0;
+    std::vector<float> Bias;
+    ActivationType Activation = ActivationType::None;
+    float OutputScale = 1.0f;
+    std::int32_t OutputZeroPoint = 0;
+};
+
+//! Affine mapping real = Scale * (q - ZeroPoint) of uint8 values q
+struct QuantizationParameters
+{
+    float Scale = 1.0f;
+    std::int32_t ZeroPoint = 0;
+};
+
+//! Returns parameters mapping [min, max] onto [0, 255]
+//! The range is widened to include zero, so that zero (e.g. padding or
+//! outputs of ReLU) is represented exactly
+QuantizationParameters ChooseQuantizationParameters(float min, float max);
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU::Quantized
+{
+using namespace Util;
+
+//! out = A * B where A holds m x k uint8 matrices and B holds k x n int8
+//! matrices, accumulated in int32
+//! ldA, ldB and ldOut are row lengths of the stored matrices. If broadCastB
+//! is true, B holds a single matrix which is shared by every matrix of A
+//! Weights within [-QuantizedWeightMax, QuantizedWeightMax] are multiplied
+//! exactly by every instruction set (see PackedGemm.hpp)
+void MultiplyCpu(const Span<std::uint8_t> inputA,
+                 const Span<std::int8_t> inputB, Span<std::int32_t> out,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastB);
+
+//! Same as above, with accumulators requantized to real values before they
+//! are stored
+void MultiplyCpu(const Span<std::uint8_t> inputA,
+                 const Span<std::int8_t> inputB, Span<float> out,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastB,
+                 const Requantization& requantization);
+
+//! Same as above, with requantized values quantized again to uint8
+void MultiplyCpu(const Span<std::uint8_t> inputA,
+                 const Span<std::int8_t> inputB, Span<std::uint8_t> out,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastB,
+                 const Requantization& requantization);
+
+//! out = clamp(round(input / scale) + zeroPoint, 0, 255) for numRow rows of
+//! numCol values. ldInput and ldOut are row lengths of the stored rows
+void QuantizeCpu(const Span<float> input, Span<std::uint8_t> out,
+                 std::size_t numRow, std::size_t numCol, std::size_t ldInput,
+                 std::size_t ldOut, const QuantizationParameters& parameters);
+} // namespace Takion::Compute::CPU::Quantized
+
+#endif
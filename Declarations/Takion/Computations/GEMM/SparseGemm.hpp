@@ -0,0 +1,103 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_SPARSEGEMM_HPP
+#define TAKION_COMPUTE_SPARSEGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Utils/Span.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Takion::Compute
+{
+//! Number of columns of a block of block sparse matrices. A row of a block
+//! fills one AVX2 vector of floats
+constexpr std::size_t SparseBlockWidth = 8;
+
+enum class SparseFormat
+{
+    //! Compressed sparse rows of the transposed matrix, i.e. single elements
+    //! grouped by column (one row per output of pruned weights)
+    Csr,
+    //! Blocks of 1 x SparseBlockWidth elements
+    Block1x8,
+    //! Blocks of 4 x SparseBlockWidth elements
+    Block4x8,
+};
+
+//! NumRow x NumCol float matrix (e.g. pruned weights) which only stores its
+//! non-zero elements
+//! Elements are stored in blocks of BlockRows() x BlockCols(), and only
+//! blocks with a non-zero element are stored. Columns are grouped by
+//! BlockCols(), and Offsets[group] to Offsets[group + 1] index the blocks
+//! of column group group, whose first rows are in Indices. Values holds the
+//! elements of every block in row major order, with elements outside of
+//! the matrix set to zero. Blocks of Csr are single elements
+struct SparseMatrix
+{
+    //! Converts numRow x numCol matrix whose rows are ld apart. Elements
+    //! with magnitude of at most threshold are pruned
+    //! Throws std::invalid_argument if indices of the matrix do not fit in
+    //! 32 bits
+    [[nodiscard]] static SparseMatrix FromDense(const float* data,
+                                                std::size_t numRow,
+                                                std::size_t numCol,
+                                                std::size_t ld,
+                                                SparseFormat format,
+                                                float threshold = 0.0f);
+
+    [[nodiscard]] std::size_t BlockRows() const
+    {
+        return Format == SparseFormat::Block4x8 ? 4 : 1;
+    }
+
+    [[nodiscard]] std::size_t BlockCols() const
+    {
+        return Format == SparseFormat::Csr ? 1 : SparseBlockWidth;
+    }
+
+    //! Number of stored blocks (elements for Csr)
+    [[nodiscard]] std::size_t NumBlocks() const
+    {
+        return Indices.size();
+    }
+
+    //! Number of bytes of the stored arrays
+    [[nodiscard]] std::size_t ByteSize() const
+    {
+        return Offsets.size() * sizeof(std::size_t) +
+               Indices.size() * sizeof(std::uint32_t) +
+               Values.size() * sizeof(float);
+    }
+
+    SparseFormat Format = SparseFormat::Csr;
+    std::size_t NumRow = 0;
+    std::size_t NumCol = 0;
+    std::vector<std::size_t> Offsets;
+    std::vector<std::uint32_t> Indices;
+    std::vector<float> Values;
+};
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU::Sparse
+{
+using namespace Util;
+
+//! out = activation(scale * A * B + C) where A holds numMatrices m x k
+//! matrices and B is a k x n sparse matrix shared by every matrix of A
+//! ldA and ldOut are row lengths of the stored matrices. C has the layout
+//! of out, or holds a single matrix added to every matrix of out if
+//! broadCastC is true. No C is added if inputC is empty
+void MultiplyAddCpu(const Span<float> inputA, const SparseMatrix& inputB,
+                    const Span<float> inputC, Span<float> out, std::size_t m,
+                    std::size_t ldA, std::size_t ldOut,
+                    std::size_t numMatrices, bool broadCastC,
+                    ActivationType activation, float scale);
+} // namespace Takion::Compute::CPU::Sparse
+
+#endif
@@ -0,0 +1,125 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_JITGEMM_HPP
+#define TAKION_COMPUTE_JITGEMM_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/Jit/X86Emitter.hpp>
+#include <Takion/Computations/Kernels/KernelRegistry.hpp>
+#include <cstddef>
+#include <memory>
+
+//! Float GEMM kernels generated for the exact shape of a Dense unit
+//! Dimensions, row strides and the epilogue are baked into the code, so
+//! every tile is emitted for its exact number of rows and columns and the
+//! generated code has no remainder handling. Kernels run on a single thread
+//! and are meant for small GEMMs (e.g. batch size of 1), which the packed
+//! GEMM kernels spend most of their time setting up
+//! Code is generated with AVX2 and FMA, and only when enabled by SetEnabled
+//! or TAKION_JIT=1. Otherwise kernels of the kernel registry are used
+namespace Takion::Compute::Jit
+{
+//! Largest GEMM kernels are generated for, in multiply-adds. Larger GEMMs
+//! run faster on the threaded packed GEMM kernels
+constexpr std::size_t GemmMaxWork = std::size_t(1) << 21;
+
+//! Shape of out = activation(A * B + bias) with A of M x K and B of K x N
+//! (see KernelOp::MultiplyAdd with BroadcastMode::BroadcastB and
+//! KernelLayout::RowMajor). Bias has a row stride of BiasRowStride, which is
+//! 0 if a single row is added to every row of out
+struct GemmShape
+{
+    std::size_t M = 0;
+    std::size_t N = 0;
+    std::size_t K = 0;
+    std::size_t LdA = 0;
+    std::size_t LdB = 0;
+    std::size_t LdOut = 0;
+    bool HasBias = false;
+    std::size_t BiasRowStride = 0;
+    ActivationType Activation = ActivationType::None;
+
+    bool operator==(const GemmShape& other) const
+    {
+        return M == other.M && N == other.N && K == other.K &&
+               LdA == other.LdA && LdB == other.LdB &&
+               LdOut == other.LdOut && HasBias == other.HasBias &&
+               BiasRowStride == other.BiasRowStride &&
+               Activation == other.Activation;
+    }
+};
+
+void SetEnabled(bool enabled);
+
+//! Returns true if kernels are generated (see SetEnabled)
+[[nodiscard]] bool IsEnabled();
+
+//! Returns true if the platform and the processor can run generated kernels
+[[nodiscard]] bool IsSupported();
+
+class GemmKernel
+{
+public:
+    using Function = void (*)(const float* A, const float* B,
+                              const float* bias, float* out);
+
+    //! Generates code for shape
+    //! Throws std::invalid_argument if shape cannot be generated (see
+    //! CanGenerate)
+    explicit GemmKernel(const GemmShape& shape);
+
+    //! Returns true if kernels can be generated for shape on this platform.
+    //! Sigmoid epilogue and GEMMs larger than GemmMaxWork are not generated
+    [[nodiscard]] static bool CanGenerate(const GemmShape& shape);
+
+    [[nodiscard]] const GemmShape& Shape() const
+    {
+        return m_shape;
+    }
+
+    [[nodiscard]] std::size_t CodeSize() const
+    {
+        return m_code.Size();
+    }
+
+    //! Returns true if arguments have the shape the kernel was generated for
+    [[nodiscard]] bool Matches(const GemmArguments<float>& arguments) const;
+
+    void operator()(const float* A, const float* B, const float* bias,
+                    float* out) const
+    {
+        m_function(A, B, bias, out);
+    }
+
+    //! Runs the kernel on arguments, which should match its shape
+    void operator()(const GemmArguments<float>& arguments) const
+    {
+        m_function(arguments.A, arguments.B, arguments.C, arguments.Out);
+    }
+
+private:
+    GemmShape m_shape;
+    ExecutableCode m_code;
+    Function m_function;
+};
+
+//! Returns shape of the GEMM run for arguments by the MultiplyAdd kernel
+//! with BroadcastMode::BroadcastB, with the batch folded into rows (see Gemm
+//! in KernelRegistry.cpp). Returns a shape with M of 0 if the batch cannot
+//! be folded or Scale is not 1
+[[nodiscard]] GemmShape MakeGemmShape(const GemmArguments<float>& arguments);
+
+//! Returns kernel generated for shape of arguments (see MakeGemmShape)
+//! Returns nullptr if kernels are disabled, kernels are not dispatched to
+//! AVX2 or higher, or the shape cannot be generated, in which case the
+//! kernels of the kernel registry should be used instead. Kernels are
+//! cached by shape and shared between every caller
+[[nodiscard]] std::shared_ptr<const GemmKernel> CompileGemm(
+    const GemmArguments<float>& arguments);
+} // namespace Takion::Compute::Jit
+
+#endif
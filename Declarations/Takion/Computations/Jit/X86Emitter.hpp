@@ -0,0 +1,177 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_X86EMITTER_HPP
+#define TAKION_COMPUTE_X86EMITTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! Minimal x86-64 assembler used to generate kernels at run time
+//! Only instructions used by the generated kernels are supported. Vector
+//! instructions operate on 256 bit ymm registers and are VEX encoded
+namespace Takion::Compute::Jit
+{
+//! General purpose registers in encoding order
+enum class Gp : std::uint8_t
+{
+    Rax,
+    Rcx,
+    Rdx,
+    Rbx,
+    Rsp,
+    Rbp,
+    Rsi,
+    Rdi,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15,
+};
+
+//! Returns true if code is generated for this platform (x86-64 with the
+//! System V calling convention)
+bool IsPlatformSupported();
+
+//! Position in the emitted code, bound once by X86Emitter::Bind
+struct Label
+{
+    std::size_t Id = 0;
+};
+
+//! Memory operand [Base + Displacement] or a label addressed relative to
+//! the instruction pointer
+struct Address
+{
+    static Address Of(Gp base, std::int32_t displacement)
+    {
+        return { base, displacement, false, {} };
+    }
+
+    static Address At(Label label)
+    {
+        return { Gp::Rax, 0, true, label };
+    }
+
+    Gp Base = Gp::Rax;
+    std::int32_t Displacement = 0;
+    bool RipRelative = false;
+    Label Target;
+};
+
+//! Machine code copied to memory which may be executed
+//! Memory is released when the code is destroyed
+class ExecutableCode
+{
+public:
+    //! Throws std::runtime_error if memory could not be allocated
+    explicit ExecutableCode(const std::vector<std::uint8_t>& bytes);
+    ~ExecutableCode();
+
+    ExecutableCode(const ExecutableCode&) = delete;
+    ExecutableCode& operator=(const ExecutableCode&) = delete;
+    ExecutableCode(ExecutableCode&& code) noexcept;
+    ExecutableCode& operator=(ExecutableCode&& code) noexcept;
+
+    [[nodiscard]] const void* Entry() const
+    {
+        return m_memory;
+    }
+
+    [[nodiscard]] std::size_t Size() const
+    {
+        return m_size;
+    }
+
+private:
+    void m_release();
+
+    void* m_memory = nullptr;
+    std::size_t m_size = 0;
+};
+
+class X86Emitter
+{
+public:
+    [[nodiscard]] Label NewLabel();
+
+    //! Binds label to the current position
+    void Bind(Label label);
+
+    //! Pads with zero bytes until the position is a multiple of alignment
+    void Align(std::size_t alignment);
+
+    void Data(const void* data, std::size_t byteSize);
+
+    //! dst = a ^ b
+    void VXorps(int dst, int a, int b);
+    //! dst = a + [b]
+    void VAddps(int dst, int a, const Address& b);
+    //! dst = a + b
+    void VAddps(int dst, int a, int b);
+    //! dst = a * b
+    void VMulps(int dst, int a, int b);
+    //! dst = max(a, b)
+    void VMaxps(int dst, int a, int b);
+    //! dst += a * b
+    void VFmadd231ps(int dst, int a, int b);
+    void VMovups(int dst, const Address& src);
+    void VMovups(const Address& dst, int src);
+    //! Loads lanes whose mask has its sign bit set and zeroes the others
+    void VMaskMovps(int dst, int mask, const Address& src);
+    //! Stores lanes whose mask has its sign bit set
+    void VMaskMovps(const Address& dst, int mask, int src);
+    void VBroadcastss(int dst, const Address& src);
+    void VZeroUpper();
+
+    void Lea(Gp dst, const Address& src);
+    void Add(Gp dst, std::int32_t immediate);
+    //! Sets the low 32 bits of dst and clears the upper ones
+    void Mov(Gp dst, std::uint32_t immediate);
+    //! Decrements low 32 bits of dst
+    void Dec(Gp dst);
+    //! Jumps to target if the last result was not zero
+    void Jnz(Label target);
+    void Ret();
+
+    [[nodiscard]] std::size_t Size() const
+    {
+        return m_bytes.size();
+    }
+
+    //! Resolves references to labels and copies the code to executable
+    //! memory
+    //! Throws std::runtime_error if a referenced label was never bound
+    [[nodiscard]] ExecutableCode Finalize();
+
+private:
+    struct Fixup
+    {
+        //! Position of the 32 bit displacement
+        std::size_t Position;
+        Label Target;
+    };
+
+    void m_byte(std::uint8_t byte);
+    void m_int32(std::int32_t value);
+    void m_vex(std::uint8_t map, std::uint8_t prefix, bool wide, int reg,
+               int source, std::uint8_t opcode, int rm);
+    void m_vex(std::uint8_t map, std::uint8_t prefix, bool wide, int reg,
+               int source, std::uint8_t opcode, const Address& rm);
+    void m_modRm(int reg, const Address& rm);
+
+    std::vector<std::uint8_t> m_bytes;
+    std::vector<std::ptrdiff_t> m_labels;
+    std::vector<Fixup> m_fixups;
+};
+} // namespace Takion::Compute::Jit
+
+#endif
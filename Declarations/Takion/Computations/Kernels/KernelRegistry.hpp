@@ -0,0 +1,258 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_KERNELREGISTRY_HPP
+#define TAKION_COMPUTE_KERNELREGISTRY_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/MathFunction.hpp>
+#include <Takion/Computations/Simd/InstructionSet.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace Takion::Compute
+{
+//! Operations kernels are registered for
+enum class KernelOp
+{
+    Multiply,
+    //! Multiply with C added and activation applied in the epilogue
+    MultiplyAdd,
+    //! Mean of A^T * B over the samples stacked in the rows of A and B
+    MultiplyTransposedMean,
+    Transpose,
+    Add,
+    Sub,
+    //! Elementwise multiplication
+    Dot,
+    Div,
+    ScalarMul,
+    ScalarDiv,
+    Set,
+    //! MathFunction applied to every element (floating point types only)
+    Apply,
+};
+
+//! Element types kernels are registered for
+enum class DataType
+{
+    Float32,
+    Float64,
+    Int32,
+    //! Types no kernel is registered for
+    Unsupported,
+};
+
+template <typename T>
+constexpr DataType DataTypeOfV =
+    std::is_same_v<T, float>
+        ? DataType::Float32
+        : std::is_same_v<T, double>
+              ? DataType::Float64
+              : std::is_same_v<T, int> ? DataType::Int32
+                                       : DataType::Unsupported;
+
+//! Operand holding a single sample shared by the whole batch of the other
+enum class BroadcastMode
+{
+    None,
+    BroadcastA,
+    BroadcastB,
+};
+
+//! Operands of GEMM read transposed in place
+enum class KernelLayout
+{
+    RowMajor,
+    TransposeA,
+    TransposeB,
+    TransposeAB,
+};
+
+constexpr KernelLayout ToKernelLayout(bool transposeA, bool transposeB)
+{
+    if (transposeA)
+        return transposeB ? KernelLayout::TransposeAB
+                          : KernelLayout::TransposeA;
+    return transposeB ? KernelLayout::TransposeB : KernelLayout::RowMajor;
+}
+
+struct KernelKey
+{
+    KernelOp Op;
+    DataType Type;
+    CPU::InstructionSet Isa;
+    BroadcastMode Broadcast = BroadcastMode::None;
+    KernelLayout Layout = KernelLayout::RowMajor;
+
+    bool operator==(const KernelKey& other) const
+    {
+        return Op == other.Op && Type == other.Type && Isa == other.Isa &&
+               Broadcast == other.Broadcast && Layout == other.Layout;
+    }
+};
+
+struct KernelKeyHash
+{
+    std::size_t operator()(const KernelKey& key) const
+    {
+        return (static_cast<std::size_t>(key.Op) << 16) ^
+               (static_cast<std::size_t>(key.Type) << 12) ^
+               (static_cast<std::size_t>(key.Isa) << 8) ^
+               (static_cast<std::size_t>(key.Broadcast) << 4) ^
+               static_cast<std::size_t>(key.Layout);
+    }
+};
+
+//! Operands of GEMM kernels (Multiply, MultiplyAdd and
+//! MultiplyTransposedMean)
+//! out = activation(scale * op(A) * op(B) + C) for NumMatrices matrices of
+//! M x N, where op is given by the layout of the kernel and K is the reduced
+//! dimension. LdA, LdB and LdOut are row lengths of the stored matrices
+//! C has the shape of out and is skipped if nullptr
+template <typename T>
+struct GemmArguments
+{
+    const T* A = nullptr;
+    const T* B = nullptr;
+    const T* C = nullptr;
+    T* Out = nullptr;
+    std::size_t M = 0;
+    std::size_t N = 0;
+    std::size_t K = 0;
+    std::size_t LdA = 0;
+    std::size_t LdB = 0;
+    std::size_t LdOut = 0;
+    std::size_t NumMatrices = 1;
+    //! C holds a single matrix added to every matrix of out
+    bool BroadCastC = false;
+    ActivationType Activation = ActivationType::None;
+    T Scale = static_cast<T>(1);
+    //! Number of samples averaged by MultiplyTransposedMean
+    std::size_t BatchSize = 1;
+    //! Cache blocking of the GEMM (see GemmTuner)
+    CPU::GemmBlocking Blocking;
+};
+
+//! Operands of elementwise kernels over BatchSize blocks of Size elements
+//! Broadcast operand (see BroadcastMode) holds a single block. B is only read
+//! by binary operations, Scalar by ScalarMul, ScalarDiv and Set, and
+//! Function by Apply. Set writes Out only
+template <typename T>
+struct ElementwiseArguments
+{
+    const T* A = nullptr;
+    const T* B = nullptr;
+    T* Out = nullptr;
+    std::size_t Size = 0;
+    std::size_t BatchSize = 1;
+    T Scalar = static_cast<T>(0);
+    MathFunction Function = MathFunction::Exp;
+};
+
+//! Transposes NumMatrices NumRow x NumCol matrices with row lengths LdInput
+//! and LdOutput
+template <typename T>
+struct TransposeArguments
+{
+    const T* Input = nullptr;
+    T* Output = nullptr;
+    std::size_t NumRow = 0;
+    std::size_t NumCol = 0;
+    std::size_t LdInput = 0;
+    std::size_t LdOutput = 0;
+    std::size_t NumMatrices = 1;
+};
+
+template <typename T>
+using GemmKernelFunction = void (*)(const GemmArguments<T>& arguments);
+
+template <typename T>
+using ElementwiseKernelFunction =
+    void (*)(const ElementwiseArguments<T>& arguments);
+
+template <typename T>
+using TransposeKernelFunction =
+    void (*)(const TransposeArguments<T>& arguments);
+
+//! Kernels keyed by operation, element type, instruction set, broadcast mode
+//! and layout. Every variant registers once, and callers resolve the
+//! function pointer for their operands instead of branching on them per
+//! call. Units resolve their kernels once at Compile
+//! Kernels of the library are registered when Get is first called. Custom
+//! kernels should be registered before models run, as registering is not
+//! synchronized with resolving
+class KernelRegistry
+{
+public:
+    //! Function pointers are stored type erased and cast back by Resolve
+    using ErasedFunction = void (*)();
+
+    static KernelRegistry& Get();
+
+    //! Registers function for key, replacing a previously registered one
+    template <typename Function>
+    void Register(const KernelKey& key, Function function)
+    {
+        static_assert(std::is_pointer_v<Function> &&
+                          std::is_function_v<std::remove_pointer_t<Function>>,
+                      "Kernels should be function pointers");
+        m_kernels[key] = reinterpret_cast<ErasedFunction>(function);
+    }
+
+    [[nodiscard]] bool Contains(const KernelKey& key) const
+    {
+        return m_kernels.find(key) != m_kernels.end();
+    }
+
+    //! Returns function registered for key, which must have been registered
+    //! with type Function
+    //! Throws std::runtime_error if no kernel is registered for key
+    template <typename Function>
+    [[nodiscard]] Function Resolve(const KernelKey& key) const
+    {
+        const auto it = m_kernels.find(key);
+        if (it == m_kernels.end())
+            throw std::runtime_error("Not implemented");
+        return reinterpret_cast<Function>(it->second);
+    }
+
+private:
+    KernelRegistry();
+
+    std::unordered_map<KernelKey, ErasedFunction, KernelKeyHash> m_kernels;
+};
+
+//! Resolve kernels for elements of type T on the instruction set kernels are
+//! currently dispatched to (see CPU::GetInstructionSet)
+template <typename T>
+GemmKernelFunction<T> ResolveGemmKernel(KernelOp op, BroadcastMode broadcast,
+                                        KernelLayout layout)
+{
+    return KernelRegistry::Get().Resolve<GemmKernelFunction<T>>(
+        { op, DataTypeOfV<T>, CPU::GetInstructionSet(), broadcast, layout });
+}
+
+template <typename T>
+ElementwiseKernelFunction<T> ResolveElementwiseKernel(
+    KernelOp op, BroadcastMode broadcast = BroadcastMode::None)
+{
+    return KernelRegistry::Get().Resolve<ElementwiseKernelFunction<T>>(
+        { op, DataTypeOfV<T>, CPU::GetInstructionSet(), broadcast });
+}
+
+template <typename T>
+TransposeKernelFunction<T> ResolveTransposeKernel()
+{
+    return KernelRegistry::Get().Resolve<TransposeKernelFunction<T>>(
+        { KernelOp::Transpose, DataTypeOfV<T>, CPU::GetInstructionSet() });
+}
+} // namespace Takion::Compute
+
+#endif
@@ -0,0 +1,325 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_KERNELTABLE_HPP
+#define TAKION_COMPUTE_KERNELTABLE_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/GEMM/SparseGemm.hpp>
+#include <Takion/Computations/Kernels/MathFunction.hpp>
+#include <Takion/Computations/Simd/InstructionSet.hpp>
+#include <Takion/Utils/HalfPrecision.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Takion::Compute::CPU
+{
+//! Kernels for tensors stored in 16 bit type T16 (Float16 or BFloat16)
+//! Values are converted to float when they are loaded, computed and
+//! accumulated in float, and rounded to T16 only when they are stored
+template <typename T16>
+struct HalfKernelTable
+{
+    //! C = A * B (C += A * B if accumulate is true) followed by epilogue,
+    //! where A and B are stored in TA and TB and C is float
+    //! See PackedGemm.hpp
+    template <typename TA, typename TB>
+    using GemmFunction = void (*)(std::size_t m, std::size_t n,
+                                  std::size_t k, const TA* A,
+                                  std::size_t rowStrideA,
+                                  std::size_t colStrideA, const TB* B,
+                                  std::size_t rowStrideB,
+                                  std::size_t colStrideB, float* C,
+                                  std::size_t ldc, bool accumulate,
+                                  bool parallel,
+                                  const GemmEpilogue<float>& epilogue,
+                                  const GemmBlocking& blocking);
+
+    //! Converts numRow rows of numCol elements. Rows of input and out have
+    //! lengths ldInput and ldOut, as 16 bit rows are padded differently
+    template <typename TIn, typename TOut>
+    using ConvertFunction = void (*)(const TIn* input, TOut* out,
+                                     std::size_t numRow, std::size_t numCol,
+                                     std::size_t ldInput, std::size_t ldOut);
+
+    using BinaryFunction = void (*)(const T16* A, const T16* B, T16* out,
+                                    std::size_t size, std::size_t batchSize,
+                                    std::size_t batchStrideA,
+                                    std::size_t batchStrideB);
+
+    using ScalarFunction = void (*)(const T16* input, float scalar, T16* out,
+                                    std::size_t size, std::size_t batchSize);
+
+    using SetFunction = void (*)(T16* data, float toSet, std::size_t size,
+                                 std::size_t batchSize);
+
+    using MathFunctionKernel = void (*)(const T16* input, T16* out,
+                                        std::size_t size,
+                                        std::size_t batchSize,
+                                        MathFunction function);
+
+    GemmFunction<T16, T16> Gemm;
+    //! A stored in float (e.g. gradients multiplied with T16 weights)
+    GemmFunction<float, T16> GemmFloatA;
+    //! B stored in float
+    GemmFunction<T16, float> GemmFloatB;
+    ConvertFunction<T16, float> ToFloat;
+    ConvertFunction<float, T16> FromFloat;
+    BinaryFunction Add;
+    BinaryFunction Sub;
+    //! Elementwise multiplication
+    BinaryFunction Dot;
+    BinaryFunction Div;
+    ScalarFunction ScalarMul;
+    ScalarFunction ScalarDiv;
+    SetFunction Set;
+    MathFunctionKernel Math;
+};
+
+//! Set of CPU kernels compiled for one instruction set
+//! Operands of elementwise kernels hold batchSize blocks of size elements.
+//! Block b of an operand starts at b * batchStride, so a stride of zero
+//! broadcasts the operand over the batch
+template <typename T>
+struct KernelTable
+{
+    //! C = A * B (C += A * B if accumulate is true) followed by epilogue
+    //! See PackedGemm.hpp
+    using GemmFunction = void (*)(std::size_t m, std::size_t n,
+                                  std::size_t k, const T* A,
+                                  std::size_t rowStrideA,
+                                  std::size_t colStrideA, const T* B,
+                                  std::size_t rowStrideB,
+                                  std::size_t colStrideB, T* C,
+                                  std::size_t ldc, bool accumulate,
+                                  bool parallel,
+                                  const GemmEpilogue<T>& epilogue,
+                                  const GemmBlocking& blocking);
+
+    //! Transposes numMatrices numRow x numCol matrices with row lengths
+    //! ldInput and ldOutput
+    using TransposeFunction = void (*)(const T* input, T* output,
+                                       std::size_t numRow, std::size_t numCol,
+                                       std::size_t ldInput,
+                                       std::size_t ldOutput,
+                                       std::size_t numMatrices);
+
+    //! Reduces input viewed as outer x axisSize x inner array along the
+    //! middle axis. See ReductionKernels.hpp
+    using ReduceFunction = void (*)(const T* input, T* output,
+                                    std::size_t outer, std::size_t axisSize,
+                                    std::size_t inner,
+                                    std::size_t outerStride,
+                                    std::size_t outputStride);
+
+    using BinaryFunction = void (*)(const T* A, const T* B, T* out,
+                                    std::size_t size, std::size_t batchSize,
+                                    std::size_t batchStrideA,
+                                    std::size_t batchStrideB);
+
+    using ScalarFunction = void (*)(const T* input, T scalar, T* out,
+                                    std::size_t size, std::size_t batchSize);
+
+    using SetFunction = void (*)(T* data, T toSet, std::size_t size,
+                                 std::size_t batchSize);
+
+    //! out = function(input). See MathKernels.hpp
+    using MathFunctionKernel = void (*)(const T* input, T* out,
+                                        std::size_t size,
+                                        std::size_t batchSize,
+                                        MathFunction function);
+
+    //! Multiplies u8 A with s8 B accumulating in int32
+    //! See QuantizedGemmKernels.hpp
+    using QuantizedGemmFunction = void (*)(std::size_t m, std::size_t n,
+                                           std::size_t k,
+                                           const std::uint8_t* A,
+                                           std::size_t lda,
+                                           const std::int8_t* B,
+                                           std::size_t ldb, std::int32_t* C,
+                                           std::size_t ldc, bool parallel,
+                                           const QuantizedEpilogue& epilogue);
+
+    //! Quantizes float values to uint8. See QuantizedGemmKernels.hpp
+    using QuantizeFunction = void (*)(const float* input, std::uint8_t* out,
+                                      std::size_t size, float scale,
+                                      std::int32_t zeroPoint);
+
+    //! C = A * B^T of signs packed into 64 bit words followed by epilogue
+    //! See BinaryGemmKernels.hpp
+    using BinaryGemmFunction = void (*)(std::size_t m, std::size_t n,
+                                        std::size_t k,
+                                        const std::uint64_t* A,
+                                        const std::uint64_t* B,
+                                        std::size_t numWords, float* C,
+                                        std::size_t ldc, bool parallel,
+                                        const BinaryEpilogue& epilogue);
+
+    //! C = A * B for sparse B followed by epilogue, where A and C are m
+    //! rows with lengths lda and ldc. See SparseGemmKernels.hpp
+    using SparseGemmFunction = void (*)(std::size_t m, const float* A,
+                                        std::size_t lda,
+                                        const SparseMatrix& B, float* C,
+                                        std::size_t ldc, bool parallel,
+                                        const GemmEpilogue<float>& epilogue);
+
+    //! C = A * B followed by epilogue, where A is m rows in compressed
+    //! sparse row format and B and C have rows of length ldb and ldc
+    //! See CsrGemmKernels.hpp
+    using CsrGemmFunction = void (*)(std::size_t m, std::size_t n,
+                                     const std::size_t* rowOffsets,
+                                     const std::uint32_t* columns,
+                                     const T* values, const T* B,
+                                     std::size_t ldb, T* C, std::size_t ldc,
+                                     bool parallel,
+                                     const GemmEpilogue<T>& epilogue);
+
+    InstructionSet Isa;
+    GemmFunction Gemm;
+    TransposeFunction Transpose;
+    ReduceFunction ReduceSum;
+    ReduceFunction ReduceMean;
+    ReduceFunction ReduceMax;
+    ReduceFunction ReduceMin;
+    BinaryFunction Add;
+    BinaryFunction Sub;
+    //! Elementwise multiplication
+    BinaryFunction Dot;
+    BinaryFunction Div;
+    ScalarFunction ScalarMul;
+    ScalarFunction ScalarDiv;
+    SetFunction Set;
+    //! Only set for floating point types
+    MathFunctionKernel Math;
+    //! Only set for floating point types
+    CsrGemmFunction CsrGemm;
+    //! Only set for int
+    QuantizedGemmFunction QuantizedGemm;
+    //! Only set for int
+    QuantizeFunction Quantize;
+    //! Only set for int
+    BinaryGemmFunction BinaryGemm;
+    //! Only set for float
+    SparseGemmFunction SparseGemm;
+    //! Only set for float
+    HalfKernelTable<Float16> Float16Kernels;
+    //! Only set for float
+    HalfKernelTable<BFloat16> BFloat16Kernels;
+};
+
+//! Builds table from static member functions of KernelSet
+//! Defined outside of target regions, so that building the table never
+//! executes instructions of the instruction set it describes
+template <typename KernelSet>
+KernelTable<typename KernelSet::Scalar> MakeKernelTable(
+    InstructionSet instructionSet)
+{
+    KernelTable<typename KernelSet::Scalar> table{};
+    table.Isa = instructionSet;
+    table.Gemm = &KernelSet::Gemm;
+    table.Transpose = &KernelSet::Transpose;
+    table.ReduceSum = &KernelSet::ReduceSum;
+    table.ReduceMean = &KernelSet::ReduceMean;
+    table.ReduceMax = &KernelSet::ReduceMax;
+    table.ReduceMin = &KernelSet::ReduceMin;
+    table.Add = &KernelSet::Add;
+    table.Sub = &KernelSet::Sub;
+    table.Dot = &KernelSet::Dot;
+    table.Div = &KernelSet::Div;
+    table.ScalarMul = &KernelSet::ScalarMul;
+    table.ScalarDiv = &KernelSet::ScalarDiv;
+    table.Set = &KernelSet::Set;
+    if constexpr (std::is_floating_point_v<typename KernelSet::Scalar>)
+    {
+        table.Math = &KernelSet::Math;
+        table.CsrGemm = &KernelSet::CsrGemm;
+    }
+    if constexpr (std::is_same_v<typename KernelSet::Scalar, float>)
+        table.SparseGemm = &KernelSet::SparseGemm;
+    return table;
+}
+
+//! Builds table from static member functions of HalfKernelSet
+//! See MakeKernelTable
+template <typename HalfKernelSet>
+HalfKernelTable<typename HalfKernelSet::Storage> MakeHalfKernelTable()
+{
+    HalfKernelTable<typename HalfKernelSet::Storage> table{};
+    table.Gemm = &HalfKernelSet::Gemm;
+    table.GemmFloatA = &HalfKernelSet::GemmFloatA;
+    table.GemmFloatB = &HalfKernelSet::GemmFloatB;
+    table.ToFloat = &HalfKernelSet::ToFloat;
+    table.FromFloat = &HalfKernelSet::FromFloat;
+    table.Add = &HalfKernelSet::Add;
+    table.Sub = &HalfKernelSet::Sub;
+    table.Dot = &HalfKernelSet::Dot;
+    table.Div = &HalfKernelSet::Div;
+    table.ScalarMul = &HalfKernelSet::ScalarMul;
+    table.ScalarDiv = &HalfKernelSet::ScalarDiv;
+    table.Set = &HalfKernelSet::Set;
+    table.Math = &HalfKernelSet::Math;
+    return table;
+}
+
+namespace Float
+{
+const KernelTable<float>& ScalarKernels();
+const KernelTable<float>& SseKernels();
+const KernelTable<float>& Avx2Kernels();
+const KernelTable<float>& Avx512Kernels();
+
+//! Returns kernels built for given instruction set
+const KernelTable<float>& GetKernelTable(InstructionSet instructionSet);
+
+//! Returns kernels built for instruction set from GetInstructionSet()
+const KernelTable<float>& GetKernelTable();
+
+//! Returns kernels for 16 bit storage type T16 built for instruction set
+//! from GetInstructionSet()
+template <typename T16>
+const HalfKernelTable<T16>& GetHalfKernelTable()
+{
+    static_assert(IsHalfPrecisionV<T16>,
+                  "T16 should be a 16 bit storage type");
+    if constexpr (std::is_same_v<T16, Float16>)
+        return GetKernelTable().Float16Kernels;
+    else
+        return GetKernelTable().BFloat16Kernels;
+}
+} // namespace Float
+
+namespace Double
+{
+const KernelTable<double>& ScalarKernels();
+const KernelTable<double>& SseKernels();
+const KernelTable<double>& Avx2Kernels();
+const KernelTable<double>& Avx512Kernels();
+
+//! Returns kernels built for given instruction set
+const KernelTable<double>& GetKernelTable(InstructionSet instructionSet);
+
+//! Returns kernels built for instruction set from GetInstructionSet()
+const KernelTable<double>& GetKernelTable();
+} // namespace Double
+
+namespace Int
+{
+const KernelTable<int>& ScalarKernels();
+const KernelTable<int>& SseKernels();
+const KernelTable<int>& Avx2Kernels();
+const KernelTable<int>& Avx512Kernels();
+
+//! Returns kernels built for given instruction set
+const KernelTable<int>& GetKernelTable(InstructionSet instructionSet);
+
+//! Returns kernels built for instruction set from GetInstructionSet()
+const KernelTable<int>& GetKernelTable();
+} // namespace Int
+} // namespace Takion::Compute::CPU
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_MATHFUNCTION_HPP
+#define TAKION_COMPUTE_MATHFUNCTION_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <cmath>
+#include <type_traits>
+
+namespace Takion::Compute
+{
+//! Elementwise functions with SIMD kernels (see MathKernels.hpp)
+enum class MathFunction
+{
+    Exp,
+    Log,
+    NegativeLog,
+    Tanh,
+    Sigmoid,
+    Erf,
+    LeakyReLU,
+};
+
+//! Functors which can be passed to Compute::Apply
+//! Apply evaluates float tensors with the vector kernel selected by
+//! Function, and calls operator() one element at a time for other types
+struct Exp
+{
+    static constexpr MathFunction Function = MathFunction::Exp;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return static_cast<T>(std::exp(value));
+    }
+};
+
+struct Log
+{
+    static constexpr MathFunction Function = MathFunction::Log;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return static_cast<T>(std::log(value));
+    }
+};
+
+//! -log(x), used by cross entropy
+struct NegativeLog
+{
+    static constexpr MathFunction Function = MathFunction::NegativeLog;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return static_cast<T>(-std::log(value));
+    }
+};
+
+struct Tanh
+{
+    static constexpr MathFunction Function = MathFunction::Tanh;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return static_cast<T>(std::tanh(value));
+    }
+};
+
+struct Sigmoid
+{
+    static constexpr MathFunction Function = MathFunction::Sigmoid;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return static_cast<T>(static_cast<T>(1) / (1 + std::exp(-value)));
+    }
+};
+
+struct Erf
+{
+    static constexpr MathFunction Function = MathFunction::Erf;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return static_cast<T>(std::erf(value));
+    }
+};
+
+struct LeakyReLU
+{
+    static constexpr MathFunction Function = MathFunction::LeakyReLU;
+
+    template <typename T>
+    T operator()(T value) const
+    {
+        return value > static_cast<T>(0)
+                   ? value
+                   : static_cast<T>(LeakyReLUSlope * value);
+    }
+};
+
+//! True if Function is one of the functors above
+template <typename Function, typename = void>
+struct IsMathFunction : std::false_type
+{
+};
+
+template <typename Function>
+struct IsMathFunction<
+    Function, std::enable_if_t<std::is_same_v<
+                  std::decay_t<decltype(Function::Function)>, MathFunction>>>
+    : std::true_type
+{
+};
+
+template <typename Function>
+constexpr bool IsMathFunctionV = IsMathFunction<Function>::value;
+} // namespace Takion::Compute
+
+#endif
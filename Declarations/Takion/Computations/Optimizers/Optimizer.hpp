@@ -25,6 +25,16 @@ public:
     Optimizer<T>& operator=(Optimizer<T>&& optimizer) noexcept = default;
 
     virtual void Optimize(Tensor<T>& tensor, Tensor<T>& delta) = 0;
+
+    //! Updates only rows of tensor stored in delta (e.g. weights read by
+    //! sparse inputs), leaving the other rows as they are
+    //! Throws std::runtime_error if the optimizer has no sparse update
+    virtual void OptimizeRows(Tensor<T>& tensor, RowSparseMatrix<T>& delta)
+    {
+        (void)tensor;
+        (void)delta;
+        throw std::runtime_error("Not implemented");
+    }
 };
 
 //! Stochastic gradient descent
@@ -49,6 +59,26 @@ public:
         Compute::Add(tensor, update, tensor);
     }
 
+    void OptimizeRows(Tensor<T>& tensor, RowSparseMatrix<T>& update) override
+    {
+        if (tensor.TensorShape.NumRow() != update.NumRow ||
+            tensor.TensorShape.NumCol() != update.NumCol ||
+            tensor.NumMatrix() != 1)
+            throw std::invalid_argument(
+                "Shape mismatch between given tensors. tensor : " +
+                tensor.TensorShape.ToString());
+
+        const auto numCol = update.NumCol;
+        const auto ld = tensor.ColumnElementSize();
+        for (std::size_t idx = 0; idx < update.Rows.size(); ++idx)
+        {
+            auto* row = tensor.Data.Address(update.Rows[idx] * ld);
+            const auto* rowUpdate = update.Values.data() + idx * numCol;
+            for (std::size_t col = 0; col < numCol; ++col)
+                row[col] += m_epsilon * rowUpdate[col];
+        }
+    }
+
 private:
     T m_epsilon;
 };
@@ -0,0 +1,202 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_REDUCTION_HPP
+#define TAKION_COMPUTE_REDUCTION_HPP
+
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <Takion/Tensors/Tensor.hpp>
+#include <string>
+#include <type_traits>
+
+namespace Takion::Compute
+{
+//! Axis of the batch in reductions. Axis i + 1 is dimension i of TensorShape
+constexpr std::size_t BatchAxis = 0;
+
+//! Tensor viewed as Outer x AxisSize x Inner array (see ReductionCpu.hpp)
+struct ReductionLayout
+{
+    std::size_t Outer;
+    std::size_t AxisSize;
+    std::size_t Inner;
+    std::size_t OuterStride;
+    std::size_t OutputStride;
+};
+
+//! Output of a reduction keeps the reduced axis with size of 1
+//! Padding of rows is part of Inner unless the last axis is reduced, in which
+//! case every row is reduced on its own
+template <typename T, typename U>
+ReductionLayout GetReductionLayout(const Tensor<T>& input,
+                                   const Tensor<U>& output, std::size_t axis)
+{
+    const auto& shape = input.TensorShape;
+    const auto dim = shape.Dim();
+    if (axis > dim)
+        throw std::invalid_argument(
+            "Requested reduction along axis " + std::to_string(axis) +
+            " But this tensor has only " + std::to_string(dim + 1) +
+            " axes including the batch");
+
+    if (axis == BatchAxis)
+    {
+        if (output.BatchSize != 1 || output.TensorShape != shape)
+            throw std::invalid_argument(
+                "Output of reduction along the batch should have batch size "
+                "of 1 and shape of input");
+        return { 1, input.BatchSize, input.ElementSize(),
+                 input.TotalElementSize(), output.ElementSize() };
+    }
+
+    auto expectedShape = shape;
+    expectedShape.ChangeDimension(axis - 1, 1);
+    if (output.BatchSize != input.BatchSize ||
+        output.TensorShape != expectedShape)
+        throw std::invalid_argument(
+            "Shape mismatch between input and output of reduction. output : " +
+            output.TensorShape.ToString() +
+            " expected : " + expectedShape.ToString());
+
+    std::size_t outer = input.BatchSize;
+    for (std::size_t i = 0; i + 1 < axis; ++i)
+        outer *= shape.At(i);
+    const auto axisSize = shape.At(axis - 1);
+
+    if (axis == dim)
+        return { outer, axisSize, 1, input.ColumnElementSize(),
+                 output.ColumnElementSize() };
+
+    std::size_t inner = input.ColumnElementSize();
+    for (auto i = axis; i + 1 < dim; ++i)
+        inner *= shape.At(i);
+    return { outer, axisSize, inner, axisSize * inner, inner };
+}
+
+//! Reduces input along axis into output
+//! Work is split over threads along the other axes, and along the reduced
+//! axis too when the other axes are too small to occupy every thread
+template <typename T>
+void Reduce(const Tensor<T>& input, Tensor<T>& output, std::size_t axis,
+            ReduceOp op)
+{
+    const auto device = output.Device;
+    const auto layout = GetReductionLayout(input, output, axis);
+    if (device.Type() == DeviceType::CPU)
+    {
+        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
+            CPU::Float::ReduceCpu(input.Data, output.Data, layout.Outer,
+                                  layout.AxisSize, layout.Inner,
+                                  layout.OuterStride, layout.OutputStride, op);
+        else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 8)
+            CPU::Double::ReduceCpu(input.Data, output.Data, layout.Outer,
+                                   layout.AxisSize, layout.Inner,
+                                   layout.OuterStride, layout.OutputStride, op);
+        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
+            CPU::Int::ReduceCpu(input.Data, output.Data, layout.Outer,
+                                layout.AxisSize, layout.Inner,
+                                layout.OuterStride, layout.OutputStride, op);
+        else
+            throw std::runtime_error("Not implemented");
+    }
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Writes index of the first maximum along axis of input to output
+template <typename T>
+void ArgMax(const Tensor<T>& input, Tensor<int>& output, std::size_t axis)
+{
+    const auto device = output.Device;
+    const auto layout = GetReductionLayout(input, output, axis);
+    if (device.Type() == DeviceType::CPU)
+    {
+        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
+            CPU::Float::ArgMaxCpu(input.Data, output.Data, layout.Outer,
+                                  layout.AxisSize, layout.Inner,
+                                  layout.OuterStride, layout.OutputStride);
+        else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 8)
+            CPU::Double::ArgMaxCpu(input.Data, output.Data, layout.Outer,
+                                   layout.AxisSize, layout.Inner,
+                                   layout.OuterStride, layout.OutputStride);
+        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
+            CPU::Int::ArgMaxCpu(input.Data, output.Data, layout.Outer,
+                                layout.AxisSize, layout.Inner,
+                                layout.OuterStride, layout.OutputStride);
+        else
+            throw std::runtime_error("Not implemented");
+    }
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Reduces every sample of input to the single element of output
+//! Output should have batch size of input and shape of size 1
+template <typename T>
+void ReduceSamples(const Tensor<T>& input, Tensor<T>& output, ReduceOp op)
+{
+    const auto device = output.Device;
+    if (output.BatchSize != input.BatchSize || output.TensorShape.Size() != 1)
+        throw std::invalid_argument(
+            "Output of sample reduction should have one element per sample");
+
+    const auto numCol = input.TensorShape.NumCol();
+    const auto ld = input.ColumnElementSize();
+    const auto rowsPerSample = input.ElementSize() / ld;
+    if (device.Type() == DeviceType::CPU)
+    {
+        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
+            CPU::Float::ReduceRowGroupsCpu(input.Data, output.Data,
+                                           input.BatchSize, rowsPerSample,
+                                           numCol, ld, output.ElementSize(),
+                                           op);
+        else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 8)
+            CPU::Double::ReduceRowGroupsCpu(input.Data, output.Data,
+                                            input.BatchSize, rowsPerSample,
+                                            numCol, ld, output.ElementSize(),
+                                            op);
+        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
+            CPU::Int::ReduceRowGroupsCpu(input.Data, output.Data,
+                                         input.BatchSize, rowsPerSample,
+                                         numCol, ld, output.ElementSize(), op);
+        else
+            throw std::runtime_error("Not implemented");
+    }
+    else
+        throw std::runtime_error("Not implemented");
+}
+
+//! Returns reduction of every element of input including the batch
+template <typename T>
+T ReduceAll(const Tensor<T>& input, ReduceOp op)
+{
+    const auto device = input.Device;
+    const auto numCol = input.TensorShape.NumCol();
+    const auto ld = input.ColumnElementSize();
+    const auto numRows = input.TotalElementSize() / ld;
+    T result = static_cast<T>(0);
+    Util::Span<T> output(&result, 1);
+    if (device.Type() == DeviceType::CPU)
+    {
+        if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4)
+            CPU::Float::ReduceRowGroupsCpu(input.Data, output, 1, numRows,
+                                           numCol, ld, 1, op);
+        else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 8)
+            CPU::Double::ReduceRowGroupsCpu(input.Data, output, 1, numRows,
+                                            numCol, ld, 1, op);
+        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
+            CPU::Int::ReduceRowGroupsCpu(input.Data, output, 1, numRows,
+                                         numCol, ld, 1, op);
+        else
+            throw std::runtime_error("Not implemented");
+    }
+    else
+        throw std::runtime_error("Not implemented");
+    return result;
+}
+} // namespace Takion::Compute
+
+#endif
@@ -0,0 +1,99 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_REDUCTIONCPU_HPP
+#define TAKION_COMPUTE_REDUCTIONCPU_HPP
+
+#include <Takion/Utils/Span.hpp>
+#include <cstddef>
+
+namespace Takion::Compute
+{
+enum class ReduceOp
+{
+    Sum,
+    Mean,
+    Max,
+    Min,
+};
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU
+{
+//! Returns 64 byte aligned scratch memory of at least byteSize bytes owned
+//! by the calling thread, so reductions do not allocate on every call
+//! Slot 0 holds intermediate results of ReductionCpu functions and slot 1
+//! partial results of reduction kernels
+void* ReductionScratchBuffer(std::size_t slot, std::size_t byteSize);
+} // namespace Takion::Compute::CPU
+
+//! Reductions view input as outer x axisSize x inner array and reduce it
+//! along the middle axis. Block o of input starts at o * outerStride, and
+//! result (o, j) is written to output[o * outputStride + j]
+namespace Takion::Compute::CPU::Float
+{
+using namespace Util;
+void ReduceCpu(const Span<float> input, Span<float> output, std::size_t outer,
+               std::size_t axisSize, std::size_t inner,
+               std::size_t outerStride, std::size_t outputStride, ReduceOp op);
+
+//! Writes index of the first maximum along the middle axis
+void ArgMaxCpu(const Span<float> input, Span<int> output, std::size_t outer,
+               std::size_t axisSize, std::size_t inner,
+               std::size_t outerStride, std::size_t outputStride);
+
+//! Reduces every group of rowsPerGroup rows of numCol elements to one value
+//! written to output[groupIdx * outputStride]. Rows are ld elements apart,
+//! so padding of rows is skipped
+void ReduceRowGroupsCpu(const Span<float> input, Span<float> output,
+                        std::size_t numGroups, std::size_t rowsPerGroup,
+                        std::size_t numCol, std::size_t ld,
+                        std::size_t outputStride, ReduceOp op);
+} // namespace Takion::Compute::CPU::Float
+
+namespace Takion::Compute::CPU::Double
+{
+using namespace Util;
+void ReduceCpu(const Span<double> input, Span<double> output,
+               std::size_t outer, std::size_t axisSize, std::size_t inner,
+               std::size_t outerStride, std::size_t outputStride, ReduceOp op);
+
+//! Writes index of the first maximum along the middle axis
+void ArgMaxCpu(const Span<double> input, Span<int> output,
+               std::size_t outer, std::size_t axisSize, std::size_t inner,
+               std::size_t outerStride, std::size_t outputStride);
+
+//! Reduces every group of rowsPerGroup rows of numCol elements to one value
+//! written to output[groupIdx * outputStride]. Rows are ld elements apart,
+//! so padding of rows is skipped
+void ReduceRowGroupsCpu(const Span<double> input, Span<double> output,
+                        std::size_t numGroups, std::size_t rowsPerGroup,
+                        std::size_t numCol, std::size_t ld,
+                        std::size_t outputStride, ReduceOp op);
+} // namespace Takion::Compute::CPU::Double
+
+namespace Takion::Compute::CPU::Int
+{
+using namespace Util;
+void ReduceCpu(const Span<int> input, Span<int> output, std::size_t outer,
+               std::size_t axisSize, std::size_t inner,
+               std::size_t outerStride, std::size_t outputStride, ReduceOp op);
+
+//! Writes index of the first maximum along the middle axis
+void ArgMaxCpu(const Span<int> input, Span<int> output, std::size_t outer,
+               std::size_t axisSize, std::size_t inner,
+               std::size_t outerStride, std::size_t outputStride);
+
+//! Reduces every group of rowsPerGroup rows of numCol elements to one value
+//! written to output[groupIdx * outputStride]. Rows are ld elements apart,
+//! so padding of rows is skipped
+void ReduceRowGroupsCpu(const Span<int> input, Span<int> output,
+                        std::size_t numGroups, std::size_t rowsPerGroup,
+                        std::size_t numCol, std::size_t ld,
+                        std::size_t outputStride, ReduceOp op);
+} // namespace Takion::Compute::CPU::Int
+
+#endif
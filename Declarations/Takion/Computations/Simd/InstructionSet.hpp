@@ -0,0 +1,61 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_INSTRUCTIONSET_HPP
+#define TAKION_COMPUTE_INSTRUCTIONSET_HPP
+
+#include <string>
+
+namespace Takion::Compute::CPU
+{
+//! x86 instruction set levels CPU kernels are built for
+//! Levels are ordered so that every level implies the ones below it
+enum class InstructionSet
+{
+    //! Portable C++ without intrinsics
+    Scalar = 0,
+    //! SSE4.1 (128 bit vectors)
+    SSE = 1,
+    //! AVX2, FMA and F16C (256 bit vectors)
+    AVX2 = 2,
+    //! AVX-512F and AVX-512BW (512 bit vectors)
+    AVX512 = 3,
+};
+
+//! Returns highest instruction set supported by both the processor and
+//! the operating system
+InstructionSet DetectInstructionSet();
+
+//! Returns true if the processor supports AVX-512 VNNI, which int8 GEMM
+//! uses in place of AVX-512BW byte multiplications when dispatched to AVX512
+bool HasAvx512Vnni();
+
+//! Returns true if the processor supports AVX-512 VPOPCNTDQ, which binary
+//! GEMM uses in place of nibble lookups when dispatched to AVX512
+bool HasAvx512Vpopcntdq();
+
+//! Returns instruction set kernels are currently dispatched to
+//! Defaults to DetectInstructionSet() unless TAKION_ISA environment variable
+//! (scalar, sse, avx2 or avx512) or SetInstructionSet overrides it
+//! Throws std::invalid_argument if TAKION_ISA names an instruction set the
+//! processor does not support
+InstructionSet GetInstructionSet();
+
+//! Forces kernels to be dispatched to given instruction set
+//! Throws std::invalid_argument if the processor does not support it
+void SetInstructionSet(InstructionSet instructionSet);
+
+//! Restores dispatching to the detected instruction set
+void ResetInstructionSet();
+
+std::string ToString(InstructionSet instructionSet);
+
+//! Parses name of the instruction set (case insensitive)
+//! Throws std::invalid_argument if name is unknown
+InstructionSet ToInstructionSet(std::string name);
+} // namespace Takion::Compute::CPU
+
+#endif
@@ -0,0 +1,60 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_TARGETREGION_HPP
+#define TAKION_COMPUTE_TARGETREGION_HPP
+
+//! Every function defined between TAKION_TARGET_<ISA>_BEGIN and
+//! TAKION_TARGET_END is compiled for given instruction set, regardless of
+//! global compiler flags. This lets one binary carry kernels for several
+//! instruction sets which are selected at runtime
+//!
+//! Templates instantiated inside a region keep the target of the region
+//! they were defined in. Therefore translation units using these regions
+//! must include standard and Takion headers before the region begins and
+//! only include kernel implementations inside of it
+//!
+//! Inline functions and templates defined inside a region are emitted as
+//! weak symbols, and the linker keeps only one copy of each. Every function
+//! defined inside a region must therefore be a template which depends on
+//! vector traits of the region (or be in a namespace of its own instruction
+//! set), otherwise the scalar build may end up calling AVX-512 code
+
+#if defined(__clang__)
+
+#define TAKION_PRAGMA(x) _Pragma(#x)
+#define TAKION_CLANG_TARGET(isa) \
+    TAKION_PRAGMA(                \
+        clang attribute push(__attribute__((target(isa))), apply_to = function))
+
+#define TAKION_TARGET_SSE_BEGIN TAKION_CLANG_TARGET("sse4.1")
+#define TAKION_TARGET_AVX2_BEGIN TAKION_CLANG_TARGET("avx2,fma,f16c")
+#define TAKION_TARGET_AVX512_BEGIN \
+    TAKION_CLANG_TARGET("avx512f,avx512bw,avx2,fma,f16c")
+#define TAKION_TARGET_END _Pragma("clang attribute pop")
+
+#elif defined(__GNUC__)
+
+#define TAKION_TARGET_SSE_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"sse4.1\")")
+#define TAKION_TARGET_AVX2_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma,f16c\")")
+#define TAKION_TARGET_AVX512_BEGIN \
+    _Pragma("GCC push_options")    \
+        _Pragma("GCC target(\"avx512f,avx512bw,avx2,fma,f16c\")")
+#define TAKION_TARGET_END _Pragma("GCC pop_options")
+
+#else
+
+//! MSVC accepts intrinsics of every instruction set without target flags
+#define TAKION_TARGET_SSE_BEGIN
+#define TAKION_TARGET_AVX2_BEGIN
+#define TAKION_TARGET_AVX512_BEGIN
+#define TAKION_TARGET_END
+
+#endif
+
+#endif
@@ -11,6 +11,7 @@
 #include <Takion/FrontEnd/UnitMetaData.hpp>
 #include <Takion/Computations/Optimizers/Optimizer.hpp>
 #include <Takion/Utils/Loaders/Loader.hpp>
+#include <Takion/Utils/Loaders/SparseLoader.hpp>
 #include <unordered_map>
 
 namespace Takion::Engine
@@ -38,6 +39,9 @@ public:
     void SetLoader(const UnitId& unitId,
                    std::unique_ptr<Util::Loader<T>> loader);
 
+    void SetLoader(const UnitId& unitId,
+                   std::unique_ptr<Util::SparseLoader<T>> loader);
+
     Shape GetUnitOutputShape(const UnitId& unitId);
 
     void Compile(const std::string& optimizerName, const Parameter& parameter);
@@ -54,6 +58,25 @@ public:
 
     virtual void ChangeBatchSize(std::size_t batchSize);
 
+    //! Widens activation ranges of Dense, ReLU and Sigmoid units with the
+    //! tensors of the last forward propagation
+    void RecordRanges();
+
+    //! Converts every Dense unit for int8 inference using the ranges
+    //! recorded by RecordRanges (see DenseUnit::Quantize)
+    void Quantize();
+
+    //! Prunes weights of every Dense unit for sparse inference
+    //! (see DenseUnit::Sparsify)
+    void Sparsify(Compute::SparseFormat format, float threshold);
+
+    //! Sets precision of every Dense unit (see DenseUnit::SetPrecision)
+    void SetPrecision(Compute::Precision precision);
+
+    //! Converts every Dense unit for binarized inference
+    //! (see DenseUnit::Binarize)
+    void Binarize();
+
     [[nodiscard]] const Tensor<T>& GetOutput(UnitId unitId) const;
 
     std::unique_ptr<Graph::ComputableUnit<T>>& GetUnit(const UnitId& unitId);
@@ -72,6 +95,18 @@ private:
                         const Parameter& parameter);
     bool m_appendLoss(const FrontEnd::UnitMetaData<T>& unitMetaData);
 
+    //! Lets Dense units apply the activation of a ReLU or Sigmoid unit
+    //! which is their only output in the GEMM epilogue
+    void m_fuseActivations();
+
+    //! Lets Dense units read batches of the sparse Fetchers they are
+    //! connected to (see DenseUnit::SetSparseInput)
+    void m_linkSparseInputs();
+
+    //! Resolves kernels of units from the kernel registry, so that they are
+    //! not looked up on every call
+    void m_resolveKernels();
+
 
     [[nodiscard]] std::unique_ptr<Compute::Optimizer<T>> m_makeOptimizer(
         const std::string& optimizerName,
@@ -82,6 +117,8 @@ private:
     std::unordered_map<UnitId, std::unique_ptr<Graph::ComputableUnit<T>>>
     m_unitMap;
     std::unordered_map<UnitId, std::unique_ptr<Util::Loader<T>>> m_loaderMap;
+    std::unordered_map<UnitId, std::unique_ptr<Util::SparseLoader<T>>>
+    m_sparseLoaderMap;
     std::size_t m_batchSize;
 };
 } // namespace Takion::Graph
@@ -14,6 +14,7 @@
 #include <Takion/Utils/Parameter.hpp>
 #include <Takion/Utils/Shape.hpp>
 #include <Takion/Utils/Loaders/Loader.hpp>
+#include <Takion/Utils/Loaders/SparseLoader.hpp>
 #include <Takion/Utils/TensorData.hpp>
 #include <memory>
 #include <vector>
@@ -35,6 +36,17 @@ public:
 
     AbsTensor<T> Fetcher(const Shape& shape, std::string name = "Fetcher");
 
+    //! Fetcher of sparse input features of shape delivered in compressed
+    //! sparse row format, so they are never stored densely
+    //! Can only be read by Dense units, which multiply and update only rows
+    //! of their weights at non-zero features (see DenseUnit::SetSparseInput)
+    AbsTensor<T> SparseFetcher(
+        const Shape& shape, std::unique_ptr<Util::SparseLoader<T>> loader,
+        std::string name = "SparseFetcher");
+
+    AbsTensor<T> SparseFetcher(const Shape& shape,
+                               std::string name = "SparseFetcher");
+
     AbsTensor<T> Constant(const Shape& shape, std::vector<T> data,
                           std::string name);
 
@@ -76,6 +88,37 @@ public:
 
     void Fit(std::size_t epochs);
 
+    //! Runs forward propagation numBatches times with data of fetchers and
+    //! records ranges of Dense inputs and ReLU and Sigmoid outputs
+    //! Ranges are widened by every call
+    void Calibrate(std::size_t numBatches);
+
+    //! Records ranges for a single batch of given input data
+    void Calibrate(std::map<AbsTensor<T>, std::vector<T>> inputDataMap);
+
+    //! Converts Dense units to int8 inference with the calibrated ranges
+    //! Must be called after Compile and Calibrate. Quantized models can
+    //! only be used for prediction
+    void Quantize();
+
+    //! Stores weights of Dense units in sparse format, pruning weights with
+    //! magnitude of at most threshold (see DenseUnit::Sparsify)
+    //! Must be called after Compile. Sparse models can only be used for
+    //! prediction
+    void Sparsify(Compute::SparseFormat format, float threshold = 0.0f);
+
+    //! Stores weights and inputs of Dense units in given precision while
+    //! accumulating in float (see DenseUnit::SetPrecision)
+    //! Must be called after Compile. Half precision and binary models can be
+    //! trained, as float master weights are kept
+    void SetPrecision(Compute::Precision precision);
+
+    //! Converts Dense units to binarized inference, keeping only signs of
+    //! weights packed into bits (see DenseUnit::Binarize)
+    //! Must be called after Compile. Models trained with binary precision
+    //! predict the same afterwards, but can no longer be trained
+    void Binarize();
+
     [[nodiscard]] Util::TensorData<T> Output(
         AbsTensor<T> absTensor) const;
 
@@ -91,6 +134,10 @@ public:
     void ChangeLoader(AbsTensor<T> loaderId,
                       std::function<std::vector<T>()> loaderFunction);
 
+    //! Sets batch delivered by sparse Fetcher fetcher
+    //! Must be called after Compile
+    void SetSparseData(AbsTensor<T> fetcher, Compute::CsrMatrix<T> data);
+
 private:
 
     void m_appendSubjectUnitToPreviousOutput(const UnitId& subjectUnit,
@@ -0,0 +1,42 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_GRAPH_ACTIVATIONRANGE_HPP
+#define TAKION_GRAPH_ACTIVATIONRANGE_HPP
+
+#include <Takion/Computations/Reductions/Reduction.hpp>
+#include <Takion/Tensors/Tensor.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace Takion::Graph
+{
+//! Smallest and largest values a tensor held over the batches it was
+//! recorded for (see Model::Calibrate)
+struct ActivationRange
+{
+    float Min = std::numeric_limits<float>::max();
+    float Max = std::numeric_limits<float>::lowest();
+
+    //! True if nothing was recorded yet
+    [[nodiscard]] bool Empty() const
+    {
+        return Min > Max;
+    }
+
+    //! Widens the range to include every value of tensor
+    template <typename T>
+    void Record(const Tensor<T>& tensor)
+    {
+        Min = std::min(Min, static_cast<float>(Compute::ReduceAll(
+                                tensor, Compute::ReduceOp::Min)));
+        Max = std::max(Max, static_cast<float>(Compute::ReduceAll(
+                                tensor, Compute::ReduceOp::Max)));
+    }
+};
+} // namespace Takion::Graph
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef TAKION_GRAPH_RELU_DECL_HPP
 #define TAKION_GRAPH_RELU_DECL_HPP
 
+#include <Takion/Units/ActivationRange.hpp>
 #include <Takion/Units/ComputableUnit.hpp>
 #include <Takion/FrontEnd/UnitMetaData.hpp>
 
@@ -49,9 +50,24 @@ public:
 
     void ChangeBatchSize(std::size_t batchSize) override;
 
+    //! Input is activated by the source unit already, so Forward only
+    //! copies it (see DenseUnit::FuseActivation)
+    void FuseIntoSource();
+
+    //! Widens OutputRange to include the current forward output
+    void RecordRange();
+
+    //! Range of outputs recorded by RecordRange
+    [[nodiscard]] const ActivationRange& OutputRange() const
+    {
+        return m_outputRange;
+    }
+
 private:
 
     UnitId m_sourceUnitId;
+    bool m_fusedIntoSource = false;
+    ActivationRange m_outputRange;
 
     static void m_checkArguments(const Shape& inputShape,
                                  const Shape& outputShape,
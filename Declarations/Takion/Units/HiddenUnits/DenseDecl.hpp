@@ -7,9 +7,19 @@
 #ifndef TAKION_GRAPH_DENSE_DECL_HPP
 #define TAKION_GRAPH_DENSE_DECL_HPP
 
+#include <Takion/Computations/GEMM/BinaryGemm.hpp>
+#include <Takion/Computations/GEMM/CsrGemm.hpp>
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/QuantizedGemm.hpp>
+#include <Takion/Computations/GEMM/SparseGemm.hpp>
+#include <Takion/Computations/GEMM/GemmTuner.hpp>
+#include <Takion/Computations/Jit/JitGemm.hpp>
+#include <Takion/Computations/Kernels/KernelRegistry.hpp>
+#include <Takion/Units/ActivationRange.hpp>
 #include <Takion/Units/ComputableUnit.hpp>
 #include <Takion/FrontEnd/UnitMetaData.hpp>
 #include <Takion/Units/TrainableUnit.hpp>
+#include <Takion/Utils/HalfPrecision.hpp>
 
 namespace Takion::Graph
 {
@@ -55,8 +65,203 @@ public:
 
     void ChangeBatchSize(std::size_t batchSize) override;
 
+    //! Applies activation to the output in the GEMM epilogue of Forward
+    //! Used when the only unit reading the output is an activation unit
+    //! (see UnitManager::Compile), which then passes the output on as is
+    void FuseActivation(Compute::ActivationType activation);
+
+    //! Resolves GEMM kernels of Forward and Backward from the kernel registry
+    //! for the instruction set kernels are currently dispatched to, and their
+    //! cache blocking for the current batch size from GemmTuner. Float units
+    //! also generate their forward kernel if JIT is enabled (see Jit), unless
+    //! a single sample of a single row is multiplied, which the GEMV kernel
+    //! of PackedGemm handles
+    //! Called by UnitManager::Compile. Units which are not compiled resolve
+    //! their kernels when they are first used
+    void ResolveKernels();
+
+    //! Reads input from the sparse batch of a SparsePlaceHolder instead of
+    //! the forward input tensor, which then only carries the state of the
+    //! graph. Forward reads only rows of weight at features which are
+    //! non-zero in the batch, and Backward computes and updates only these
+    //! rows (see Optimizer::OptimizeRows). No gradient is passed back to the
+    //! placeholder
+    //! Called by UnitManager::Compile for units reading a sparse Fetcher
+    void SetSparseInput(std::shared_ptr<const Compute::CsrMatrix<T>> input);
+
+    [[nodiscard]] bool HasSparseInput() const
+    {
+        return m_sparseInput != nullptr;
+    }
+
+    //! Converts the unit for binarized inference, setting binary precision
+    //! if it is not set yet (see SetPrecision). Float weights are released,
+    //! so only the packed signs of weights (1/32 of their size) are kept, and
+    //! the unit cannot be trained afterwards
+    //! Only float units can be binarized
+    void Binarize();
+
+    [[nodiscard]] bool IsBinarized() const
+    {
+        return m_binary && !TrainableTensorMap.count("weight");
+    }
+
+    //! Widens InputRange to include the current forward input
+    //! Units with sparse input have no input range
+    void RecordRange();
+
+    //! Range of inputs recorded by RecordRange
+    [[nodiscard]] const ActivationRange& InputRange() const
+    {
+        return m_inputRange;
+    }
+
+    //! Converts the unit for int8 inference. Weights are stored as int8 with
+    //! one scale per output channel and inputs are quantized to uint8 with
+    //! the scale and zero point of InputRange. Float weights are released,
+    //! so the unit cannot be trained afterwards
+    //! Only float units can be quantized
+    void Quantize();
+
+    [[nodiscard]] bool IsQuantized() const
+    {
+        return m_quantized != nullptr;
+    }
+
+    //! Converts the unit for inference with pruned weights. Weights with
+    //! magnitude of at most threshold are pruned and the others are stored
+    //! in format, so Forward only multiplies the remaining weights. Float
+    //! weights are released, so the unit cannot be trained afterwards
+    //! Only float units can be sparsified
+    void Sparsify(Compute::SparseFormat format, float threshold = 0.0f);
+
+    [[nodiscard]] bool IsSparse() const
+    {
+        return m_sparseWeight != nullptr;
+    }
+
+    //! Stores weights and inputs of GEMMs in given precision. Products are
+    //! accumulated in float, and float weights are kept as master weights
+    //! which are updated by the optimizer and converted again after every
+    //! step. Outputs and gradients passed to other units stay float
+    //! Binary units multiply signs of inputs and weights with XOR and
+    //! popcount (see BinaryMatrix), and are trained with the straight-through
+    //! estimator: gradients pass through the sign of values within [-1, 1]
+    //! unchanged and are cancelled for the others
+    //! Only float units can use 16 bit or binary precision
+    void SetPrecision(Compute::Precision precision);
+
+    [[nodiscard]] Compute::Precision GetPrecision() const
+    {
+        if (m_float16)
+            return Compute::Precision::Float16;
+        if (m_bfloat16)
+            return Compute::Precision::BFloat16;
+        if (m_binary)
+            return Compute::Precision::Binary;
+        return Compute::Precision::Float32;
+    }
+
 private:
+    //! Weights and buffers used by Forward once the unit is quantized
+    struct QuantizedState
+    {
+        QuantizedState(const Tensor<T>& input, const Tensor<T>& weight)
+            : Input(input.TensorShape, input.BatchSize, input.Device),
+              Weight(weight.TensorShape, weight.Device)
+        {
+        }
+
+        Tensor<std::uint8_t> Input;
+        Tensor<std::int8_t> Weight;
+        Compute::QuantizationParameters InputQuantization;
+        Compute::Requantization Requantization;
+    };
+
+    //! 16 bit copies of the input and weight used by GEMMs of the unit
+    template <typename T16>
+    struct HalfState
+    {
+        HalfState(const Tensor<T>& input, const Tensor<T>& weight)
+            : Input(input.TensorShape, input.BatchSize, input.Device),
+              Weight(weight.TensorShape, weight.Device)
+        {
+        }
+
+        Tensor<T16> Input;
+        Tensor<T16> Weight;
+    };
+
+    //! Packed signs used by Forward of binary units. Backward multiplies the
+    //! values they stand for, which are kept in binaryInput and binaryWeight
+    //! (transposed) of InternalTensorMap until the unit is binarized
+    struct BinaryState
+    {
+        //! Signs of every sample of the input of the last Forward
+        Compute::BinaryMatrix Input;
+        //! Signs of every column of weight
+        Compute::BinaryMatrix Weight;
+    };
+
+    //! GEMM kernels resolved by ResolveKernels. Weights have batch size of 1
+    //! and are broadcast over the batch of inputs and deltas
+    struct Kernels
+    {
+        Compute::GemmKernelFunction<T> Forward = nullptr;
+        Compute::GemmKernelFunction<T> BackwardOutput = nullptr;
+        Compute::GemmKernelFunction<T> WeightGradient = nullptr;
+        Compute::CPU::GemmBlocking ForwardBlocking;
+        Compute::CPU::GemmBlocking BackwardOutputBlocking;
+        Compute::CPU::GemmBlocking WeightGradientBlocking;
+        //! Forward kernel generated for the current shapes (float only), or
+        //! nullptr if JIT is disabled (see Jit::CompileGemm)
+        std::shared_ptr<const Compute::Jit::GemmKernel> JitForward;
+    };
+
+    //! Resolves blocking of the kernels and generates kernels for shapes of
+    //! the current batch
+    void m_resolveShapeKernels();
+
+    //! Runs Forward with float, double or int weights
+    void m_forward();
+    void m_quantizedForward();
+    void m_sparseForward();
+    void m_sparseInputForward();
+    //! Updates rows of weight read by the sparse input of the last Forward
+    void m_sparseInputUpdate(const Tensor<T>& delta);
+    void m_binaryForward();
+    template <typename T16>
+    void m_halfForward(HalfState<T16>& state);
+    //! Computes backward output and weight gradient from delta with 16 bit
+    //! weight and input
+    template <typename T16>
+    void m_halfGradient(HalfState<T16>& state, const Tensor<T>& delta,
+                        Tensor<T>& backwardOutput,
+                        Tensor<T>& weightUpdateMean);
+    //! Computes backward output and weight gradient from delta with the
+    //! straight-through estimator of binary weight and input
+    void m_binaryGradient(const Tensor<T>& delta, Tensor<T>& backwardOutput,
+                          Tensor<T>& weightUpdateMean);
+    //! Multiplies delta into backward output and weight gradient in the
+    //! precision of the unit
+    void m_gradient(const Tensor<T>& delta, Tensor<T>& backwardOutput,
+                    Tensor<T>& weightUpdateMean);
+    //! Converts updated master weight to the 16 bit or binary weight
+    void m_convertMasterWeight();
+    void m_checkTrainable() const;
+
     UnitId m_sourceUnitId;
+    Compute::ActivationType m_activation = Compute::ActivationType::None;
+    ActivationRange m_inputRange;
+    Kernels m_kernels;
+    std::unique_ptr<QuantizedState> m_quantized;
+    std::unique_ptr<Compute::SparseMatrix> m_sparseWeight;
+    std::shared_ptr<const Compute::CsrMatrix<T>> m_sparseInput;
+    //! Gradient of the rows of weight read by the sparse input
+    Compute::RowSparseMatrix<T> m_sparseWeightUpdate;
+    std::unique_ptr<HalfState<Float16>> m_float16;
+    std::unique_ptr<HalfState<BFloat16>> m_bfloat16;
+    std::unique_ptr<BinaryState> m_binary;
     static void m_checkShape(const Shape& inputShape, const Shape& outputShape,
                              const Shape& weightShape, const Shape& biasShape,
                              const std::string& unitName);
@@ -0,0 +1,89 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_GRAPH_SPARSEPLACEHOLDER_DECL_HPP
+#define TAKION_GRAPH_SPARSEPLACEHOLDER_DECL_HPP
+
+#include <Takion/Units/ComputableUnit.hpp>
+#include <Takion/FrontEnd/UnitMetaData.hpp>
+#include <Takion/Utils/Loaders/SparseLoader.hpp>
+#include <memory>
+
+namespace Takion::Graph
+{
+//! Source unit delivering batches of sparse input features in compressed
+//! sparse row format (see Util::SparseLoader)
+//! Features are never stored densely. Units reading them get the batch
+//! through SparseOutput (see DenseUnit::SetSparseInput), and ForwardOutput
+//! only carries the state of the graph, so it holds one element per sample
+template <typename T>
+class SparsePlaceHolder : public ComputableUnit<T>
+{
+public:
+    using ComputableUnit<T>::ForwardOutput;
+
+    SparsePlaceHolder(const UnitId& unitId, Tensor<T> forwardOutput,
+                      std::unique_ptr<Util::SparseLoader<T>> loader,
+                      std::size_t numFeatures, std::size_t batchSize);
+
+    ~SparsePlaceHolder() = default;
+
+    static SparsePlaceHolder<T> CreateUnit(
+        const FrontEnd::UnitMetaData<T>& unitMetaData,
+        std::unique_ptr<Util::SparseLoader<T>> loader);
+
+    SparsePlaceHolder(const SparsePlaceHolder& placeHolder) = delete;
+
+    SparsePlaceHolder(SparsePlaceHolder&& placeHolder) noexcept
+        : ComputableUnit<T>(std::move(placeHolder)),
+          m_loader(std::move(placeHolder.m_loader)),
+          m_output(std::move(placeHolder.m_output)),
+          m_numFeatures(placeHolder.m_numFeatures)
+    {
+    }
+
+    SparsePlaceHolder& operator=(const SparsePlaceHolder& placeHolder) =
+    delete;
+
+    SparsePlaceHolder& operator=(SparsePlaceHolder&& placeHolder) noexcept
+    {
+        ComputableUnit<T>::operator=(std::move(placeHolder));
+        m_loader = std::move(placeHolder.m_loader);
+        m_output = std::move(placeHolder.m_output);
+        m_numFeatures = placeHolder.m_numFeatures;
+        return *this;
+    }
+
+    //! Loads next batch into SparseOutput
+    //! Throws std::runtime_error if the batch does not have one row of
+    //! numFeatures columns per sample, or indexes features out of range
+    void Forward() override;
+
+    void AsyncForward(std::promise<bool> promise) override;
+
+    void Backward() override;
+
+    void AsyncBackward(std::promise<bool> promise) override;
+
+    //! Batch loaded by the last Forward, shared with units reading it
+    [[nodiscard]] std::shared_ptr<const Compute::CsrMatrix<T>> SparseOutput()
+    const
+    {
+        return m_output;
+    }
+
+    std::unique_ptr<Util::SparseLoader<T>>& GetLoader()
+    {
+        return m_loader;
+    }
+
+private:
+    std::unique_ptr<Util::SparseLoader<T>> m_loader;
+    std::shared_ptr<Compute::CsrMatrix<T>> m_output;
+    std::size_t m_numFeatures;
+};
+}
+#endif
@@ -0,0 +1,152 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_UTIL_HALFPRECISION_HPP
+#define TAKION_UTIL_HALFPRECISION_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Takion
+{
+//! IEEE 754 binary16 storage type (1 sign, 5 exponent and 10 mantissa bits)
+//! Values are converted to float for every computation, so tensors of this
+//! type only halve memory and bandwidth. Conversion from float rounds to
+//! nearest even
+struct Float16
+{
+    std::uint16_t Bits = 0;
+
+    Float16() = default;
+
+    Float16(float value)
+        : Bits(FromFloat(value))
+    {
+    }
+
+    operator float() const
+    {
+        return ToFloat(Bits);
+    }
+
+    static std::uint16_t FromFloat(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+        bits &= 0x7fffffffu;
+
+        // Infinity and NaN (kept quiet)
+        if (bits >= 0x7f800000u)
+            return sign | (bits > 0x7f800000u ? 0x7e00u : 0x7c00u);
+        // Rounds to infinity
+        if (bits >= 0x47800000u)
+            return sign | 0x7c00u;
+        // Subnormal. Adding 0.5 aligns units of the smallest subnormal with
+        // the last mantissa bit, so the addition itself rounds to even
+        if (bits < 0x38800000u)
+        {
+            float magnitude;
+            std::memcpy(&magnitude, &bits, sizeof(magnitude));
+            magnitude += 0.5f;
+            std::memcpy(&bits, &magnitude, sizeof(bits));
+            return sign | static_cast<std::uint16_t>(bits - 0x3f000000u);
+        }
+
+        const auto odd = (bits >> 13) & 1u;
+        bits += 0xc8000fffu + odd;
+        return sign | static_cast<std::uint16_t>(bits >> 13);
+    }
+
+    static float ToFloat(std::uint16_t half)
+    {
+        const auto sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+        const auto exponent = (half >> 10) & 0x1fu;
+        const auto mantissa = static_cast<std::uint32_t>(half & 0x3ffu);
+
+        if (exponent == 0)
+        {
+            const auto magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -magnitude : magnitude;
+        }
+
+        const auto bits =
+            sign | (exponent == 0x1fu ? 0x7f800000u
+                                      : (exponent + 112u) << 23) |
+            (mantissa << 13);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+//! bfloat16 storage type (upper half of float)
+//! Keeps the range of float with 8 bits of precision. Conversion from float
+//! rounds to nearest even
+struct BFloat16
+{
+    std::uint16_t Bits = 0;
+
+    BFloat16() = default;
+
+    BFloat16(float value)
+        : Bits(FromFloat(value))
+    {
+    }
+
+    operator float() const
+    {
+        return ToFloat(Bits);
+    }
+
+    static std::uint16_t FromFloat(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // NaN is kept quiet, so rounding never turns it into infinity
+        if ((bits & 0x7fffffffu) > 0x7f800000u)
+            return static_cast<std::uint16_t>((bits >> 16) | 0x40u);
+        bits += 0x7fffu + ((bits >> 16) & 1u);
+        return static_cast<std::uint16_t>(bits >> 16);
+    }
+
+    static float ToFloat(std::uint16_t half)
+    {
+        const auto bits = static_cast<std::uint32_t>(half) << 16;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+//! True for 16 bit storage types computed in float
+template <typename T>
+constexpr bool IsHalfPrecisionV =
+    std::is_same_v<T, Float16> || std::is_same_v<T, BFloat16>;
+
+static_assert(sizeof(Float16) == 2 && sizeof(BFloat16) == 2,
+              "16 bit storage types should not be padded");
+} // namespace Takion
+
+namespace Takion::Compute
+{
+//! Storage type of weights and activations kept by units
+//! Half precision units accumulate in float and keep float master weights
+//! for training (see Model::SetPrecision)
+enum class Precision
+{
+    Float32,
+    Float16,
+    BFloat16,
+    //! Signs packed into bits, scaled by the mean magnitude of every row of
+    //! inputs and column of weights (see BinaryMatrix)
+    Binary,
+};
+} // namespace Takion::Compute
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_UTIL_SPARSELOADER_HPP
+#define TAKION_UTIL_SPARSELOADER_HPP
+
+#include <Takion/Computations/GEMM/CsrGemm.hpp>
+#include <Takion/Utils/Shape.hpp>
+
+namespace Takion::Util
+{
+//! Loader of batches of sparse input features in compressed sparse row
+//! format, with one row of shape.Size() columns per sample
+//! Returns an empty batch (every feature zero) until data is set
+template <typename T>
+class SparseLoader
+{
+public:
+    SparseLoader(Shape shape, std::size_t batchSize)
+    {
+        m_data.NumCol = shape.Size();
+        m_data.RowOffsets.assign(batchSize + 1, 0);
+    }
+
+    virtual ~SparseLoader() = default;
+
+    void SetData(Compute::CsrMatrix<T> data)
+    {
+        m_data = std::move(data);
+    }
+
+    virtual Compute::CsrMatrix<T> operator()()
+    {
+        return m_data;
+    }
+
+protected:
+    Compute::CsrMatrix<T> m_data;
+};
+}
+
+#endif
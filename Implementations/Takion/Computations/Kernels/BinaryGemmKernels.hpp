@@ -0,0 +1,120 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_BINARYGEMMKERNELS_HPP
+#define TAKION_COMPUTE_BINARYGEMMKERNELS_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/Kernels/GemmKernels.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//! GEMM of bit-packed signs written against Int32 traits VI and Float32
+//! traits VF of one instruction set
+//! Rows of A and B hold k signs packed into 64 bit words (see BinaryMatrix),
+//! so the dot product of row i of A and row j of B is
+//! k - 2 * (number of bits which differ), counted with VI::XorPopCount
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Smallest number of words worth splitting over threads
+constexpr std::size_t BinaryParallelWork = std::size_t(1) << 14;
+
+//! Number of rows of B sharing every load of a row of A
+constexpr std::size_t BinaryGemmNB = 4;
+
+//! Loads VI::Width int32 lanes of packed words, starting at lane and
+//! zero filled past size lanes
+//! Scalar traits load through memcpy, as their loads would read words
+//! through int lvalues
+template <typename VI>
+typename VI::Vector LoadWordLanes(const std::uint64_t* words,
+                                  std::size_t lane, std::size_t size)
+{
+    if constexpr (VI::Width == 1)
+    {
+        std::int32_t value;
+        std::memcpy(&value, reinterpret_cast<const char*>(words) + 4 * lane,
+                    sizeof(value));
+        return value;
+    }
+    else
+    {
+        const auto* ptr =
+            reinterpret_cast<const typename VI::Scalar*>(words) + lane;
+        return size < VI::Width ? VI::LoadPartial(ptr, size) : VI::Load(ptr);
+    }
+}
+
+//! Computes m x n product C = A * B^T of signs followed by epilogue, where
+//! A holds m rows and B holds n rows of numWords words with k signs each
+//! Pairs of rows are distributed over threads if parallel is true
+template <typename VI, typename VF>
+void BinaryGemmKernel(std::size_t m, std::size_t n, std::size_t k,
+                      const std::uint64_t* A, const std::uint64_t* B,
+                      std::size_t numWords, float* C, std::size_t ldc,
+                      bool parallel, const BinaryEpilogue& epilogue)
+{
+    const auto numLanes = 2 * numWords;
+    const auto numBlocksN = (n + BinaryGemmNB - 1) / BinaryGemmNB;
+    const auto numTasks = m * numBlocksN;
+    const bool parallelTasks =
+        parallel && numTasks > 1 && m * n * numWords >= BinaryParallelWork;
+
+#pragma omp parallel for schedule(static) default(shared) \
+    if (parallelTasks)
+    for (long taskIdx = 0; taskIdx < static_cast<long>(numTasks); ++taskIdx)
+    {
+        const auto row = static_cast<std::size_t>(taskIdx) / numBlocksN;
+        const auto col =
+            static_cast<std::size_t>(taskIdx) % numBlocksN * BinaryGemmNB;
+        const auto nb = std::min(BinaryGemmNB, n - col);
+        const auto* a = A + row * numWords;
+
+        typename VI::Vector acc[BinaryGemmNB];
+        for (std::size_t c = 0; c < BinaryGemmNB; ++c)
+            acc[c] = VI::Zero();
+
+        // Rows past nb reread the first row, so that the loop is unrolled
+        // for every block
+        const std::uint64_t* b[BinaryGemmNB];
+        for (std::size_t c = 0; c < BinaryGemmNB; ++c)
+            b[c] = B + (col + (c < nb ? c : 0)) * numWords;
+
+        for (std::size_t lane = 0; lane < numLanes; lane += VI::Width)
+        {
+            const auto size = std::min(VI::Width, numLanes - lane);
+            const auto va = LoadWordLanes<VI>(a, lane, size);
+            for (std::size_t c = 0; c < BinaryGemmNB; ++c)
+                acc[c] = VI::XorPopCount(
+                    acc[c], va, LoadWordLanes<VI>(b[c], lane, size));
+        }
+
+        auto* out = C + row * ldc + col;
+        for (std::size_t c = 0; c < nb; ++c)
+        {
+            alignas(64) std::int32_t counts[VI::Width];
+            VI::Store(counts, acc[c]);
+            std::int64_t count = 0;
+            for (std::size_t l = 0; l < VI::Width; ++l)
+                count += counts[l];
+
+            const auto dot = static_cast<std::int64_t>(k) - 2 * count;
+            auto value = epilogue.RowScale[row] *
+                         epilogue.ColumnScale[col + c] *
+                         static_cast<float>(dot);
+            if (epilogue.Bias)
+                value += epilogue.Bias[col + c];
+            out[c] = ActivateScalar<VF>(value, epilogue.Activation);
+        }
+    }
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
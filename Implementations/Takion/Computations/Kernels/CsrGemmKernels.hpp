@@ -0,0 +1,112 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_CSRGEMMKERNELS_HPP
+#define TAKION_COMPUTE_CSRGEMMKERNELS_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/Kernels/GemmKernels.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+//! Sparse x dense GEMM written against vector traits V of one instruction
+//! set. C = A * B where A is in compressed sparse row format and B is dense
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Smallest number of multiply-adds worth splitting over threads
+constexpr std::size_t CsrParallelWork = std::size_t(1) << 16;
+
+//! Computes m rows of C, row r from rows of B at columns[idx] scaled by
+//! values[idx] for idx from rowOffsets[r] to rowOffsets[r + 1] - 1
+//! Columns are split into chunks of four vectors like GemvRowKernel, so
+//! only the rows of B at non-zero elements of A are streamed through the
+//! accumulators. Rows without non-zero elements are set to the epilogue
+//! applied to zero. Rows are distributed over threads
+template <typename V>
+void CsrGemmKernel(std::size_t m, std::size_t n,
+                   const std::size_t* rowOffsets,
+                   const std::uint32_t* columns,
+                   const typename V::Scalar* values,
+                   const typename V::Scalar* B, std::size_t ldb,
+                   typename V::Scalar* C, std::size_t ldc, bool parallel,
+                   const GemmEpilogue<typename V::Scalar>& epilogue)
+{
+    constexpr auto chunkSize = 4 * V::Width;
+    const bool parallelRows =
+        parallel && m > 1 && (rowOffsets[m] - rowOffsets[0]) * n >=
+                                  CsrParallelWork;
+
+#pragma omp parallel for schedule(dynamic, 16) default(shared) \
+    if (parallelRows)
+    for (long row = 0; row < static_cast<long>(m); ++row)
+    {
+        const auto begin = rowOffsets[row];
+        const auto end = rowOffsets[row + 1];
+        auto* c = C + row * ldc;
+        const auto* bias = epilogue.Bias
+                               ? epilogue.Bias + row * epilogue.BiasRowStride
+                               : nullptr;
+
+        for (std::size_t col = 0; col < n; col += chunkSize)
+        {
+            const auto size = std::min(chunkSize, n - col);
+            const auto numVectors = (size + V::Width - 1) / V::Width;
+            typename V::Vector acc[4] = { V::Zero(), V::Zero(), V::Zero(),
+                                          V::Zero() };
+
+            if (size == chunkSize)
+            {
+                for (auto idx = begin; idx < end; ++idx)
+                {
+                    const auto value = V::Set1(values[idx]);
+                    const auto* b = B + columns[idx] * ldb + col;
+                    acc[0] = V::MulAdd(value, V::Load(b), acc[0]);
+                    acc[1] = V::MulAdd(value, V::Load(b + V::Width), acc[1]);
+                    acc[2] =
+                        V::MulAdd(value, V::Load(b + 2 * V::Width), acc[2]);
+                    acc[3] =
+                        V::MulAdd(value, V::Load(b + 3 * V::Width), acc[3]);
+                }
+            }
+            else
+            {
+                for (auto idx = begin; idx < end; ++idx)
+                {
+                    const auto value = V::Set1(values[idx]);
+                    const auto* b = B + columns[idx] * ldb + col;
+                    for (std::size_t v = 0; v < numVectors; ++v)
+                    {
+                        const auto width =
+                            std::min(V::Width, size - v * V::Width);
+                        const auto vec =
+                            width == V::Width
+                                ? V::Load(b + v * V::Width)
+                                : V::LoadPartial(b + v * V::Width, width);
+                        acc[v] = V::MulAdd(value, vec, acc[v]);
+                    }
+                }
+            }
+
+            for (std::size_t v = 0; v < numVectors; ++v)
+            {
+                const auto offset = col + v * V::Width;
+                StoreGemv<V>(acc[v], c + offset,
+                             bias ? bias + offset : nullptr,
+                             std::min(V::Width, n - offset), false, epilogue);
+            }
+        }
+
+        if (!IsVectorActivation<V>(epilogue.Activation))
+            for (std::size_t col = 0; col < n; ++col)
+                c[col] = ActivateScalar<V>(c[col], epilogue.Activation);
+    }
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
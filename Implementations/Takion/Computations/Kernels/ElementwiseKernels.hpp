@@ -0,0 +1,178 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_ELEMENTWISEKERNELS_HPP
+#define TAKION_COMPUTE_ELEMENTWISEKERNELS_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+//! Elementwise kernels written against vector traits V
+//! (see VectorAvx2.hpp for the interface)
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Number of elements processed by one OpenMP task
+constexpr std::size_t ElementwiseChunkSize = 16384;
+
+//! Calls function(batchIdx, begin, end) for chunks of every batch in parallel
+template <typename Function>
+void ParallelChunks(std::size_t size, std::size_t batchSize,
+                    Function function)
+{
+    const auto numChunks =
+        std::max(static_cast<std::size_t>(1),
+                 (size + ElementwiseChunkSize - 1) / ElementwiseChunkSize);
+    const auto numTasks = numChunks * batchSize;
+
+#pragma omp parallel for schedule(static) default(shared) if (numTasks > 1)
+    for (long taskIdx = 0; taskIdx < static_cast<long>(numTasks);
+         ++taskIdx)
+    {
+        const auto batchIdx = taskIdx / numChunks;
+        const auto begin = ElementwiseChunkSize * (taskIdx % numChunks);
+        const auto end = std::min(size, begin + ElementwiseChunkSize);
+        function(batchIdx, begin, end);
+    }
+}
+
+//! out = op(A, B) over batchSize blocks of size elements
+//! T may be a 16 bit storage type, which V loads as float lanes
+template <typename V, typename T, typename Op>
+void BinaryKernel(const T* A, const T* B, T* out, std::size_t size,
+                  std::size_t batchSize, std::size_t batchStrideA,
+                  std::size_t batchStrideB, Op op)
+{
+    ParallelChunks(size, batchSize, [&](std::size_t batchIdx,
+                                        std::size_t begin, std::size_t end) {
+        const auto* a = A + batchStrideA * batchIdx;
+        const auto* b = B + batchStrideB * batchIdx;
+        auto* dest = out + size * batchIdx;
+
+        auto i = begin;
+        for (; i + V::Width <= end; i += V::Width)
+            V::Store(dest + i, op(V::Load(a + i), V::Load(b + i)));
+        if (i < end)
+            V::StorePartial(dest + i,
+                            op(V::LoadPartial(a + i, end - i),
+                               V::LoadPartial(b + i, end - i)),
+                            end - i);
+    });
+}
+
+//! out = op(input) over batchSize blocks of size elements
+//! Input and output may have different storage types (see BinaryKernel)
+template <typename V, typename TIn, typename TOut, typename Op>
+void UnaryKernel(const TIn* input, TOut* out, std::size_t size,
+                 std::size_t batchSize, Op op)
+{
+    ParallelChunks(size, batchSize, [&](std::size_t batchIdx,
+                                        std::size_t begin, std::size_t end) {
+        const auto* src = input + size * batchIdx;
+        auto* dest = out + size * batchIdx;
+
+        auto i = begin;
+        for (; i + V::Width <= end; i += V::Width)
+            V::Store(dest + i, op(V::Load(src + i)));
+        if (i < end)
+            V::StorePartial(dest + i, op(V::LoadPartial(src + i, end - i)),
+                            end - i);
+    });
+}
+
+//! out = input converted to TOut for numRow rows of numCol elements
+//! Rows of input and out have lengths ldInput and ldOut, so that tensors
+//! padded for different element sizes can be converted
+template <typename V, typename TIn, typename TOut>
+void ConvertKernel(const TIn* input, TOut* out, std::size_t numRow,
+                   std::size_t numCol, std::size_t ldInput, std::size_t ldOut)
+{
+    ParallelChunks(numCol, numRow, [&](std::size_t rowIdx, std::size_t begin,
+                                       std::size_t end) {
+        const auto* src = input + ldInput * rowIdx;
+        auto* dest = out + ldOut * rowIdx;
+
+        auto i = begin;
+        for (; i + V::Width <= end; i += V::Width)
+            V::Store(dest + i, V::Load(src + i));
+        if (i < end)
+            V::StorePartial(dest + i, V::LoadPartial(src + i, end - i),
+                            end - i);
+    });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void AddKernel(const T* A, const T* B, T* out, std::size_t size,
+               std::size_t batchSize, std::size_t batchStrideA,
+               std::size_t batchStrideB)
+{
+    BinaryKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB,
+                    [](auto a, auto b) { return V::Add(a, b); });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void SubKernel(const T* A, const T* B, T* out, std::size_t size,
+               std::size_t batchSize, std::size_t batchStrideA,
+               std::size_t batchStrideB)
+{
+    BinaryKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB,
+                    [](auto a, auto b) { return V::Sub(a, b); });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void DotKernel(const T* A, const T* B, T* out, std::size_t size,
+               std::size_t batchSize, std::size_t batchStrideA,
+               std::size_t batchStrideB)
+{
+    BinaryKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB,
+                    [](auto a, auto b) { return V::Mul(a, b); });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void DivKernel(const T* A, const T* B, T* out, std::size_t size,
+               std::size_t batchSize, std::size_t batchStrideA,
+               std::size_t batchStrideB)
+{
+    BinaryKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB,
+                    [](auto a, auto b) { return V::Div(a, b); });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void ScalarMulKernel(const T* input, typename V::Scalar toMul, T* out,
+                     std::size_t size, std::size_t batchSize)
+{
+    const auto vecMul = V::Set1(toMul);
+    UnaryKernel<V>(input, out, size, batchSize,
+                   [vecMul](auto a) { return V::Mul(a, vecMul); });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void ScalarDivKernel(const T* input, typename V::Scalar toDiv, T* out,
+                     std::size_t size, std::size_t batchSize)
+{
+    const auto vecDiv = V::Set1(toDiv);
+    UnaryKernel<V>(input, out, size, batchSize,
+                   [vecDiv](auto a) { return V::Div(a, vecDiv); });
+}
+
+template <typename V, typename T = typename V::Scalar>
+void SetKernel(T* data, typename V::Scalar toSet, std::size_t size,
+               std::size_t batchSize)
+{
+    const auto vecSet = V::Set1(toSet);
+    ParallelChunks(size, batchSize, [&](std::size_t batchIdx,
+                                        std::size_t begin, std::size_t end) {
+        auto* dest = data + size * batchIdx;
+        auto i = begin;
+        for (; i + V::Width <= end; i += V::Width)
+            V::Store(dest + i, vecSet);
+        if (i < end)
+            V::StorePartial(dest + i, vecSet, end - i);
+    });
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
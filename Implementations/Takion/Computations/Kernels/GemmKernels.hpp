@@ -0,0 +1,570 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_GEMMKERNELS_HPP
+#define TAKION_COMPUTE_GEMMKERNELS_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/MathKernels.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+//! Packed panel GEMM written against vector traits V
+//! A is packed into MR row micro panels and B into NR = 2 * V::Width column
+//! micro panels which are multiplied by a register blocked MR x NR kernel
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Packs mc x kc block of A into MR row micro panels stored column by
+//! column. Rows past mc are zero filled
+//! A may be stored in a 16 bit type, which is converted while packing
+template <typename V, std::size_t MR, typename TA>
+void PackA(std::size_t mc, std::size_t kc, const TA* A,
+           std::size_t rowStride, std::size_t colStride,
+           typename V::Scalar* packed)
+{
+    using T = typename V::Scalar;
+
+    for (std::size_t ir = 0; ir < mc; ir += MR)
+    {
+        const auto mr = std::min(MR, mc - ir);
+        const TA* src = A + ir * rowStride;
+        for (std::size_t p = 0; p < kc; ++p)
+        {
+            for (std::size_t r = 0; r < mr; ++r)
+                packed[r] = static_cast<T>(src[r * rowStride + p * colStride]);
+            for (std::size_t r = mr; r < MR; ++r)
+                packed[r] = static_cast<T>(0);
+            packed += MR;
+        }
+    }
+}
+
+//! Packs kc x nr panel of B row by row into NR wide rows.
+//! Columns past nr are zero filled
+//! B may be stored in a 16 bit type, which is converted while packing
+template <typename V, typename TB>
+void PackBPanel(std::size_t kc, std::size_t nr, const TB* B,
+                std::size_t rowStride, std::size_t colStride,
+                typename V::Scalar* packed)
+{
+    using T = typename V::Scalar;
+    constexpr auto NR = 2 * V::Width;
+
+    if (rowStride == 1 && colStride != 1)
+    {
+        // Transposed B has contiguous columns, which are read one by one
+        // and scattered into the panel while it stays in L1
+        for (std::size_t c = 0; c < nr; ++c)
+        {
+            const TB* src = B + c * colStride;
+            for (std::size_t p = 0; p < kc; ++p)
+                packed[p * NR + c] = static_cast<T>(src[p]);
+        }
+        for (std::size_t p = 0; p < kc; ++p)
+            for (std::size_t c = nr; c < NR; ++c)
+                packed[p * NR + c] = static_cast<T>(0);
+        return;
+    }
+
+    for (std::size_t p = 0; p < kc; ++p)
+    {
+        const TB* src = B + p * rowStride;
+        if (nr == NR && colStride == 1)
+        {
+            V::Store(packed, V::Load(src));
+            V::Store(packed + V::Width, V::Load(src + V::Width));
+        }
+        else
+        {
+            for (std::size_t c = 0; c < nr; ++c)
+                packed[c] = static_cast<T>(src[c * colStride]);
+            for (std::size_t c = nr; c < NR; ++c)
+                packed[c] = static_cast<T>(0);
+        }
+        packed += NR;
+    }
+}
+
+//! Applies activation to a single value
+//! Takes vector traits although only the scalar type is used, so that every
+//! target region instantiates its own copy instead of sharing one symbol
+template <typename V>
+typename V::Scalar ActivateScalar(typename V::Scalar value,
+                                  ActivationType activation)
+{
+    using T = typename V::Scalar;
+    switch (activation)
+    {
+        case ActivationType::ReLU:
+            return value > static_cast<T>(0) ? value : static_cast<T>(0);
+        case ActivationType::LeakyReLU:
+            return value > static_cast<T>(0)
+                       ? value
+                       : static_cast<T>(LeakyReLUSlope * value);
+        case ActivationType::Sigmoid:
+            return static_cast<T>(static_cast<T>(1) / (1 + std::exp(-value)));
+        default:
+            return value;
+    }
+}
+
+//! Returns true if activation can be applied by Activate in registers
+template <typename V>
+bool IsVectorActivation(ActivationType activation)
+{
+    return activation == ActivationType::None ||
+           activation == ActivationType::ReLU ||
+           (activation == ActivationType::LeakyReLU &&
+            std::is_floating_point_v<typename V::Scalar>) ||
+           (activation == ActivationType::Sigmoid &&
+            std::is_same_v<typename V::Scalar, float>);
+}
+
+//! Applies activation to vec if IsVectorActivation is true for it,
+//! otherwise returns vec unchanged
+template <typename V>
+typename V::Vector Activate(typename V::Vector vec, ActivationType activation)
+{
+    if (activation == ActivationType::ReLU)
+        return V::Max(vec, V::Zero());
+    if constexpr (std::is_floating_point_v<typename V::Scalar>)
+    {
+        if (activation == ActivationType::LeakyReLU)
+            return LeakyReLU<V>(vec);
+        // Approximation of Sigmoid is only accurate to float precision
+        if constexpr (std::is_same_v<typename V::Scalar, float>)
+            if (activation == ActivationType::Sigmoid)
+                return Sigmoid<V>(vec);
+    }
+    return vec;
+}
+
+//! Computes MR x NR tile of C from packed micro panels of A and B
+//! 2 * MR accumulators stay in registers for the whole kc loop.
+//! Product is scaled by epilogue before it is stored. If lastBlock is true,
+//! bias (pointing at the bias of this tile, may be nullptr) and activation
+//! are applied as well
+template <typename V, std::size_t MR>
+void MicroKernel(std::size_t kc, const typename V::Scalar* a,
+                 const typename V::Scalar* b, typename V::Scalar* c,
+                 std::size_t ldc, bool accumulate,
+                 const GemmEpilogue<typename V::Scalar>& epilogue,
+                 const typename V::Scalar* bias, bool lastBlock)
+{
+    using T = typename V::Scalar;
+    constexpr auto NR = 2 * V::Width;
+
+    typename V::Vector low[MR];
+    typename V::Vector high[MR];
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        low[r] = V::Zero();
+        high[r] = V::Zero();
+    }
+
+    for (std::size_t p = 0; p < kc; ++p)
+    {
+        const auto b0 = V::Load(b);
+        const auto b1 = V::Load(b + V::Width);
+        for (std::size_t r = 0; r < MR; ++r)
+        {
+            const auto bc = V::Set1(a[r]);
+            low[r] = V::MulAdd(bc, b0, low[r]);
+            high[r] = V::MulAdd(bc, b1, high[r]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    const bool scale = epilogue.Scale != static_cast<T>(1);
+    const auto vecScale = V::Set1(epilogue.Scale);
+
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        auto* row = c + r * ldc;
+        if (scale)
+        {
+            low[r] = V::Mul(low[r], vecScale);
+            high[r] = V::Mul(high[r], vecScale);
+        }
+        if (accumulate)
+        {
+            low[r] = V::Add(low[r], V::Load(row));
+            high[r] = V::Add(high[r], V::Load(row + V::Width));
+        }
+        if (lastBlock)
+        {
+            if (bias)
+            {
+                const auto* biasRow = bias + r * epilogue.BiasRowStride;
+                low[r] = V::Add(low[r], V::Load(biasRow));
+                high[r] = V::Add(high[r], V::Load(biasRow + V::Width));
+            }
+            low[r] = Activate<V>(low[r], epilogue.Activation);
+            high[r] = Activate<V>(high[r], epilogue.Activation);
+        }
+        V::Store(row, low[r]);
+        V::Store(row + V::Width, high[r]);
+    }
+
+    // Remaining activations are applied while the tile is still in L1
+    if (lastBlock && !IsVectorActivation<V>(epilogue.Activation))
+        for (std::size_t r = 0; r < MR; ++r)
+            for (std::size_t col = 0; col < NR; ++col)
+                c[r * ldc + col] =
+                    ActivateScalar<V>(c[r * ldc + col], epilogue.Activation);
+}
+
+//! Multiplies packed mc x kc block of A with packed kc x nc block of B
+//! bias points at the bias of this block, or is nullptr if there is none
+//! Edge tiles are computed into a local tile and copied out partially
+template <typename V, std::size_t MR>
+void MacroKernel(std::size_t mc, std::size_t nc, std::size_t kc,
+                 const typename V::Scalar* packedA,
+                 const typename V::Scalar* packedB, typename V::Scalar* C,
+                 std::size_t ldc, bool accumulate,
+                 const GemmEpilogue<typename V::Scalar>& epilogue,
+                 const typename V::Scalar* bias, bool lastBlock)
+{
+    using T = typename V::Scalar;
+    constexpr auto NR = 2 * V::Width;
+    const auto biasStride = epilogue.BiasRowStride;
+
+    for (std::size_t jr = 0; jr < nc; jr += NR)
+    {
+        const auto nr = std::min(NR, nc - jr);
+        for (std::size_t ir = 0; ir < mc; ir += MR)
+        {
+            const auto mr = std::min(MR, mc - ir);
+            const T* a = packedA + ir * kc;
+            const T* b = packedB + jr * kc;
+            T* c = C + ir * ldc + jr;
+            const T* tileBias = bias ? bias + ir * biasStride + jr : nullptr;
+
+            if (mr == MR && nr == NR)
+            {
+                MicroKernel<V, MR>(kc, a, b, c, ldc, accumulate, epilogue,
+                                   tileBias, lastBlock);
+                continue;
+            }
+
+            alignas(64) T tile[MR * NR];
+            MicroKernel<V, MR>(kc, a, b, tile, NR, false, GemmEpilogue<T>(),
+                               nullptr, false);
+            for (std::size_t r = 0; r < mr; ++r)
+                for (std::size_t col = 0; col < nr; ++col)
+                {
+                    auto value = epilogue.Scale * tile[r * NR + col];
+                    if (accumulate)
+                        value += c[r * ldc + col];
+                    if (tileBias)
+                        value += tileBias[r * biasStride + col];
+                    if (lastBlock)
+                        value = ActivateScalar<V>(value, epilogue.Activation);
+                    c[r * ldc + col] = value;
+                }
+        }
+    }
+}
+
+//! Number of multiply-adds above which GEMV is split over threads. Smaller
+//! ones finish before threads would be woken up
+constexpr std::size_t GemvParallelWork = std::size_t(1) << 16;
+
+//! Applies epilogue of a single row to size (at most V::Width) elements of
+//! vec and stores them to c (see MicroKernel)
+//! bias points at the bias of these elements, or is nullptr
+template <typename V>
+void StoreGemv(typename V::Vector vec, typename V::Scalar* c,
+               const typename V::Scalar* bias, std::size_t size,
+               bool accumulate,
+               const GemmEpilogue<typename V::Scalar>& epilogue)
+{
+    using T = typename V::Scalar;
+    const bool full = size == V::Width;
+    if (epilogue.Scale != static_cast<T>(1))
+        vec = V::Mul(vec, V::Set1(epilogue.Scale));
+    if (accumulate)
+        vec = V::Add(vec, full ? V::Load(c) : V::LoadPartial(c, size));
+    if (bias)
+        vec = V::Add(vec, full ? V::Load(bias) : V::LoadPartial(bias, size));
+    vec = Activate<V>(vec, epilogue.Activation);
+    if (full)
+        V::Store(c, vec);
+    else
+        V::StorePartial(c, vec, size);
+}
+
+//! Computes single row c of n elements from row a of k elements, which are
+//! strideA apart, and B with contiguous rows of length ldb
+//! Columns are split into chunks of four vectors which are distributed over
+//! threads. Every chunk keeps four accumulators in registers while rows of
+//! B are streamed through, so every element of B is read once
+template <typename V>
+void GemvRowKernel(std::size_t n, std::size_t k, const typename V::Scalar* a,
+                   std::size_t strideA, const typename V::Scalar* B,
+                   std::size_t ldb, typename V::Scalar* c, bool accumulate,
+                   bool parallel,
+                   const GemmEpilogue<typename V::Scalar>& epilogue)
+{
+    constexpr auto chunkSize = 4 * V::Width;
+    const auto numChunks = (n + chunkSize - 1) / chunkSize;
+    const bool parallelChunks =
+        parallel && numChunks > 1 && n * k >= GemvParallelWork;
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelChunks)
+    for (long chunkIdx = 0; chunkIdx < static_cast<long>(numChunks);
+         ++chunkIdx)
+    {
+        const auto col = chunkSize * chunkIdx;
+        const auto size = std::min(chunkSize, n - col);
+        const auto numVectors = (size + V::Width - 1) / V::Width;
+        const auto* b = B + col;
+        typename V::Vector acc[4] = { V::Zero(), V::Zero(), V::Zero(),
+                                      V::Zero() };
+
+        if (size == chunkSize)
+        {
+            for (std::size_t p = 0; p < k; ++p)
+            {
+                const auto value = V::Set1(a[p * strideA]);
+                const auto* row = b + p * ldb;
+                acc[0] = V::MulAdd(value, V::Load(row), acc[0]);
+                acc[1] = V::MulAdd(value, V::Load(row + V::Width), acc[1]);
+                acc[2] =
+                    V::MulAdd(value, V::Load(row + 2 * V::Width), acc[2]);
+                acc[3] =
+                    V::MulAdd(value, V::Load(row + 3 * V::Width), acc[3]);
+            }
+        }
+        else
+        {
+            for (std::size_t p = 0; p < k; ++p)
+            {
+                const auto value = V::Set1(a[p * strideA]);
+                const auto* row = b + p * ldb;
+                for (std::size_t v = 0; v < numVectors; ++v)
+                {
+                    const auto width = std::min(V::Width, size - v * V::Width);
+                    const auto vec =
+                        width == V::Width
+                            ? V::Load(row + v * V::Width)
+                            : V::LoadPartial(row + v * V::Width, width);
+                    acc[v] = V::MulAdd(value, vec, acc[v]);
+                }
+            }
+        }
+
+        for (std::size_t v = 0; v < numVectors; ++v)
+        {
+            const auto offset = col + v * V::Width;
+            StoreGemv<V>(acc[v], c + offset,
+                         epilogue.Bias ? epilogue.Bias + offset : nullptr,
+                         std::min(V::Width, n - offset), accumulate,
+                         epilogue);
+        }
+    }
+
+    if (!IsVectorActivation<V>(epilogue.Activation))
+        for (std::size_t col = 0; col < n; ++col)
+            c[col] = ActivateScalar<V>(c[col], epilogue.Activation);
+}
+
+//! Computes single row c of n elements from contiguous row a of k elements
+//! and B whose columns are contiguous and ldb apart (transposed B)
+//! Every element of c is a dot product of a and a column of B, computed
+//! with four accumulators. Columns are distributed over threads
+template <typename V>
+void GemvColumnKernel(std::size_t n, std::size_t k,
+                      const typename V::Scalar* a,
+                      const typename V::Scalar* B, std::size_t ldb,
+                      typename V::Scalar* c, bool accumulate, bool parallel,
+                      const GemmEpilogue<typename V::Scalar>& epilogue)
+{
+    using T = typename V::Scalar;
+    const bool parallelColumns = parallel && n * k >= GemvParallelWork;
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelColumns)
+    for (long col = 0; col < static_cast<long>(n); ++col)
+    {
+        const auto* b = B + col * ldb;
+        auto acc0 = V::Zero(), acc1 = V::Zero(), acc2 = V::Zero(),
+             acc3 = V::Zero();
+
+        std::size_t p = 0;
+        for (; p + 4 * V::Width <= k; p += 4 * V::Width)
+        {
+            acc0 = V::MulAdd(V::Load(a + p), V::Load(b + p), acc0);
+            acc1 = V::MulAdd(V::Load(a + p + V::Width),
+                             V::Load(b + p + V::Width), acc1);
+            acc2 = V::MulAdd(V::Load(a + p + 2 * V::Width),
+                             V::Load(b + p + 2 * V::Width), acc2);
+            acc3 = V::MulAdd(V::Load(a + p + 3 * V::Width),
+                             V::Load(b + p + 3 * V::Width), acc3);
+        }
+        for (; p + V::Width <= k; p += V::Width)
+            acc0 = V::MulAdd(V::Load(a + p), V::Load(b + p), acc0);
+
+        alignas(64) T lanes[V::Width];
+        V::Store(lanes, V::Add(V::Add(acc0, acc1), V::Add(acc2, acc3)));
+        auto value = lanes[0];
+        for (std::size_t lane = 1; lane < V::Width; ++lane)
+            value += lanes[lane];
+        for (; p < k; ++p)
+            value += a[p] * b[p];
+
+        value *= epilogue.Scale;
+        if (accumulate)
+            value += c[col];
+        if (epilogue.Bias)
+            value += epilogue.Bias[col];
+        c[col] = ActivateScalar<V>(value, epilogue.Activation);
+    }
+}
+
+//! See PackedGemm in PackedGemm.hpp
+//! A and B may be stored in 16 bit types. They are converted to
+//! V::Scalar while they are packed, so products are accumulated in
+//! V::Scalar and C is always stored in it
+template <typename V, std::size_t MR, typename TA = typename V::Scalar,
+          typename TB = TA>
+void GemmKernel(std::size_t m, std::size_t n, std::size_t k, const TA* A,
+                std::size_t rowStrideA, std::size_t colStrideA, const TB* B,
+                std::size_t rowStrideB, std::size_t colStrideB,
+                typename V::Scalar* C, std::size_t ldc, bool accumulate,
+                bool parallel, const GemmEpilogue<typename V::Scalar>& epilogue,
+                const GemmBlocking& blocking)
+{
+    using T = typename V::Scalar;
+    constexpr auto NR = 2 * V::Width;
+    static_assert(GemmNC % NR == 0, "GemmNC should be a multiple of NR");
+    // Packed blocks are whole panels, so MC and NC are rounded to MR and NR
+    const auto blockM = std::max(blocking.MC / MR * MR, MR);
+    const auto blockK = std::max<std::size_t>(blocking.KC, 1);
+    const auto blockN = std::max(blocking.NC / NR * NR, NR);
+
+    if (m == 0 || n == 0)
+        return;
+
+    if (k == 0)
+    {
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                auto value = accumulate ? C[i * ldc + j] : static_cast<T>(0);
+                if (epilogue.Bias)
+                    value += epilogue.Bias[i * epilogue.BiasRowStride + j];
+                C[i * ldc + j] = ActivateScalar<V>(value, epilogue.Activation);
+            }
+        return;
+    }
+
+    // Single row would be packed only to be read once, so B is multiplied
+    // in place by GEMV kernels
+    if constexpr (std::is_same_v<TA, T> && std::is_same_v<TB, T>)
+    {
+        if (m == 1 && colStrideB == 1)
+        {
+            GemvRowKernel<V>(n, k, A, colStrideA, B, rowStrideB, C,
+                             accumulate, parallel, epilogue);
+            return;
+        }
+        if (m == 1 && rowStrideB == 1 && colStrideA == 1)
+        {
+            GemvColumnKernel<V>(n, k, A, B, colStrideB, C, accumulate,
+                                parallel, epilogue);
+            return;
+        }
+    }
+
+    const auto numThreads =
+        parallel ? static_cast<std::size_t>(omp_get_max_threads()) : 1;
+    const auto numBlocksM = (m + blockM - 1) / blockM;
+    auto* packedB = static_cast<T*>(GemmScratchBuffer(
+        1, sizeof(T) * std::min(blockK, k) *
+               ((std::min(blockN, n) + NR - 1) / NR * NR)));
+
+    for (std::size_t jc = 0; jc < n; jc += blockN)
+    {
+        const auto nc = std::min(blockN, n - jc);
+        const auto numPanelsN = (nc + NR - 1) / NR;
+
+        // Split columns into chunks of whole panels when there are not
+        // enough row blocks to keep every thread busy
+        const auto minChunks = (numThreads + numBlocksM - 1) / numBlocksM;
+        const auto panelsPerChunk =
+            (numPanelsN + std::min(numPanelsN, minChunks) - 1) /
+            std::min(numPanelsN, minChunks);
+        const auto numChunksN =
+            (numPanelsN + panelsPerChunk - 1) / panelsPerChunk;
+        const auto numTasks = numBlocksM * numChunksN;
+
+        for (std::size_t pc = 0; pc < k; pc += blockK)
+        {
+            const auto kc = std::min(blockK, k - pc);
+            const bool accumulateBlock = accumulate || pc > 0;
+            const bool lastBlock = pc + kc == k;
+
+#pragma omp parallel if (parallel && numThreads > 1) default(shared)
+            {
+#pragma omp for schedule(static)
+                for (long panelIdx = 0;
+                     panelIdx < static_cast<long>(numPanelsN);
+                     ++panelIdx)
+                {
+                    const auto jr = NR * panelIdx;
+                    PackBPanel<V>(kc, std::min(NR, nc - jr),
+                                  B + pc * rowStrideB + (jc + jr) * colStrideB,
+                                  rowStrideB, colStrideB, packedB + jr * kc);
+                }
+
+                auto* packedA = static_cast<T*>(
+                    GemmScratchBuffer(0, sizeof(T) * blockM * kc));
+                std::size_t packedBlock = numBlocksM;
+
+#pragma omp for schedule(static)
+                for (long taskIdx = 0;
+                     taskIdx < static_cast<long>(numTasks); ++taskIdx)
+                {
+                    const auto blockIdx = taskIdx / numChunksN;
+                    const auto chunkIdx = taskIdx % numChunksN;
+                    const auto ic = blockM * blockIdx;
+                    const auto mc = std::min(blockM, m - ic);
+
+                    if (packedBlock != static_cast<std::size_t>(blockIdx))
+                    {
+                        PackA<V, MR>(mc, kc,
+                                     A + ic * rowStrideA + pc * colStrideA,
+                                     rowStrideA, colStrideA, packedA);
+                        packedBlock = blockIdx;
+                    }
+
+                    const auto jBegin = NR * panelsPerChunk * chunkIdx;
+                    const auto jEnd =
+                        std::min(nc, jBegin + NR * panelsPerChunk);
+                    const T* bias =
+                        lastBlock && epilogue.Bias
+                            ? epilogue.Bias + ic * epilogue.BiasRowStride +
+                                  jc + jBegin
+                            : nullptr;
+                    MacroKernel<V, MR>(mc, jEnd - jBegin, kc, packedA,
+                                       packedB + jBegin * kc,
+                                       C + ic * ldc + jc + jBegin, ldc,
+                                       accumulateBlock, epilogue, bias,
+                                       lastBlock);
+                }
+            }
+        }
+    }
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
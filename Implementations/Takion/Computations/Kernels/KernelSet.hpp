@@ -0,0 +1,395 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_KERNELSET_HPP
+#define TAKION_COMPUTE_KERNELSET_HPP
+
+#include <Takion/Computations/Kernels/BinaryGemmKernels.hpp>
+#include <Takion/Computations/Kernels/CsrGemmKernels.hpp>
+#include <Takion/Computations/Kernels/ElementwiseKernels.hpp>
+#include <Takion/Computations/Kernels/GemmKernels.hpp>
+#include <Takion/Computations/Kernels/MathKernels.hpp>
+#include <Takion/Computations/Kernels/QuantizedGemmKernels.hpp>
+#include <Takion/Computations/Kernels/ReductionKernels.hpp>
+#include <Takion/Computations/Kernels/SparseGemmKernels.hpp>
+#include <Takion/Computations/Kernels/TransposeKernels.hpp>
+
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Returns function(value) computed by std:: functions
+template <typename V>
+typename V::Scalar MathScalar(typename V::Scalar value, MathFunction function)
+{
+    using T = typename V::Scalar;
+    switch (function)
+    {
+        case MathFunction::Exp:
+            return std::exp(value);
+        case MathFunction::Log:
+            return std::log(value);
+        case MathFunction::NegativeLog:
+            return -std::log(value);
+        case MathFunction::Tanh:
+            return std::tanh(value);
+        case MathFunction::Sigmoid:
+            return static_cast<T>(1) / (static_cast<T>(1) + std::exp(-value));
+        case MathFunction::Erf:
+            return std::erf(value);
+        case MathFunction::LeakyReLU:
+            return value > static_cast<T>(0)
+                       ? value
+                       : static_cast<T>(LeakyReLUSlope) * value;
+    }
+    return value;
+}
+
+//! out = function(input) with polynomials of MathKernels.hpp
+template <typename V, typename T>
+void VectorMathKernel(const T* input, T* out, std::size_t size,
+                      std::size_t batchSize, MathFunction function)
+{
+    switch (function)
+    {
+        case MathFunction::Exp:
+            UnaryKernel<V>(input, out, size, batchSize,
+                           [](auto a) { return Exp<V>(a); });
+            break;
+        case MathFunction::Log:
+            UnaryKernel<V>(input, out, size, batchSize,
+                           [](auto a) { return Log<V>(a); });
+            break;
+        case MathFunction::NegativeLog:
+            UnaryKernel<V>(input, out, size, batchSize, [](auto a) {
+                return V::Sub(V::Zero(), Log<V>(a));
+            });
+            break;
+        case MathFunction::Tanh:
+            UnaryKernel<V>(input, out, size, batchSize,
+                           [](auto a) { return Tanh<V>(a); });
+            break;
+        case MathFunction::Sigmoid:
+            UnaryKernel<V>(input, out, size, batchSize,
+                           [](auto a) { return Sigmoid<V>(a); });
+            break;
+        case MathFunction::Erf:
+            UnaryKernel<V>(input, out, size, batchSize,
+                           [](auto a) { return Erf<V>(a); });
+            break;
+        case MathFunction::LeakyReLU:
+            UnaryKernel<V>(input, out, size, batchSize,
+                           [](auto a) { return LeakyReLU<V>(a); });
+            break;
+    }
+}
+
+//! out = function(input) over batchSize blocks of size elements
+//! T may be a 16 bit storage type, which is computed in V::Scalar
+//! Polynomials of MathKernels.hpp are only accurate to float precision, so
+//! double is computed by std:: functions
+template <typename V, typename T>
+void MathKernel(const T* input, T* out, std::size_t size,
+                std::size_t batchSize, MathFunction function)
+{
+    if constexpr (std::is_same_v<typename V::Scalar, double>)
+    {
+        const auto total = size * batchSize;
+#pragma omp parallel for schedule(static) default(shared)
+        for (long idx = 0; idx < static_cast<long>(total); ++idx)
+            out[idx] = MathScalar<V>(input[idx], function);
+    }
+    else
+        VectorMathKernel<V>(input, out, size, batchSize, function);
+}
+
+//! Every kernel instantiated for vector traits V with MR row GEMM tiles
+//! Pass to MakeKernelTable outside of the target region to build the table
+template <typename V, std::size_t MR>
+struct KernelSet
+{
+    using Scalar = typename V::Scalar;
+
+    static void Gemm(std::size_t m, std::size_t n, std::size_t k,
+                     const Scalar* A, std::size_t rowStrideA,
+                     std::size_t colStrideA, const Scalar* B,
+                     std::size_t rowStrideB, std::size_t colStrideB,
+                     Scalar* C, std::size_t ldc, bool accumulate,
+                     bool parallel, const GemmEpilogue<Scalar>& epilogue,
+                     const GemmBlocking& blocking)
+    {
+        GemmKernel<V, MR>(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                          colStrideB, C, ldc, accumulate, parallel, epilogue,
+                          blocking);
+    }
+
+    static void Transpose(const Scalar* input, Scalar* output,
+                          std::size_t numRow, std::size_t numCol,
+                          std::size_t ldInput, std::size_t ldOutput,
+                          std::size_t numMatrices)
+    {
+        TransposeKernel<V>(input, output, numRow, numCol, ldInput, ldOutput,
+                           numMatrices);
+    }
+
+    static void ReduceSum(const Scalar* input, Scalar* output,
+                          std::size_t outer, std::size_t axisSize,
+                          std::size_t inner, std::size_t outerStride,
+                          std::size_t outputStride)
+    {
+        ReduceKernel<V, SumReduction<V>>(input, output, outer, axisSize,
+                                         inner, outerStride, outputStride);
+    }
+
+    static void ReduceMean(const Scalar* input, Scalar* output,
+                           std::size_t outer, std::size_t axisSize,
+                           std::size_t inner, std::size_t outerStride,
+                           std::size_t outputStride)
+    {
+        ReduceKernel<V, MeanReduction<V>>(input, output, outer, axisSize,
+                                          inner, outerStride, outputStride);
+    }
+
+    static void ReduceMax(const Scalar* input, Scalar* output,
+                          std::size_t outer, std::size_t axisSize,
+                          std::size_t inner, std::size_t outerStride,
+                          std::size_t outputStride)
+    {
+        ReduceKernel<V, MaxReduction<V>>(input, output, outer, axisSize,
+                                         inner, outerStride, outputStride);
+    }
+
+    static void ReduceMin(const Scalar* input, Scalar* output,
+                          std::size_t outer, std::size_t axisSize,
+                          std::size_t inner, std::size_t outerStride,
+                          std::size_t outputStride)
+    {
+        ReduceKernel<V, MinReduction<V>>(input, output, outer, axisSize,
+                                         inner, outerStride, outputStride);
+    }
+
+    static void Add(const Scalar* A, const Scalar* B, Scalar* out,
+                    std::size_t size, std::size_t batchSize,
+                    std::size_t batchStrideA, std::size_t batchStrideB)
+    {
+        AddKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void Sub(const Scalar* A, const Scalar* B, Scalar* out,
+                    std::size_t size, std::size_t batchSize,
+                    std::size_t batchStrideA, std::size_t batchStrideB)
+    {
+        SubKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void Dot(const Scalar* A, const Scalar* B, Scalar* out,
+                    std::size_t size, std::size_t batchSize,
+                    std::size_t batchStrideA, std::size_t batchStrideB)
+    {
+        DotKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void Div(const Scalar* A, const Scalar* B, Scalar* out,
+                    std::size_t size, std::size_t batchSize,
+                    std::size_t batchStrideA, std::size_t batchStrideB)
+    {
+        DivKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void ScalarMul(const Scalar* input, Scalar toMul, Scalar* out,
+                          std::size_t size, std::size_t batchSize)
+    {
+        ScalarMulKernel<V>(input, toMul, out, size, batchSize);
+    }
+
+    static void ScalarDiv(const Scalar* input, Scalar toDiv, Scalar* out,
+                          std::size_t size, std::size_t batchSize)
+    {
+        ScalarDivKernel<V>(input, toDiv, out, size, batchSize);
+    }
+
+    static void Set(Scalar* data, Scalar toSet, std::size_t size,
+                    std::size_t batchSize)
+    {
+        SetKernel<V>(data, toSet, size, batchSize);
+    }
+
+    //! Only instantiated for floating point vector traits
+    static void Math(const Scalar* input, Scalar* out, std::size_t size,
+                     std::size_t batchSize, MathFunction function)
+    {
+        MathKernel<V>(input, out, size, batchSize, function);
+    }
+
+    //! Only instantiated for floating point vector traits
+    static void CsrGemm(std::size_t m, std::size_t n,
+                        const std::size_t* rowOffsets,
+                        const std::uint32_t* columns, const Scalar* values,
+                        const Scalar* B, std::size_t ldb, Scalar* C,
+                        std::size_t ldc, bool parallel,
+                        const GemmEpilogue<Scalar>& epilogue)
+    {
+        CsrGemmKernel<V>(m, n, rowOffsets, columns, values, B, ldb, C, ldc,
+                         parallel, epilogue);
+    }
+
+    //! Only instantiated for Float32 vector traits
+    static void SparseGemm(std::size_t m, const float* A, std::size_t lda,
+                           const SparseMatrix& B, float* C, std::size_t ldc,
+                           bool parallel, const GemmEpilogue<float>& epilogue)
+    {
+        SparseGemmKernel<V>(m, A, lda, B, C, ldc, parallel, epilogue);
+    }
+};
+
+//! u8 x s8 GEMM, binary GEMM and quantization of float inputs instantiated
+//! for Int32 traits VI and Float32 traits VF
+//! Assign its members to KernelTable<int> outside of the target region
+template <typename VI, typename VF, std::size_t MR>
+struct QuantizedKernelSet
+{
+    static void Gemm(std::size_t m, std::size_t n, std::size_t k,
+                     const std::uint8_t* A, std::size_t lda,
+                     const std::int8_t* B, std::size_t ldb, std::int32_t* C,
+                     std::size_t ldc, bool parallel,
+                     const QuantizedEpilogue& epilogue)
+    {
+        QuantizedGemmKernel<VI, VF, MR>(m, n, k, A, lda, B, ldb, C, ldc,
+                                        parallel, epilogue);
+    }
+
+    static void Quantize(const float* input, std::uint8_t* out,
+                         std::size_t size, float scale,
+                         std::int32_t zeroPoint)
+    {
+        QuantizeKernel<VI, VF>(input, out, size, scale, zeroPoint);
+    }
+
+    static void BinaryGemm(std::size_t m, std::size_t n, std::size_t k,
+                           const std::uint64_t* A, const std::uint64_t* B,
+                           std::size_t numWords, float* C, std::size_t ldc,
+                           bool parallel, const BinaryEpilogue& epilogue)
+    {
+        BinaryGemmKernel<VI, VF>(m, n, k, A, B, numWords, C, ldc, parallel,
+                                 epilogue);
+    }
+};
+
+//! Kernels for 16 bit storage type T16 instantiated for Float32 traits V
+//! Pass to MakeHalfKernelTable outside of the target region and assign the
+//! table to KernelTable<float>
+template <typename V, std::size_t MR, typename T16>
+struct HalfKernelSet
+{
+    using Storage = T16;
+
+    static void Gemm(std::size_t m, std::size_t n, std::size_t k,
+                     const T16* A, std::size_t rowStrideA,
+                     std::size_t colStrideA, const T16* B,
+                     std::size_t rowStrideB, std::size_t colStrideB, float* C,
+                     std::size_t ldc, bool accumulate, bool parallel,
+                     const GemmEpilogue<float>& epilogue,
+                     const GemmBlocking& blocking)
+    {
+        GemmKernel<V, MR>(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                          colStrideB, C, ldc, accumulate, parallel, epilogue,
+                          blocking);
+    }
+
+    static void GemmFloatA(std::size_t m, std::size_t n, std::size_t k,
+                           const float* A, std::size_t rowStrideA,
+                           std::size_t colStrideA, const T16* B,
+                           std::size_t rowStrideB, std::size_t colStrideB,
+                           float* C, std::size_t ldc, bool accumulate,
+                           bool parallel, const GemmEpilogue<float>& epilogue,
+                           const GemmBlocking& blocking)
+    {
+        GemmKernel<V, MR>(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                          colStrideB, C, ldc, accumulate, parallel, epilogue,
+                          blocking);
+    }
+
+    static void GemmFloatB(std::size_t m, std::size_t n, std::size_t k,
+                           const T16* A, std::size_t rowStrideA,
+                           std::size_t colStrideA, const float* B,
+                           std::size_t rowStrideB, std::size_t colStrideB,
+                           float* C, std::size_t ldc, bool accumulate,
+                           bool parallel, const GemmEpilogue<float>& epilogue,
+                           const GemmBlocking& blocking)
+    {
+        GemmKernel<V, MR>(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                          colStrideB, C, ldc, accumulate, parallel, epilogue,
+                          blocking);
+    }
+
+    static void ToFloat(const T16* input, float* out, std::size_t numRow,
+                        std::size_t numCol, std::size_t ldInput,
+                        std::size_t ldOut)
+    {
+        ConvertKernel<V>(input, out, numRow, numCol, ldInput, ldOut);
+    }
+
+    static void FromFloat(const float* input, T16* out, std::size_t numRow,
+                          std::size_t numCol, std::size_t ldInput,
+                          std::size_t ldOut)
+    {
+        ConvertKernel<V>(input, out, numRow, numCol, ldInput, ldOut);
+    }
+
+    static void Add(const T16* A, const T16* B, T16* out, std::size_t size,
+                    std::size_t batchSize, std::size_t batchStrideA,
+                    std::size_t batchStrideB)
+    {
+        AddKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void Sub(const T16* A, const T16* B, T16* out, std::size_t size,
+                    std::size_t batchSize, std::size_t batchStrideA,
+                    std::size_t batchStrideB)
+    {
+        SubKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void Dot(const T16* A, const T16* B, T16* out, std::size_t size,
+                    std::size_t batchSize, std::size_t batchStrideA,
+                    std::size_t batchStrideB)
+    {
+        DotKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void Div(const T16* A, const T16* B, T16* out, std::size_t size,
+                    std::size_t batchSize, std::size_t batchStrideA,
+                    std::size_t batchStrideB)
+    {
+        DivKernel<V>(A, B, out, size, batchSize, batchStrideA, batchStrideB);
+    }
+
+    static void ScalarMul(const T16* input, float toMul, T16* out,
+                          std::size_t size, std::size_t batchSize)
+    {
+        ScalarMulKernel<V>(input, toMul, out, size, batchSize);
+    }
+
+    static void ScalarDiv(const T16* input, float toDiv, T16* out,
+                          std::size_t size, std::size_t batchSize)
+    {
+        ScalarDivKernel<V>(input, toDiv, out, size, batchSize);
+    }
+
+    static void Set(T16* data, float toSet, std::size_t size,
+                    std::size_t batchSize)
+    {
+        SetKernel<V>(data, toSet, size, batchSize);
+    }
+
+    static void Math(const T16* input, T16* out, std::size_t size,
+                     std::size_t batchSize, MathFunction function)
+    {
+        MathKernel<V>(input, out, size, batchSize, function);
+    }
+};
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
@@ -0,0 +1,214 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_MATHKERNELS_HPP
+#define TAKION_COMPUTE_MATHKERNELS_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <limits>
+
+//! Polynomial approximations of transcendental functions written against
+//! float vector traits V, so they are evaluated in registers instead of
+//! calling libm once per element
+//! Errors were measured against double precision libm over every float and
+//! are given in units in the last place (ULP) of the float result
+//! Infinities and NaN are handled like std:: functions
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Returns e^x (max error 1.3 ULP)
+//! x is split into n * ln(2) + r with |r| <= ln(2) / 2, e^r is evaluated
+//! by a degree 7 polynomial and multiplied by 2^n
+template <typename V>
+typename V::Vector Exp(typename V::Vector x)
+{
+    using T = typename V::Scalar;
+    // e^x rounds to zero below lowerBound and overflows above upperBound
+    const auto lowerBound = V::Set1(static_cast<T>(-103.972084f));
+    const auto upperBound = V::Set1(static_cast<T>(88.7228394f));
+
+    // Max and Min return their second operand if either operand is NaN, so
+    // NaN is kept by the clamp
+    const auto clamped = V::Min(upperBound, V::Max(lowerBound, x));
+    const auto n = V::Floor(V::MulAdd(
+        clamped, V::Set1(static_cast<T>(1.44269504088896341f)),
+        V::Set1(static_cast<T>(0.5f))));
+
+    // ln(2) is split into two constants, the first of which has few enough
+    // bits that n * 0.693359375 is exact
+    auto r = V::MulAdd(n, V::Set1(static_cast<T>(-0.693359375f)), clamped);
+    r = V::MulAdd(n, V::Set1(static_cast<T>(2.12194440e-4f)), r);
+
+    auto poly = V::Set1(static_cast<T>(1.9875691500e-4f));
+    poly = V::MulAdd(poly, r, V::Set1(static_cast<T>(1.3981999507e-3f)));
+    poly = V::MulAdd(poly, r, V::Set1(static_cast<T>(8.3334519073e-3f)));
+    poly = V::MulAdd(poly, r, V::Set1(static_cast<T>(4.1665795894e-2f)));
+    poly = V::MulAdd(poly, r, V::Set1(static_cast<T>(1.6666665459e-1f)));
+    poly = V::MulAdd(poly, r, V::Set1(static_cast<T>(5.0000001201e-1f)));
+    poly = V::MulAdd(poly, V::Mul(r, r),
+                     V::Add(r, V::Set1(static_cast<T>(1))));
+
+    // n lies in [-150, 128], so 2^n is built from two factors which are both
+    // normal numbers. Results below 2^-126 become subnormal in the multiply
+    const auto half = V::Floor(V::Mul(n, V::Set1(static_cast<T>(0.5f))));
+    const auto result =
+        V::Mul(V::Mul(poly, V::Pow2(half)), V::Pow2(V::Sub(n, half)));
+
+    return V::SelectLess(
+        upperBound, x, V::Set1(std::numeric_limits<T>::infinity()),
+        V::SelectLess(x, lowerBound, V::Zero(), result));
+}
+
+//! Returns natural logarithm of x (max error 0.9 ULP)
+//! x is split into m * 2^e with m in [sqrt(0.5), sqrt(2)) and log(m) is
+//! evaluated by a polynomial in m - 1
+template <typename V>
+typename V::Vector Log(typename V::Vector x)
+{
+    using T = typename V::Scalar;
+    const auto zero = V::Zero();
+    const auto one = V::Set1(static_cast<T>(1));
+
+    // Subnormal inputs are scaled by 2^23 so that their exponent field is
+    // not zero
+    const auto minNormal = V::Set1(std::numeric_limits<T>::min());
+    const auto scaled = V::SelectLess(
+        x, minNormal, V::Mul(x, V::Set1(static_cast<T>(8388608.0f))), x);
+    typename V::Vector exponent;
+    auto m = V::SplitExponent(scaled, exponent);
+    exponent = V::Sub(exponent, V::SelectLess(x, minNormal,
+                                              V::Set1(static_cast<T>(23)),
+                                              zero));
+
+    const auto sqrtHalf = V::Set1(static_cast<T>(0.707106781186547524f));
+    exponent = V::Sub(exponent, V::SelectLess(m, sqrtHalf, one, zero));
+    m = V::Sub(V::Add(m, V::SelectLess(m, sqrtHalf, m, zero)), one);
+
+    const auto z = V::Mul(m, m);
+    auto poly = V::Set1(static_cast<T>(7.0376836292e-2f));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(-1.1514610310e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(1.1676998740e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(-1.2420140846e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(1.4249322787e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(-1.6668057665e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(2.0000714765e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(-2.4999993993e-1f)));
+    poly = V::MulAdd(poly, m, V::Set1(static_cast<T>(3.3333331174e-1f)));
+    poly = V::Mul(V::Mul(poly, m), z);
+
+    // ln(2) * e is added in two parts like in Exp
+    poly = V::MulAdd(exponent, V::Set1(static_cast<T>(-2.12194440e-4f)), poly);
+    poly = V::MulAdd(z, V::Set1(static_cast<T>(-0.5f)), poly);
+    auto result = V::MulAdd(exponent, V::Set1(static_cast<T>(0.693359375f)),
+                            V::Add(m, poly));
+
+    // log(0) is -inf, log of negative numbers is NaN and inf or NaN are
+    // returned unchanged
+    result = V::SelectLess(zero, x, result,
+                           V::Set1(-std::numeric_limits<T>::infinity()));
+    result = V::SelectLess(x, zero,
+                           V::Set1(std::numeric_limits<T>::quiet_NaN()),
+                           result);
+    return V::SelectLess(x, V::Set1(std::numeric_limits<T>::infinity()),
+                         result, x);
+}
+
+//! Returns hyperbolic tangent of x (max error 1.4 ULP)
+//! Odd polynomial is used for |x| < 0.625 where 1 - 2 / (e^2|x| + 1) would
+//! lose precision to cancellation. Sign of x is restored afterwards
+template <typename V>
+typename V::Vector Tanh(typename V::Vector x)
+{
+    using T = typename V::Scalar;
+    const auto zero = V::Zero();
+    const auto one = V::Set1(static_cast<T>(1));
+
+    const auto z = V::Mul(x, x);
+    auto poly = V::Set1(static_cast<T>(-5.70498872745e-3f));
+    poly = V::MulAdd(poly, z, V::Set1(static_cast<T>(2.06390887954e-2f)));
+    poly = V::MulAdd(poly, z, V::Set1(static_cast<T>(-5.37397155531e-2f)));
+    poly = V::MulAdd(poly, z, V::Set1(static_cast<T>(1.33314422036e-1f)));
+    poly = V::MulAdd(poly, z, V::Set1(static_cast<T>(-3.33332819422e-1f)));
+    const auto small = V::MulAdd(V::Mul(poly, z), x, x);
+
+    const auto absX = V::Max(x, V::Sub(zero, x));
+    const auto large = V::Sub(
+        one, V::Div(V::Set1(static_cast<T>(2)),
+                    V::Add(Exp<V>(V::Add(absX, absX)), one)));
+
+    return V::SelectLess(
+        absX, V::Set1(static_cast<T>(0.625f)), small,
+        V::SelectLess(x, zero, V::Sub(zero, large), large));
+}
+
+//! Returns 1 / (1 + e^-x) (max error 3 ULP)
+//! e^-|x| is used so that it cannot overflow, and e^x / (1 + e^x) is
+//! returned for negative x
+template <typename V>
+typename V::Vector Sigmoid(typename V::Vector x)
+{
+    using T = typename V::Scalar;
+    const auto zero = V::Zero();
+    const auto one = V::Set1(static_cast<T>(1));
+
+    const auto absX = V::Max(x, V::Sub(zero, x));
+    const auto exp = Exp<V>(V::Sub(zero, absX));
+    const auto positive = V::Div(one, V::Add(one, exp));
+    return V::SelectLess(x, zero, V::Mul(exp, positive), positive);
+}
+
+//! Returns error function of x (max error 3.1 ULP)
+//! Taylor series is used for |x| < 0.5 and 1 - erfc(|x|) elsewhere, where
+//! erfc is approximated by t * e^(-x^2 + P(t)) with t = 1 / (1 + |x| / 2)
+//! (Numerical Recipes erfcc, relative error below 1.2e-7)
+template <typename V>
+typename V::Vector Erf(typename V::Vector x)
+{
+    using T = typename V::Scalar;
+    const auto one = V::Set1(static_cast<T>(1));
+    const auto absX = V::Max(x, V::Sub(V::Zero(), x));
+
+    // 2 / sqrt(pi) * sum of (-1)^n * x^(2n + 1) / (n! * (2n + 1))
+    const auto z = V::Mul(x, x);
+    auto series = V::Set1(static_cast<T>(1.2055657e-4f));
+    series = V::MulAdd(series, z, V::Set1(static_cast<T>(-8.5483270e-4f)));
+    series = V::MulAdd(series, z, V::Set1(static_cast<T>(5.2239776e-3f)));
+    series = V::MulAdd(series, z, V::Set1(static_cast<T>(-2.6866170e-2f)));
+    series = V::MulAdd(series, z, V::Set1(static_cast<T>(1.1283792e-1f)));
+    series = V::MulAdd(series, z, V::Set1(static_cast<T>(-3.7612639e-1f)));
+    series = V::MulAdd(series, z, V::Set1(static_cast<T>(1.1283792f)));
+    const auto small = V::Mul(series, x);
+
+    const auto t =
+        V::Div(one, V::MulAdd(absX, V::Set1(static_cast<T>(0.5f)), one));
+    auto poly = V::Set1(static_cast<T>(0.17087277f));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(-0.82215223f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(1.48851587f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(-1.13520398f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(0.27886807f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(-0.18628806f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(0.09678418f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(0.37409196f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(1.00002368f)));
+    poly = V::MulAdd(poly, t, V::Set1(static_cast<T>(-1.26551223f)));
+    const auto erfc = V::Mul(t, Exp<V>(V::Sub(poly, z)));
+    const auto large = V::Sub(one, erfc);
+
+    return V::SelectLess(
+        absX, V::Set1(static_cast<T>(0.5f)), small,
+        V::SelectLess(x, V::Zero(), V::Sub(V::Zero(), large), large));
+}
+
+//! Returns x if x > 0 and LeakyReLUSlope * x otherwise
+template <typename V>
+typename V::Vector LeakyReLU(typename V::Vector x)
+{
+    using T = typename V::Scalar;
+    return V::Max(x, V::Mul(x, V::Set1(static_cast<T>(LeakyReLUSlope))));
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
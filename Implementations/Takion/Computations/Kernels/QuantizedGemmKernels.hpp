@@ -0,0 +1,447 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_QUANTIZEDGEMMKERNELS_HPP
+#define TAKION_COMPUTE_QUANTIZEDGEMMKERNELS_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/GemmKernels.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+//! Packed panel u8 x s8 -> s32 GEMM written against Int32 traits VI and
+//! Float32 traits VF of one instruction set
+//! Every int32 lane of a packed panel holds four consecutive k of one row of
+//! A (or one column of B), so VI::MulAddBytes multiplies four k at once
+//! A is packed into MR row micro panels and B into NR = 2 * VI::Width column
+//! micro panels, like in GemmKernels.hpp
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Returns up to four bytes starting at src as one int32 lane (first byte in
+//! the lowest bits). Missing bytes are zero
+template <typename V, typename Byte>
+typename V::Scalar PackBytes(const Byte* src, std::size_t stride,
+                             std::size_t count)
+{
+    std::uint32_t bits = 0;
+    for (std::size_t q = 0; q < count; ++q)
+        bits |= static_cast<std::uint32_t>(
+                    static_cast<std::uint8_t>(src[q * stride]))
+                << (8 * q);
+    return static_cast<typename V::Scalar>(bits);
+}
+
+//! Packs mc x kc block of A into MR row micro panels of kc / 4 (rounded up)
+//! lanes per row. Rows past mc and k past kc are zero filled
+template <typename V, std::size_t MR>
+void PackQuantizedA(std::size_t mc, std::size_t kc, const std::uint8_t* A,
+                    std::size_t lda, typename V::Scalar* packed)
+{
+    for (std::size_t ir = 0; ir < mc; ir += MR)
+    {
+        const auto mr = std::min(MR, mc - ir);
+        const std::uint8_t* src = A + ir * lda;
+        for (std::size_t p = 0; p < kc; p += 4)
+        {
+            const auto count = std::min<std::size_t>(4, kc - p);
+            for (std::size_t r = 0; r < mr; ++r)
+                packed[r] = PackBytes<V>(src + r * lda + p, 1, count);
+            for (std::size_t r = mr; r < MR; ++r)
+                packed[r] = 0;
+            packed += MR;
+        }
+    }
+}
+
+//! Packs kc x nr panel of B into NR wide rows of four k each
+//! Columns past nr and k past kc are zero filled
+template <typename V>
+void PackQuantizedB(std::size_t kc, std::size_t nr, const std::int8_t* B,
+                    std::size_t ldb, typename V::Scalar* packed)
+{
+    constexpr auto NR = 2 * V::Width;
+
+    for (std::size_t p = 0; p < kc; p += 4)
+    {
+        const auto count = std::min<std::size_t>(4, kc - p);
+        const std::int8_t* src = B + p * ldb;
+        for (std::size_t c = 0; c < nr; ++c)
+            packed[c] = PackBytes<V>(src + c, ldb, count);
+        for (std::size_t c = nr; c < NR; ++c)
+            packed[c] = 0;
+        packed += NR;
+    }
+}
+
+//! Returns requantized value of accumulator acc in column col
+//! Takes vector traits so that every target region has its own copy
+template <typename VF>
+float RequantizeScalar(std::int32_t acc, std::size_t col,
+                       const QuantizedEpilogue& epilogue)
+{
+    if (epilogue.ZeroPointA != 0)
+        acc -= epilogue.ZeroPointA * epilogue.ColumnSumB[col];
+    auto value =
+        static_cast<float>(acc) * epilogue.Scale[col * epilogue.ScaleStride];
+    if (epilogue.Bias)
+        value += epilogue.Bias[col];
+    return ActivateScalar<VF>(value, epilogue.Activation);
+}
+
+//! Writes requantized value of accumulator acc at (row, col) of the output
+template <typename VF>
+void StoreRequantizedScalar(std::int32_t acc, std::size_t row,
+                            std::size_t col,
+                            const QuantizedEpilogue& epilogue)
+{
+    const auto value = RequantizeScalar<VF>(acc, col, epilogue);
+    if (epilogue.Output == QuantizedOutput::Float)
+    {
+        epilogue.FloatOut[row * epilogue.LdOut + col] = value;
+        return;
+    }
+
+    const auto quantized = std::min(
+        std::max(value * (1.0f / epilogue.OutputScale) +
+                     static_cast<float>(epilogue.OutputZeroPoint),
+                 0.0f),
+        255.0f);
+    epilogue.UInt8Out[row * epilogue.LdOut + col] =
+        static_cast<std::uint8_t>(std::nearbyint(quantized));
+}
+
+//! Returns clamp(round(value * inverseScale) + zeroPoint, 0, 255) as int32
+template <typename VF>
+auto QuantizeToUInt8(typename VF::Vector value,
+                     typename VF::Vector inverseScale,
+                     typename VF::Vector zeroPoint)
+{
+    return VF::RoundToInt32(VF::Min(
+        VF::Max(VF::Add(VF::Mul(value, inverseScale), zeroPoint), VF::Zero()),
+        VF::Set1(255.0f)));
+}
+
+//! Returns requantized vector of accumulators in columns starting at col
+template <typename VI, typename VF>
+typename VF::Vector Requantize(typename VI::Vector acc, std::size_t col,
+                               const QuantizedEpilogue& epilogue)
+{
+    if (epilogue.ZeroPointA != 0)
+        acc = VI::Sub(acc, VI::Mul(VI::Set1(epilogue.ZeroPointA),
+                                   VI::Load(epilogue.ColumnSumB + col)));
+    const auto scale = epilogue.ScaleStride == 0
+                           ? VF::Set1(epilogue.Scale[0])
+                           : VF::Load(epilogue.Scale + col);
+    auto value = VF::Mul(VF::ConvertInt32(acc), scale);
+    if (epilogue.Bias)
+        value = VF::Add(value, VF::Load(epilogue.Bias + col));
+    return Activate<VF>(value, epilogue.Activation);
+}
+
+//! Writes requantized NR wide row of accumulators at (row, col) of the
+//! output. Activations without vector implementation are applied per element
+template <typename VI, typename VF>
+void StoreRequantized(typename VI::Vector low, typename VI::Vector high,
+                      std::size_t row, std::size_t col,
+                      const QuantizedEpilogue& epilogue)
+{
+    constexpr auto NR = 2 * VI::Width;
+
+    if (!IsVectorActivation<VF>(epilogue.Activation))
+    {
+        alignas(64) std::int32_t acc[NR];
+        VI::Store(acc, low);
+        VI::Store(acc + VI::Width, high);
+        for (std::size_t c = 0; c < NR; ++c)
+            StoreRequantizedScalar<VF>(acc[c], row, col + c, epilogue);
+        return;
+    }
+
+    const auto valueLow = Requantize<VI, VF>(low, col, epilogue);
+    const auto valueHigh = Requantize<VI, VF>(high, col + VI::Width, epilogue);
+    if (epilogue.Output == QuantizedOutput::Float)
+    {
+        auto* out = epilogue.FloatOut + row * epilogue.LdOut + col;
+        VF::Store(out, valueLow);
+        VF::Store(out + VI::Width, valueHigh);
+        return;
+    }
+
+    const auto inverseScale = VF::Set1(1.0f / epilogue.OutputScale);
+    const auto zeroPoint =
+        VF::Set1(static_cast<float>(epilogue.OutputZeroPoint));
+
+    alignas(64) std::int32_t quantized[NR];
+    VI::Store(quantized,
+              QuantizeToUInt8<VF>(valueLow, inverseScale, zeroPoint));
+    VI::Store(quantized + VI::Width,
+              QuantizeToUInt8<VF>(valueHigh, inverseScale, zeroPoint));
+    auto* out = epilogue.UInt8Out + row * epilogue.LdOut + col;
+    for (std::size_t c = 0; c < NR; ++c)
+        out[c] = static_cast<std::uint8_t>(quantized[c]);
+}
+
+//! Computes MR x NR tile of accumulators from kGroups lanes of packed micro
+//! panels of A and B. Accumulators are added to C if accumulate is true
+//! If lastBlock is true and the epilogue requantizes, the tile is written to
+//! the output of the epilogue at (row, col) instead of C
+template <typename VI, typename VF, std::size_t MR>
+void QuantizedMicroKernel(std::size_t kGroups, const typename VI::Scalar* a,
+                          const typename VI::Scalar* b, std::int32_t* c,
+                          std::size_t ldc, bool accumulate,
+                          const QuantizedEpilogue& epilogue, std::size_t row,
+                          std::size_t col, bool lastBlock)
+{
+    constexpr auto NR = 2 * VI::Width;
+
+    typename VI::Vector low[MR];
+    typename VI::Vector high[MR];
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        low[r] = VI::Zero();
+        high[r] = VI::Zero();
+    }
+
+    for (std::size_t g = 0; g < kGroups; ++g)
+    {
+        const auto b0 = VI::Load(b);
+        const auto b1 = VI::Load(b + VI::Width);
+        for (std::size_t r = 0; r < MR; ++r)
+        {
+            const auto bc = VI::Set1(a[r]);
+            low[r] = VI::MulAddBytes(low[r], bc, b0);
+            high[r] = VI::MulAddBytes(high[r], bc, b1);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    const bool requantize =
+        lastBlock && epilogue.Output != QuantizedOutput::Int32;
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        auto* cRow = c + r * ldc;
+        if (accumulate)
+        {
+            low[r] = VI::Add(low[r], VI::Load(cRow));
+            high[r] = VI::Add(high[r], VI::Load(cRow + VI::Width));
+        }
+        if (requantize)
+        {
+            StoreRequantized<VI, VF>(low[r], high[r], row + r, col, epilogue);
+            continue;
+        }
+        VI::Store(cRow, low[r]);
+        VI::Store(cRow + VI::Width, high[r]);
+    }
+}
+
+//! Multiplies packed mc x kc block of A with packed kc x nc block of B
+//! Block starts at (row, col) of the product, which C points at
+//! Edge tiles are computed into a local tile and copied out partially
+template <typename VI, typename VF, std::size_t MR>
+void QuantizedMacroKernel(std::size_t mc, std::size_t nc, std::size_t kc,
+                          const typename VI::Scalar* packedA,
+                          const typename VI::Scalar* packedB, std::int32_t* C,
+                          std::size_t ldc, bool accumulate,
+                          const QuantizedEpilogue& epilogue, std::size_t row,
+                          std::size_t col, bool lastBlock)
+{
+    constexpr auto NR = 2 * VI::Width;
+    const auto kGroups = (kc + 3) / 4;
+    const bool requantize =
+        lastBlock && epilogue.Output != QuantizedOutput::Int32;
+
+    for (std::size_t jr = 0; jr < nc; jr += NR)
+    {
+        const auto nr = std::min(NR, nc - jr);
+        for (std::size_t ir = 0; ir < mc; ir += MR)
+        {
+            const auto mr = std::min(MR, mc - ir);
+            const auto* a = packedA + ir * kGroups;
+            const auto* b = packedB + jr * kGroups;
+            // C is only allocated if accumulators are kept between blocks
+            std::int32_t* c = C ? C + ir * ldc + jr : nullptr;
+
+            if (mr == MR && nr == NR)
+            {
+                QuantizedMicroKernel<VI, VF, MR>(kGroups, a, b, c, ldc,
+                                                 accumulate, epilogue,
+                                                 row + ir, col + jr,
+                                                 lastBlock);
+                continue;
+            }
+
+            alignas(64) std::int32_t tile[MR * NR];
+            QuantizedMicroKernel<VI, VF, MR>(kGroups, a, b, tile, NR, false,
+                                             epilogue, 0, 0, false);
+            for (std::size_t r = 0; r < mr; ++r)
+                for (std::size_t cIdx = 0; cIdx < nr; ++cIdx)
+                {
+                    auto value = tile[r * NR + cIdx];
+                    if (accumulate)
+                        value += c[r * ldc + cIdx];
+                    if (requantize)
+                        StoreRequantizedScalar<VF>(value, row + ir + r,
+                                                   col + jr + cIdx, epilogue);
+                    else
+                        c[r * ldc + cIdx] = value;
+                }
+        }
+    }
+}
+
+//! Computes m x n product of u8 A (row length lda) and s8 B (row length ldb)
+//! and applies epilogue to it. Accumulators are written to C (row length
+//! ldc) if the epilogue does not requantize them. Otherwise C only holds
+//! accumulators between blocks of k, and may be nullptr if k does not exceed
+//! QuantizedGemmKC
+//! If parallel is true, blocks of the product are distributed over OpenMP
+//! threads
+template <typename VI, typename VF, std::size_t MR>
+void QuantizedGemmKernel(std::size_t m, std::size_t n, std::size_t k,
+                         const std::uint8_t* A, std::size_t lda,
+                         const std::int8_t* B, std::size_t ldb,
+                         std::int32_t* C, std::size_t ldc, bool parallel,
+                         const QuantizedEpilogue& epilogue)
+{
+    using T = typename VI::Scalar;
+    constexpr auto NR = 2 * VI::Width;
+    static_assert(VI::Width == VF::Width,
+                  "Int32 and Float32 traits should have the same width");
+    static_assert(GemmNC % NR == 0, "GemmNC should be a multiple of NR");
+    static_assert(QuantizedGemmKC % 4 == 0,
+                  "QuantizedGemmKC should be a multiple of 4");
+
+    if (m == 0 || n == 0)
+        return;
+
+    const bool requantize = epilogue.Output != QuantizedOutput::Int32;
+    if (k == 0)
+    {
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                if (requantize)
+                    StoreRequantizedScalar<VF>(0, i, j, epilogue);
+                else
+                    C[i * ldc + j] = 0;
+        return;
+    }
+
+    const auto numThreads =
+        parallel ? static_cast<std::size_t>(omp_get_max_threads()) : 1;
+    const auto numBlocksM = (m + GemmMC - 1) / GemmMC;
+    const auto maxGroups = (std::min(QuantizedGemmKC, k) + 3) / 4;
+    auto* packedB = static_cast<T*>(GemmScratchBuffer(
+        1, sizeof(T) * maxGroups *
+               ((std::min(GemmNC, n) + NR - 1) / NR * NR)));
+
+    for (std::size_t jc = 0; jc < n; jc += GemmNC)
+    {
+        const auto nc = std::min(GemmNC, n - jc);
+        const auto numPanelsN = (nc + NR - 1) / NR;
+
+        // Split columns into chunks of whole panels when there are not
+        // enough row blocks to keep every thread busy
+        const auto minChunks = (numThreads + numBlocksM - 1) / numBlocksM;
+        const auto panelsPerChunk =
+            (numPanelsN + std::min(numPanelsN, minChunks) - 1) /
+            std::min(numPanelsN, minChunks);
+        const auto numChunksN =
+            (numPanelsN + panelsPerChunk - 1) / panelsPerChunk;
+        const auto numTasks = numBlocksM * numChunksN;
+
+        for (std::size_t pc = 0; pc < k; pc += QuantizedGemmKC)
+        {
+            const auto kc = std::min(QuantizedGemmKC, k - pc);
+            const auto kGroups = (kc + 3) / 4;
+            const bool accumulateBlock = pc > 0;
+            const bool lastBlock = pc + kc == k;
+
+#pragma omp parallel if (parallel && numThreads > 1) default(shared)
+            {
+#pragma omp for schedule(static)
+                for (long panelIdx = 0;
+                     panelIdx < static_cast<long>(numPanelsN);
+                     ++panelIdx)
+                {
+                    const auto jr = NR * panelIdx;
+                    PackQuantizedB<VI>(kc, std::min(NR, nc - jr),
+                                       B + pc * ldb + jc + jr, ldb,
+                                       packedB + jr * kGroups);
+                }
+
+                auto* packedA = static_cast<T*>(
+                    GemmScratchBuffer(0, sizeof(T) * GemmMC * kGroups));
+                std::size_t packedBlock = numBlocksM;
+
+#pragma omp for schedule(static)
+                for (long taskIdx = 0;
+                     taskIdx < static_cast<long>(numTasks); ++taskIdx)
+                {
+                    const auto blockIdx = taskIdx / numChunksN;
+                    const auto chunkIdx = taskIdx % numChunksN;
+                    const auto ic = GemmMC * blockIdx;
+                    const auto mc = std::min(GemmMC, m - ic);
+
+                    if (packedBlock != static_cast<std::size_t>(blockIdx))
+                    {
+                        PackQuantizedA<VI, MR>(mc, kc, A + ic * lda + pc, lda,
+                                               packedA);
+                        packedBlock = blockIdx;
+                    }
+
+                    const auto jBegin = NR * panelsPerChunk * chunkIdx;
+                    const auto jEnd =
+                        std::min(nc, jBegin + NR * panelsPerChunk);
+                    QuantizedMacroKernel<VI, VF, MR>(
+                        mc, jEnd - jBegin, kc, packedA,
+                        packedB + jBegin * kGroups,
+                        C ? C + ic * ldc + jc + jBegin : nullptr, ldc,
+                        accumulateBlock, epilogue, ic, jc + jBegin,
+                        lastBlock);
+                }
+            }
+        }
+    }
+}
+//! out = clamp(round(input / scale) + zeroPoint, 0, 255) for size values
+template <typename VI, typename VF>
+void QuantizeKernel(const float* input, std::uint8_t* out, std::size_t size,
+                    float scale, std::int32_t zeroPoint)
+{
+    const auto inverseScale = VF::Set1(1.0f / scale);
+    const auto zeroPointVector = VF::Set1(static_cast<float>(zeroPoint));
+
+    std::size_t idx = 0;
+    for (; idx + VI::Width <= size; idx += VI::Width)
+    {
+        alignas(64) std::int32_t quantized[VI::Width];
+        VI::Store(quantized, QuantizeToUInt8<VF>(VF::Load(input + idx),
+                                                 inverseScale,
+                                                 zeroPointVector));
+        for (std::size_t i = 0; i < VI::Width; ++i)
+            out[idx + i] = static_cast<std::uint8_t>(quantized[i]);
+    }
+
+    // NaN is mapped to 0 like V::Max does in the vector loop
+    for (; idx < size; ++idx)
+    {
+        const auto value = std::nearbyint(
+            input[idx] * (1.0f / scale) + static_cast<float>(zeroPoint));
+        out[idx] = static_cast<std::uint8_t>(
+            value > 0.0f ? std::min(value, 255.0f) : 0.0f);
+    }
+}
+
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
@@ -0,0 +1,256 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_REDUCTIONKERNELS_HPP
+#define TAKION_COMPUTE_REDUCTIONKERNELS_HPP
+
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+//! Axis reductions written against vector traits V
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Number of contiguous elements reduced together by one OpenMP task
+constexpr std::size_t ReductionBlockSize = 1024;
+
+//! Minimum number of elements given to one task when the reduced axis is
+//! split over threads
+constexpr std::size_t ReductionSplitSize = 16384;
+
+template <typename V>
+struct SumReduction
+{
+    using T = typename V::Scalar;
+
+    static T Identity()
+    {
+        return static_cast<T>(0);
+    }
+
+    static typename V::Vector Apply(typename V::Vector a,
+                                    typename V::Vector b)
+    {
+        return V::Add(a, b);
+    }
+
+    static T ApplyScalar(T a, T b)
+    {
+        return a + b;
+    }
+
+    static T Finalize(T value, std::size_t)
+    {
+        return value;
+    }
+};
+
+template <typename V>
+struct MeanReduction : SumReduction<V>
+{
+    using T = typename V::Scalar;
+
+    static T Finalize(T value, std::size_t count)
+    {
+        return value / static_cast<T>(count);
+    }
+};
+
+template <typename V>
+struct MaxReduction
+{
+    using T = typename V::Scalar;
+
+    static T Identity()
+    {
+        return std::numeric_limits<T>::lowest();
+    }
+
+    static typename V::Vector Apply(typename V::Vector a,
+                                    typename V::Vector b)
+    {
+        return V::Max(a, b);
+    }
+
+    static T ApplyScalar(T a, T b)
+    {
+        return std::max(a, b);
+    }
+
+    static T Finalize(T value, std::size_t)
+    {
+        return value;
+    }
+};
+
+template <typename V>
+struct MinReduction
+{
+    using T = typename V::Scalar;
+
+    static T Identity()
+    {
+        return std::numeric_limits<T>::max();
+    }
+
+    static typename V::Vector Apply(typename V::Vector a,
+                                    typename V::Vector b)
+    {
+        return V::Min(a, b);
+    }
+
+    static T ApplyScalar(T a, T b)
+    {
+        return std::min(a, b);
+    }
+
+    static T Finalize(T value, std::size_t)
+    {
+        return value;
+    }
+};
+
+//! Reduces size contiguous elements
+//! Four independent accumulators hide latency of Op, and lanes are combined
+//! once at the end
+template <typename V, typename Op>
+typename V::Scalar ReduceContiguous(const typename V::Scalar* src,
+                                    std::size_t size)
+{
+    using T = typename V::Scalar;
+    const auto identity = V::Set1(Op::Identity());
+    auto acc0 = identity, acc1 = identity, acc2 = identity, acc3 = identity;
+
+    std::size_t i = 0;
+    for (; i + 4 * V::Width <= size; i += 4 * V::Width)
+    {
+        acc0 = Op::Apply(acc0, V::Load(src + i));
+        acc1 = Op::Apply(acc1, V::Load(src + i + V::Width));
+        acc2 = Op::Apply(acc2, V::Load(src + i + 2 * V::Width));
+        acc3 = Op::Apply(acc3, V::Load(src + i + 3 * V::Width));
+    }
+    for (; i + V::Width <= size; i += V::Width)
+        acc0 = Op::Apply(acc0, V::Load(src + i));
+
+    alignas(64) T lanes[V::Width];
+    V::Store(lanes, Op::Apply(Op::Apply(acc0, acc1), Op::Apply(acc2, acc3)));
+
+    auto result = lanes[0];
+    for (std::size_t lane = 1; lane < V::Width; ++lane)
+        result = Op::ApplyScalar(result, lanes[lane]);
+    for (; i < size; ++i)
+        result = Op::ApplyScalar(result, src[i]);
+    return result;
+}
+
+//! Reduces rows [axisBegin, axisEnd) of length elements which are inner
+//! elements apart into acc, which stays in L1 while rows are streamed through
+template <typename V, typename Op>
+void ReduceRows(const typename V::Scalar* src, typename V::Scalar* acc,
+                std::size_t length, std::size_t inner, std::size_t axisBegin,
+                std::size_t axisEnd)
+{
+    std::fill(acc, acc + length, Op::Identity());
+
+    for (auto axisIdx = axisBegin; axisIdx < axisEnd; ++axisIdx)
+    {
+        const auto* row = src + inner * axisIdx;
+        std::size_t i = 0;
+        for (; i + V::Width <= length; i += V::Width)
+            V::Store(acc + i, Op::Apply(V::Load(acc + i), V::Load(row + i)));
+        if (i < length)
+            V::StorePartial(acc + i,
+                            Op::Apply(V::LoadPartial(acc + i, length - i),
+                                      V::LoadPartial(row + i, length - i)),
+                            length - i);
+    }
+}
+
+//! Reduces input viewed as outer x axisSize x inner array along the middle
+//! axis. Block o of input starts at o * outerStride, and element (o, j) of
+//! the result is written to output[o * outputStride + j]
+//! Work is distributed over (outer, block of inner) pairs. When there are
+//! fewer pairs than threads, the axis is also split, and partial results of
+//! the splits are combined afterwards
+template <typename V, typename Op>
+void ReduceKernel(const typename V::Scalar* input, typename V::Scalar* output,
+                  std::size_t outer, std::size_t axisSize, std::size_t inner,
+                  std::size_t outerStride, std::size_t outputStride)
+{
+    using T = typename V::Scalar;
+    constexpr auto blockSize = ReductionBlockSize;
+    const auto numBlocks = (inner + blockSize - 1) / blockSize;
+    const auto numWork = outer * numBlocks;
+    const auto numThreads = static_cast<std::size_t>(omp_get_max_threads());
+    const auto minSplit =
+        std::max(static_cast<std::size_t>(1),
+                 ReductionSplitSize / std::min(inner, blockSize));
+
+    std::size_t numSplits = 1;
+    if (numWork < numThreads)
+        numSplits = std::max(
+            static_cast<std::size_t>(1),
+            std::min((numThreads + numWork - 1) / numWork,
+                     axisSize / minSplit));
+    const auto splitSize = (axisSize + numSplits - 1) / numSplits;
+    const auto numTasks = numWork * numSplits;
+    auto* partials =
+        numSplits > 1 ? static_cast<T*>(ReductionScratchBuffer(
+                            1, sizeof(T) * numSplits * outer * inner))
+                      : nullptr;
+
+#pragma omp parallel for schedule(static) default(shared) if (numTasks > 1)
+    for (long taskIdx = 0; taskIdx < static_cast<long>(numTasks); ++taskIdx)
+    {
+        const auto splitIdx = taskIdx % numSplits;
+        const auto workIdx = taskIdx / numSplits;
+        const auto outerIdx = workIdx / numBlocks;
+        const auto begin = blockSize * (workIdx % numBlocks);
+        const auto length = std::min(blockSize, inner - begin);
+        const auto axisBegin = std::min(axisSize, splitSize * splitIdx);
+        const auto axisEnd = std::min(axisSize, axisBegin + splitSize);
+        const auto* src = input + outerStride * outerIdx + begin;
+        auto* dest = numSplits > 1
+                         ? partials +
+                           inner * (numSplits * outerIdx + splitIdx) + begin
+                         : output + outputStride * outerIdx + begin;
+
+        if (inner == 1)
+        {
+            const auto result = ReduceContiguous<V, Op>(
+                src + axisBegin, axisEnd - axisBegin);
+            *dest = numSplits > 1 ? result : Op::Finalize(result, axisSize);
+            continue;
+        }
+
+        alignas(64) T acc[blockSize];
+        ReduceRows<V, Op>(src, acc, length, inner, axisBegin, axisEnd);
+        for (std::size_t i = 0; i < length; ++i)
+            dest[i] = numSplits > 1 ? acc[i] : Op::Finalize(acc[i], axisSize);
+    }
+
+    if (numSplits == 1)
+        return;
+
+    for (std::size_t outerIdx = 0; outerIdx < outer; ++outerIdx)
+    {
+        const auto* partial = partials + inner * numSplits * outerIdx;
+        auto* dest = output + outputStride * outerIdx;
+        for (std::size_t i = 0; i < inner; ++i)
+        {
+            auto result = partial[i];
+            for (std::size_t splitIdx = 1; splitIdx < numSplits; ++splitIdx)
+                result = Op::ApplyScalar(result, partial[inner * splitIdx + i]);
+            dest[i] = Op::Finalize(result, axisSize);
+        }
+    }
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
@@ -0,0 +1,333 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_SPARSEGEMMKERNELS_HPP
+#define TAKION_COMPUTE_SPARSEGEMMKERNELS_HPP
+
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/GEMM/SparseGemm.hpp>
+#include <Takion/Computations/Kernels/GemmKernels.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! Dense x sparse GEMM written against Float32 traits V of one instruction
+//! set. C = A * B where A is dense and B is a SparseMatrix
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Largest number of rows of A multiplied with every block of B while it is
+//! in registers (see BlockSparseRowKernel)
+constexpr std::size_t SparseRows = 4;
+
+//! Smallest number of multiply-adds worth splitting over threads
+constexpr std::size_t SparseParallelWork = std::size_t(1) << 16;
+
+//! Applies epilogue to row c of n elements, which holds the product
+//! bias points at the bias of the row, or is nullptr
+template <typename V>
+void SparseEpilogue(float* c, std::size_t n, const float* bias,
+                    const GemmEpilogue<float>& epilogue)
+{
+    for (std::size_t col = 0; col < n; col += V::Width)
+    {
+        const auto size = std::min(V::Width, n - col);
+        const auto vec =
+            size == V::Width ? V::Load(c + col) : V::LoadPartial(c + col, size);
+        StoreGemv<V>(vec, c + col, bias ? bias + col : nullptr, size, false,
+                     epilogue);
+    }
+}
+
+//! Loads Lanes elements of ptr into the lower lanes of a vector
+template <typename V, std::size_t Lanes>
+typename V::Vector LoadLanes(const float* ptr)
+{
+    if constexpr (Lanes == V::Width)
+        return V::Load(ptr);
+    else
+        return V::LoadPartial(ptr, Lanes);
+}
+
+//! Copies numRows rows of k elements of A into k x V::Width panel, so that
+//! every lane of a vector of the panel belongs to one row. Lanes past
+//! numRows are zero
+template <typename V>
+void PackSparsePanel(std::size_t numRows, std::size_t k, const float* A,
+                     std::size_t lda, float* panel)
+{
+    constexpr auto W = V::Width;
+    for (std::size_t p = 0; p < k; ++p)
+    {
+        for (std::size_t r = 0; r < numRows; ++r)
+            panel[p * W + r] = A[r * lda + p];
+        for (std::size_t r = numRows; r < W; ++r)
+            panel[p * W + r] = 0.0f;
+    }
+}
+
+//! Returns sum of rows indices[begin] to indices[end - 1] of panel scaled
+//! by the corresponding values. Four sums hide latency of the
+//! multiply-adds
+template <typename V>
+typename V::Vector SparseColumnSum(const float* panel,
+                                   const std::uint32_t* indices,
+                                   const float* values, std::size_t begin,
+                                   std::size_t end)
+{
+    constexpr auto W = V::Width;
+    auto acc0 = V::Zero(), acc1 = V::Zero(), acc2 = V::Zero(),
+         acc3 = V::Zero();
+    auto idx = begin;
+    for (; idx + 4 <= end; idx += 4)
+    {
+        acc0 = V::MulAdd(V::Set1(values[idx]),
+                         V::Load(panel + indices[idx] * W), acc0);
+        acc1 = V::MulAdd(V::Set1(values[idx + 1]),
+                         V::Load(panel + indices[idx + 1] * W), acc1);
+        acc2 = V::MulAdd(V::Set1(values[idx + 2]),
+                         V::Load(panel + indices[idx + 2] * W), acc2);
+        acc3 = V::MulAdd(V::Set1(values[idx + 3]),
+                         V::Load(panel + indices[idx + 3] * W), acc3);
+    }
+    for (; idx < end; ++idx)
+        acc0 = V::MulAdd(V::Set1(values[idx]),
+                         V::Load(panel + indices[idx] * W), acc0);
+    return V::Add(V::Add(acc0, acc1), V::Add(acc2, acc3));
+}
+
+//! Computes C for V::Width rows of A at a time from blocks of BlockRows x
+//! BlockCols elements of B. Rows are packed into a panel (see
+//! PackSparsePanel), so every element of B is multiplied with all rows by
+//! one vector multiply-add, and every column of C is accumulated in its own
+//! vector (see SparseColumnSum for single elements)
+//! Column groups are distributed over threads
+template <typename V, std::size_t BlockRows, std::size_t BlockCols>
+void SparsePanelKernel(std::size_t m, const float* A, std::size_t lda,
+                       const SparseMatrix& B, float* C, std::size_t ldc,
+                       bool parallel, const GemmEpilogue<float>& epilogue)
+{
+    constexpr auto W = V::Width;
+    constexpr auto BlockSize = BlockRows * BlockCols;
+
+    const auto n = B.NumCol;
+    const auto k = B.NumRow;
+    const auto numGroups = (n + BlockCols - 1) / BlockCols;
+    const auto* offsets = B.Offsets.data();
+    const auto* indices = B.Indices.data();
+    const auto* values = B.Values.data();
+    const bool parallelGroups = parallel && numGroups > 1 &&
+                                std::min(m, W) * B.Values.size() >=
+                                    SparseParallelWork;
+
+    std::vector<float> buffer(k * W);
+    const auto* panel = buffer.data();
+    for (std::size_t row = 0; row < m; row += W)
+    {
+        const auto numRows = std::min(W, m - row);
+        PackSparsePanel<V>(numRows, k, A + row * lda, lda, buffer.data());
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelGroups)
+        for (long group = 0; group < static_cast<long>(numGroups); ++group)
+        {
+            const auto firstCol = group * BlockCols;
+            const auto numCols = std::min(BlockCols, n - firstCol);
+            alignas(64) float lanes[W];
+
+            if constexpr (BlockSize == 1)
+            {
+                V::Store(lanes, SparseColumnSum<V>(panel, indices, values,
+                                                   offsets[group],
+                                                   offsets[group + 1]));
+                for (std::size_t r = 0; r < numRows; ++r)
+                    C[(row + r) * ldc + firstCol] = lanes[r];
+                continue;
+            }
+
+            typename V::Vector acc[BlockCols];
+            for (std::size_t c = 0; c < BlockCols; ++c)
+                acc[c] = V::Zero();
+
+            for (auto idx = offsets[group]; idx < offsets[group + 1]; ++idx)
+            {
+                const auto p = static_cast<std::size_t>(indices[idx]);
+                const auto* block = values + idx * BlockSize;
+                // Rows of the last blocks past k are zero, and the panel
+                // has no rows beyond k
+                const auto blockRows = std::min(BlockRows, k - p);
+                for (std::size_t q = 0; q < blockRows; ++q)
+                {
+                    const auto a = V::Load(panel + (p + q) * W);
+                    for (std::size_t c = 0; c < BlockCols; ++c)
+                        acc[c] = V::MulAdd(V::Set1(block[q * BlockCols + c]),
+                                           a, acc[c]);
+                }
+            }
+
+            for (std::size_t c = 0; c < numCols; ++c)
+            {
+                V::Store(lanes, acc[c]);
+                for (std::size_t r = 0; r < numRows; ++r)
+                    C[(row + r) * ldc + firstCol + c] = lanes[r];
+            }
+        }
+
+        for (std::size_t r = 0; r < numRows; ++r)
+            SparseEpilogue<V>(
+                C + (row + r) * ldc, n,
+                epilogue.Bias
+                    ? epilogue.Bias + (row + r) * epilogue.BiasRowStride
+                    : nullptr,
+                epilogue);
+    }
+}
+
+//! Computes Rows rows of C from blocks of BlockRows x SparseBlockWidth
+//! elements of B, with lanes of vectors along columns of C. Every column
+//! group is accumulated in registers, and is stored once all of its blocks
+//! are added
+template <typename V, std::size_t BlockRows, std::size_t Rows>
+void BlockSparseRowKernel(const float* A, std::size_t lda,
+                          const SparseMatrix& B, float* C, std::size_t ldc,
+                          bool parallel, const GemmEpilogue<float>& epilogue,
+                          const float* bias)
+{
+    // Wider vectors hold a block row in their lower lanes
+    constexpr auto Lanes = std::min(V::Width, SparseBlockWidth);
+    constexpr auto NumVectors = SparseBlockWidth / Lanes;
+    constexpr auto BlockSize = BlockRows * SparseBlockWidth;
+
+    const auto n = B.NumCol;
+    const auto k = B.NumRow;
+    const auto numGroups = (n + SparseBlockWidth - 1) / SparseBlockWidth;
+    const auto* offsets = B.Offsets.data();
+    const auto* indices = B.Indices.data();
+    const auto* values = B.Values.data();
+    const bool parallelGroups = parallel && numGroups > 1 &&
+                                Rows * B.Values.size() >= SparseParallelWork;
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelGroups)
+    for (long group = 0; group < static_cast<long>(numGroups); ++group)
+    {
+        typename V::Vector acc[Rows][NumVectors];
+        for (std::size_t r = 0; r < Rows; ++r)
+            for (std::size_t v = 0; v < NumVectors; ++v)
+                acc[r][v] = V::Zero();
+
+        for (auto idx = offsets[group]; idx < offsets[group + 1]; ++idx)
+        {
+            const auto p = static_cast<std::size_t>(indices[idx]);
+            const auto* block = values + idx * BlockSize;
+            // Rows of the last blocks past k are zero, and A is not read
+            // beyond its rows
+            const auto blockRows = std::min(BlockRows, k - p);
+            for (std::size_t q = 0; q < blockRows; ++q)
+            {
+                typename V::Vector b[NumVectors];
+                for (std::size_t v = 0; v < NumVectors; ++v)
+                    b[v] = LoadLanes<V, Lanes>(block + q * SparseBlockWidth +
+                                               v * Lanes);
+                for (std::size_t r = 0; r < Rows; ++r)
+                {
+                    const auto value = V::Set1(A[r * lda + p + q]);
+                    for (std::size_t v = 0; v < NumVectors; ++v)
+                        acc[r][v] = V::MulAdd(value, b[v], acc[r][v]);
+                }
+            }
+        }
+
+        const auto firstCol = group * SparseBlockWidth;
+        for (std::size_t r = 0; r < Rows; ++r)
+            for (std::size_t v = 0; v < NumVectors; ++v)
+            {
+                const auto col = firstCol + v * Lanes;
+                if (col >= n)
+                    break;
+                StoreGemv<V>(acc[r][v], C + r * ldc + col,
+                             bias ? bias + r * epilogue.BiasRowStride + col
+                                  : nullptr,
+                             std::min(Lanes, n - col), false, epilogue);
+            }
+    }
+}
+
+//! Multiplies blocks of BlockRows x SparseBlockWidth elements of B
+//! Fewer rows than a block row of B are computed with lanes along columns
+//! (see BlockSparseRowKernel), which fills vectors of up to
+//! SparseBlockWidth lanes. Other rows are computed by SparsePanelKernel
+template <typename V, std::size_t BlockRows>
+void BlockSparseGemmKernel(std::size_t m, const float* A, std::size_t lda,
+                           const SparseMatrix& B, float* C, std::size_t ldc,
+                           bool parallel,
+                           const GemmEpilogue<float>& epilogue)
+{
+    if (m >= std::min(V::Width, SparseBlockWidth))
+    {
+        SparsePanelKernel<V, BlockRows, SparseBlockWidth>(
+            m, A, lda, B, C, ldc, parallel, epilogue);
+        return;
+    }
+
+    for (std::size_t row = 0; row < m; row += SparseRows)
+    {
+        const auto* a = A + row * lda;
+        auto* c = C + row * ldc;
+        const auto* bias =
+            epilogue.Bias ? epilogue.Bias + row * epilogue.BiasRowStride
+                          : nullptr;
+        switch (std::min(SparseRows, m - row))
+        {
+            case 1:
+                BlockSparseRowKernel<V, BlockRows, 1>(a, lda, B, c, ldc,
+                                                      parallel, epilogue,
+                                                      bias);
+                break;
+            case 2:
+                BlockSparseRowKernel<V, BlockRows, 2>(a, lda, B, c, ldc,
+                                                      parallel, epilogue,
+                                                      bias);
+                break;
+            case 3:
+                BlockSparseRowKernel<V, BlockRows, 3>(a, lda, B, c, ldc,
+                                                      parallel, epilogue,
+                                                      bias);
+                break;
+            default:
+                BlockSparseRowKernel<V, BlockRows, 4>(a, lda, B, c, ldc,
+                                                      parallel, epilogue,
+                                                      bias);
+                break;
+        }
+    }
+}
+
+//! See SparseMatrix in SparseGemm.hpp
+template <typename V>
+void SparseGemmKernel(std::size_t m, const float* A, std::size_t lda,
+                      const SparseMatrix& B, float* C, std::size_t ldc,
+                      bool parallel, const GemmEpilogue<float>& epilogue)
+{
+    switch (B.Format)
+    {
+        case SparseFormat::Csr:
+            SparsePanelKernel<V, 1, 1>(m, A, lda, B, C, ldc, parallel,
+                                       epilogue);
+            break;
+        case SparseFormat::Block1x8:
+            BlockSparseGemmKernel<V, 1>(m, A, lda, B, C, ldc, parallel,
+                                        epilogue);
+            break;
+        case SparseFormat::Block4x8:
+            BlockSparseGemmKernel<V, 4>(m, A, lda, B, C, ldc, parallel,
+                                        epilogue);
+            break;
+    }
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
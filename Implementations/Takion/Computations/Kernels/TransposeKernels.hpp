@@ -0,0 +1,70 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_TRANSPOSEKERNELS_HPP
+#define TAKION_COMPUTE_TRANSPOSEKERNELS_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+//! Matrix transpose written against vector traits V
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Kernels
+{
+//! Number of rows and columns of the tile handled by one OpenMP task
+//! Source and destination of a tile stay in L1 while it is transposed
+constexpr std::size_t TransposeTileSize = 64;
+
+//! Writes transpose of numMatrices numRow x numCol matrices of input to
+//! output. Rows of input have length ldInput and rows of output have length
+//! ldOutput, so padding of both is skipped
+//! Tiles of every matrix are distributed over threads, and each tile is
+//! transposed by V::Transpose in blocks of V::TransposeBlock
+template <typename V>
+void TransposeKernel(const typename V::Scalar* input,
+                     typename V::Scalar* output, std::size_t numRow,
+                     std::size_t numCol, std::size_t ldInput,
+                     std::size_t ldOutput, std::size_t numMatrices)
+{
+    constexpr auto block = V::TransposeBlock;
+    const auto numTilesRow =
+        (numRow + TransposeTileSize - 1) / TransposeTileSize;
+    const auto numTilesCol =
+        (numCol + TransposeTileSize - 1) / TransposeTileSize;
+    const auto tilesPerMatrix = numTilesRow * numTilesCol;
+    const auto numTasks = tilesPerMatrix * numMatrices;
+
+#pragma omp parallel for schedule(static) default(shared) if (numTasks > 1)
+    for (long taskIdx = 0; taskIdx < static_cast<long>(numTasks); ++taskIdx)
+    {
+        const auto matIdx = taskIdx / tilesPerMatrix;
+        const auto tileIdx = taskIdx % tilesPerMatrix;
+        const auto rowBegin = TransposeTileSize * (tileIdx / numTilesCol);
+        const auto colBegin = TransposeTileSize * (tileIdx % numTilesCol);
+        const auto rowEnd = std::min(numRow, rowBegin + TransposeTileSize);
+        const auto colEnd = std::min(numCol, colBegin + TransposeTileSize);
+        const auto* src = input + numRow * ldInput * matIdx;
+        auto* dest = output + numCol * ldOutput * matIdx;
+
+        for (auto i = rowBegin; i < rowEnd; i += block)
+            for (auto j = colBegin; j < colEnd; j += block)
+            {
+                if (i + block <= rowEnd && j + block <= colEnd)
+                {
+                    V::Transpose(src + i * ldInput + j, ldInput,
+                                 dest + j * ldOutput + i, ldOutput);
+                    continue;
+                }
+
+                for (auto r = i; r < std::min(i + block, rowEnd); ++r)
+                    for (auto c = j; c < std::min(j + block, colEnd); ++c)
+                        dest[c * ldOutput + r] = src[r * ldInput + c];
+            }
+    }
+}
+} // namespace Takion::Compute::CPU::Kernels
+
+#endif
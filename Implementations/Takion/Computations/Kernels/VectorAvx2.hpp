@@ -0,0 +1,480 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_VECTORAVX2_HPP
+#define TAKION_COMPUTE_VECTORAVX2_HPP
+
+#include <Takion/Utils/HalfPrecision.hpp>
+#include <immintrin.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+//! 256 bit vectors using AVX2, FMA and F16C
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Simd::Avx2
+{
+//! Returns mask selecting first size lanes
+inline __m256i LaneMask(std::size_t size)
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(size)),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+//! Returns mask selecting first size 64 bit lanes
+inline __m256i LaneMask64(std::size_t size)
+{
+    return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(size)),
+                              _mm256_setr_epi64x(0, 1, 2, 3));
+}
+
+struct Float32
+{
+    using Scalar = float;
+    using Vector = __m256;
+    static constexpr std::size_t Width = 8;
+
+    static Vector Zero()
+    {
+        return _mm256_setzero_ps();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm256_loadu_ps(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm256_storeu_ps(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        return _mm256_maskload_ps(ptr, LaneMask(size));
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        _mm256_maskstore_ps(ptr, LaneMask(size), vec);
+    }
+
+    //! 16 bit storage types are converted to float lanes on load and
+    //! rounded to nearest even on store
+    static Vector Load(const Float16* ptr)
+    {
+        return _mm256_cvtph_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+    }
+
+    static void Store(Float16* ptr, Vector vec)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr),
+                         _mm256_cvtps_ph(vec, _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    //! bfloat16 is the upper half of float
+    static Vector Load(const BFloat16* ptr)
+    {
+        return _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr))),
+            16));
+    }
+
+    //! Keeps NaN quiet. packus works within 128 bit lanes, so the packed
+    //! halves of both lanes are gathered before they are stored
+    static void Store(BFloat16* ptr, Vector vec)
+    {
+        const auto bits = _mm256_castps_si256(vec);
+        const auto rounded = _mm256_srli_epi32(
+            _mm256_add_epi32(
+                bits, _mm256_add_epi32(
+                          _mm256_set1_epi32(0x7fff),
+                          _mm256_and_si256(_mm256_srli_epi32(bits, 16),
+                                           _mm256_set1_epi32(1)))),
+            16);
+        const auto nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16),
+                                         _mm256_set1_epi32(0x40));
+        const auto result = _mm256_blendv_epi8(
+            rounded, nan,
+            _mm256_castps_si256(_mm256_cmp_ps(vec, vec, _CMP_UNORD_Q)));
+        const auto packed = _mm256_permute4x64_epi64(
+            _mm256_packus_epi32(result, result), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr),
+                         _mm256_castsi256_si128(packed));
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static Vector LoadPartial(const H* ptr, std::size_t size)
+    {
+        H buffer[Width] = {};
+        std::memcpy(buffer, ptr, size * sizeof(H));
+        return Load(buffer);
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static void StorePartial(H* ptr, Vector vec, std::size_t size)
+    {
+        H buffer[Width];
+        Store(buffer, vec);
+        std::memcpy(ptr, buffer, size * sizeof(H));
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm256_mul_ps(a, b);
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return _mm256_div_ps(a, b);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm256_fmadd_ps(a, b, c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm256_max_ps(a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    //! Rounds toward negative infinity
+    static Vector Floor(Vector a)
+    {
+        return _mm256_floor_ps(a);
+    }
+
+    //! Returns 2^n for integral n in [-126, 127]
+    static Vector Pow2(Vector n)
+    {
+        return _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)),
+            23));
+    }
+
+    //! Returns mantissa of positive normal a in [0.5, 1) and writes exponent
+    //! so that a = mantissa * 2^exponent
+    static Vector SplitExponent(Vector a, Vector& exponent)
+    {
+        const auto bits = _mm256_castps_si256(a);
+        exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(
+            _mm256_and_si256(_mm256_srli_epi32(bits, 23),
+                             _mm256_set1_epi32(0xff)),
+            _mm256_set1_epi32(126)));
+        return _mm256_castsi256_ps(_mm256_or_si256(
+            _mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+            _mm256_set1_epi32(0x3f000000)));
+    }
+
+    //! Returns ifLess where a < b and otherwise elsewhere
+    static Vector SelectLess(Vector a, Vector b, Vector ifLess,
+                             Vector otherwise)
+    {
+        return _mm256_blendv_ps(otherwise, ifLess,
+                                _mm256_cmp_ps(a, b, _CMP_LT_OQ));
+    }
+
+    static Vector ConvertInt32(__m256i a)
+    {
+        return _mm256_cvtepi32_ps(a);
+    }
+
+    //! Rounds to the nearest integer, ties to even
+    static __m256i RoundToInt32(Vector a)
+    {
+        return _mm256_cvtps_epi32(a);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 8;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Pairs of rows are interleaved, then 2 element and 128 bit lane
+    //! groups are exchanged, all in registers
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        Vector rows[8];
+        for (std::size_t r = 0; r < 8; ++r)
+            rows[r] = _mm256_loadu_ps(src + r * ldSrc);
+
+        Vector pairs[8];
+        for (std::size_t r = 0; r < 8; r += 2)
+        {
+            pairs[r] = _mm256_unpacklo_ps(rows[r], rows[r + 1]);
+            pairs[r + 1] = _mm256_unpackhi_ps(rows[r], rows[r + 1]);
+        }
+
+        Vector quads[8];
+        for (std::size_t r = 0; r < 8; r += 4)
+        {
+            quads[r] = _mm256_shuffle_ps(pairs[r], pairs[r + 2], 0x44);
+            quads[r + 1] = _mm256_shuffle_ps(pairs[r], pairs[r + 2], 0xEE);
+            quads[r + 2] = _mm256_shuffle_ps(pairs[r + 1], pairs[r + 3], 0x44);
+            quads[r + 3] = _mm256_shuffle_ps(pairs[r + 1], pairs[r + 3], 0xEE);
+        }
+
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            _mm256_storeu_ps(dst + c * ldDst,
+                             _mm256_permute2f128_ps(quads[c], quads[c + 4],
+                                                    0x20));
+            _mm256_storeu_ps(dst + (c + 4) * ldDst,
+                             _mm256_permute2f128_ps(quads[c], quads[c + 4],
+                                                    0x31));
+        }
+    }
+};
+
+struct Float64
+{
+    using Scalar = double;
+    using Vector = __m256d;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Zero()
+    {
+        return _mm256_setzero_pd();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm256_set1_pd(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm256_loadu_pd(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm256_storeu_pd(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        return _mm256_maskload_pd(ptr, LaneMask64(size));
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        _mm256_maskstore_pd(ptr, LaneMask64(size), vec);
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm256_sub_pd(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm256_mul_pd(a, b);
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return _mm256_div_pd(a, b);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm256_fmadd_pd(a, b, c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm256_max_pd(a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm256_min_pd(a, b);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 4;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Pairs of rows are interleaved, then 128 bit lanes are exchanged
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        Vector rows[4];
+        for (std::size_t r = 0; r < 4; ++r)
+            rows[r] = _mm256_loadu_pd(src + r * ldSrc);
+
+        const auto low01 = _mm256_unpacklo_pd(rows[0], rows[1]);
+        const auto high01 = _mm256_unpackhi_pd(rows[0], rows[1]);
+        const auto low23 = _mm256_unpacklo_pd(rows[2], rows[3]);
+        const auto high23 = _mm256_unpackhi_pd(rows[2], rows[3]);
+
+        _mm256_storeu_pd(dst, _mm256_permute2f128_pd(low01, low23, 0x20));
+        _mm256_storeu_pd(dst + ldDst,
+                         _mm256_permute2f128_pd(high01, high23, 0x20));
+        _mm256_storeu_pd(dst + 2 * ldDst,
+                         _mm256_permute2f128_pd(low01, low23, 0x31));
+        _mm256_storeu_pd(dst + 3 * ldDst,
+                         _mm256_permute2f128_pd(high01, high23, 0x31));
+    }
+};
+
+struct Int32
+{
+    using Scalar = int;
+    using Vector = __m256i;
+    static constexpr std::size_t Width = 8;
+
+    static Vector Zero()
+    {
+        return _mm256_setzero_si256();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm256_set1_epi32(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        return _mm256_maskload_epi32(ptr, LaneMask(size));
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        _mm256_maskstore_epi32(ptr, LaneMask(size), vec);
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm256_add_epi32(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm256_sub_epi32(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm256_mullo_epi32(a, b);
+    }
+
+    //! Divides in double precision, which is exact for 32 bit integers and
+    //! truncates toward zero like integer division
+    static Vector Div(Vector a, Vector b)
+    {
+        const auto low =
+            _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(a)),
+                          _mm256_cvtepi32_pd(_mm256_castsi256_si128(b)));
+        const auto high =
+            _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1)),
+                          _mm256_cvtepi32_pd(_mm256_extracti128_si256(b, 1)));
+        return _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm256_cvttpd_epi32(low)),
+            _mm256_cvttpd_epi32(high), 1);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm256_max_epi32(a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm256_min_epi32(a, b);
+    }
+
+    //! Adds products of the four unsigned bytes of a and the four signed
+    //! bytes of b in every lane to acc
+    //! Pairs of products are added with int16 saturation, so the result is
+    //! exact only while |b| <= 64 (see QuantizedWeightMax)
+    static Vector MulAddBytes(Vector acc, Vector a, Vector b)
+    {
+        return _mm256_add_epi32(
+            acc, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b),
+                                   _mm256_set1_epi16(1)));
+    }
+
+    //! Adds the number of bits which differ between a and b to acc
+    //! Bits are counted with a nibble lookup table (vpshufb) and summed per
+    //! 64 bits, so only the sum of every lane is meaningful
+    static Vector XorPopCount(Vector acc, Vector a, Vector b)
+    {
+        const auto table = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2,
+            2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const auto nibble = _mm256_set1_epi8(0x0f);
+        const auto bits = _mm256_xor_si256(a, b);
+        const auto counts = _mm256_add_epi8(
+            _mm256_shuffle_epi8(table, _mm256_and_si256(bits, nibble)),
+            _mm256_shuffle_epi8(
+                table, _mm256_and_si256(_mm256_srli_epi16(bits, 4), nibble)));
+        return _mm256_add_epi32(
+            acc, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = Float32::TransposeBlock;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Shuffles only move bits, so the float version is reused
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        Float32::Transpose(reinterpret_cast<const float*>(src), ldSrc,
+                           reinterpret_cast<float*>(dst), ldDst);
+    }
+};
+} // namespace Takion::Compute::CPU::Simd::Avx2
+
+#endif
@@ -0,0 +1,569 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_VECTORAVX512_HPP
+#define TAKION_COMPUTE_VECTORAVX512_HPP
+
+#include <Takion/Utils/HalfPrecision.hpp>
+#include <immintrin.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+//! 512 bit vectors using AVX-512F and AVX-512BW
+//! Tensors are only padded to 32 bytes, so every access is unaligned and
+//! tails are handled with masked loads and stores
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Simd::Avx512
+{
+//! Returns mask selecting first size lanes
+inline __mmask16 LaneMask(std::size_t size)
+{
+    return static_cast<__mmask16>((1u << size) - 1u);
+}
+
+struct Float32
+{
+    using Scalar = float;
+    using Vector = __m512;
+    static constexpr std::size_t Width = 16;
+
+    static Vector Zero()
+    {
+        return _mm512_setzero_ps();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm512_set1_ps(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm512_loadu_ps(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm512_storeu_ps(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        return _mm512_maskz_loadu_ps(LaneMask(size), ptr);
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        _mm512_mask_storeu_ps(ptr, LaneMask(size), vec);
+    }
+
+    //! 16 bit storage types are converted to float lanes on load and
+    //! rounded to nearest even on store
+    //! Masked forms avoid -Wmaybe-uninitialized inside of GCC headers
+    static Vector Load(const Float16* ptr)
+    {
+        return _mm512_maskz_cvtph_ps(
+            0xFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)));
+    }
+
+    static void Store(Float16* ptr, Vector vec)
+    {
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(ptr),
+            _mm512_maskz_cvtps_ph(0xFFFF, vec,
+                                  _MM_FROUND_TO_NEAREST_INT |
+                                      _MM_FROUND_NO_EXC));
+    }
+
+    //! bfloat16 is the upper half of float
+    static Vector Load(const BFloat16* ptr)
+    {
+        return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(
+            0xFFFF,
+            _mm512_maskz_cvtepu16_epi32(
+                0xFFFF,
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr))),
+            16));
+    }
+
+    //! Rounds with integer instructions, as AVX-512 BF16 is not part of the
+    //! AVX512 level. NaN is kept quiet
+    static void Store(BFloat16* ptr, Vector vec)
+    {
+        const auto bits = _mm512_castps_si512(vec);
+        const auto upper = _mm512_maskz_srli_epi32(0xFFFF, bits, 16);
+        const auto rounded = _mm512_maskz_srli_epi32(
+            0xFFFF,
+            _mm512_add_epi32(
+                bits, _mm512_add_epi32(
+                          _mm512_set1_epi32(0x7fff),
+                          _mm512_and_si512(upper, _mm512_set1_epi32(1)))),
+            16);
+        const auto result = _mm512_mask_blend_epi32(
+            _mm512_cmp_ps_mask(vec, vec, _CMP_UNORD_Q), rounded,
+            _mm512_or_si512(upper, _mm512_set1_epi32(0x40)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr),
+                            _mm512_maskz_cvtepi32_epi16(0xFFFF, result));
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static Vector LoadPartial(const H* ptr, std::size_t size)
+    {
+        H buffer[Width] = {};
+        std::memcpy(buffer, ptr, size * sizeof(H));
+        return Load(buffer);
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static void StorePartial(H* ptr, Vector vec, std::size_t size)
+    {
+        H buffer[Width];
+        Store(buffer, vec);
+        std::memcpy(ptr, buffer, size * sizeof(H));
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm512_add_ps(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm512_sub_ps(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm512_mul_ps(a, b);
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return _mm512_div_ps(a, b);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm512_fmadd_ps(a, b, c);
+    }
+
+    //! Masked forms of max and min avoid -Wmaybe-uninitialized inside of GCC
+    //! headers (see Int32::Div)
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm512_maskz_max_ps(0xFFFF, a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm512_maskz_min_ps(0xFFFF, a, b);
+    }
+
+    //! Rounds toward negative infinity
+    static Vector Floor(Vector a)
+    {
+        return _mm512_maskz_roundscale_ps(
+            0xFFFF, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    //! Returns 2^n for integral n in [-126, 127]
+    //! Shifts and conversions use masked forms like Max and Min
+    static Vector Pow2(Vector n)
+    {
+        const auto biased = _mm512_add_epi32(
+            _mm512_maskz_cvtps_epi32(0xFFFF, n), _mm512_set1_epi32(127));
+        return _mm512_castsi512_ps(
+            _mm512_maskz_slli_epi32(0xFFFF, biased, 23));
+    }
+
+    //! Returns mantissa of positive normal a in [0.5, 1) and writes exponent
+    //! so that a = mantissa * 2^exponent
+    static Vector SplitExponent(Vector a, Vector& exponent)
+    {
+        const auto bits = _mm512_castps_si512(a);
+        const auto biased =
+            _mm512_and_si512(_mm512_maskz_srli_epi32(0xFFFF, bits, 23),
+                             _mm512_set1_epi32(0xff));
+        exponent = _mm512_maskz_cvtepi32_ps(
+            0xFFFF, _mm512_sub_epi32(biased, _mm512_set1_epi32(126)));
+        return _mm512_castsi512_ps(_mm512_or_si512(
+            _mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff)),
+            _mm512_set1_epi32(0x3f000000)));
+    }
+
+    //! Returns ifLess where a < b and otherwise elsewhere
+    static Vector SelectLess(Vector a, Vector b, Vector ifLess,
+                             Vector otherwise)
+    {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ),
+                                    otherwise, ifLess);
+    }
+
+    static Vector ConvertInt32(__m512i a)
+    {
+        return _mm512_maskz_cvtepi32_ps(0xFFFF, a);
+    }
+
+    //! Rounds to the nearest integer, ties to even
+    static __m512i RoundToInt32(Vector a)
+    {
+        return _mm512_maskz_cvtps_epi32(0xFFFF, a);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 16;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Pairs of rows are interleaved, 2 element groups are exchanged and
+    //! 128 bit lanes are gathered in two steps, all in registers
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        constexpr __mmask16 all = 0xFFFF;
+        Vector rows[16];
+        Vector temp[16];
+        for (std::size_t r = 0; r < 16; ++r)
+            rows[r] = _mm512_loadu_ps(src + r * ldSrc);
+
+        for (std::size_t r = 0; r < 16; r += 2)
+        {
+            temp[r] = _mm512_maskz_unpacklo_ps(all, rows[r], rows[r + 1]);
+            temp[r + 1] = _mm512_maskz_unpackhi_ps(all, rows[r], rows[r + 1]);
+        }
+
+        for (std::size_t r = 0; r < 16; r += 4)
+        {
+            rows[r] = _mm512_maskz_shuffle_ps(all, temp[r], temp[r + 2], 0x44);
+            rows[r + 1] =
+                _mm512_maskz_shuffle_ps(all, temp[r], temp[r + 2], 0xEE);
+            rows[r + 2] =
+                _mm512_maskz_shuffle_ps(all, temp[r + 1], temp[r + 3], 0x44);
+            rows[r + 3] =
+                _mm512_maskz_shuffle_ps(all, temp[r + 1], temp[r + 3], 0xEE);
+        }
+
+        for (std::size_t r = 0; r < 16; r += 8)
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                temp[r + c] = _mm512_maskz_shuffle_f32x4(all, rows[r + c],
+                                                         rows[r + c + 4], 0x88);
+                temp[r + c + 4] = _mm512_maskz_shuffle_f32x4(
+                    all, rows[r + c], rows[r + c + 4], 0xDD);
+            }
+
+        for (std::size_t c = 0; c < 8; ++c)
+        {
+            _mm512_storeu_ps(dst + c * ldDst,
+                             _mm512_maskz_shuffle_f32x4(all, temp[c],
+                                                        temp[c + 8], 0x88));
+            _mm512_storeu_ps(dst + (c + 8) * ldDst,
+                             _mm512_maskz_shuffle_f32x4(all, temp[c],
+                                                        temp[c + 8], 0xDD));
+        }
+    }
+};
+
+struct Float64
+{
+    using Scalar = double;
+    using Vector = __m512d;
+    static constexpr std::size_t Width = 8;
+
+    static Vector Zero()
+    {
+        return _mm512_setzero_pd();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm512_set1_pd(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm512_loadu_pd(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm512_storeu_pd(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        return _mm512_maskz_loadu_pd(static_cast<__mmask8>(LaneMask(size)),
+                                     ptr);
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        _mm512_mask_storeu_pd(ptr, static_cast<__mmask8>(LaneMask(size)),
+                              vec);
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm512_add_pd(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm512_sub_pd(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm512_mul_pd(a, b);
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return _mm512_div_pd(a, b);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm512_fmadd_pd(a, b, c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm512_maskz_max_pd(0xFF, a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm512_maskz_min_pd(0xFF, a, b);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 8;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Pairs of rows are interleaved, then 128 bit lanes are gathered in two
+    //! steps, all in registers
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        constexpr __mmask8 all = 0xFF;
+        Vector rows[8];
+        Vector temp[8];
+        for (std::size_t r = 0; r < 8; ++r)
+            rows[r] = _mm512_loadu_pd(src + r * ldSrc);
+
+        // temp[r] holds even columns and temp[r + 1] odd columns of rows r
+        // and r + 1
+        for (std::size_t r = 0; r < 8; r += 2)
+        {
+            temp[r] = _mm512_maskz_unpacklo_pd(all, rows[r], rows[r + 1]);
+            temp[r + 1] = _mm512_maskz_unpackhi_pd(all, rows[r], rows[r + 1]);
+        }
+
+        // rows[4 * h + q] holds columns q and q + 4 (for even q, q + 1 and
+        // q + 5 for odd q) of rows 4h to 4h + 3
+        for (std::size_t h = 0; h < 2; ++h)
+            for (std::size_t parity = 0; parity < 2; ++parity)
+            {
+                const auto& a = temp[4 * h + parity];
+                const auto& b = temp[4 * h + parity + 2];
+                rows[4 * h + 2 * parity] =
+                    _mm512_maskz_shuffle_f64x2(all, a, b, 0x88);
+                rows[4 * h + 2 * parity + 1] =
+                    _mm512_maskz_shuffle_f64x2(all, a, b, 0xDD);
+            }
+
+        // Column of the first and the second half of each pair of results
+        constexpr std::size_t columns[4][2] = {
+            { 0, 4 }, { 2, 6 }, { 1, 5 }, { 3, 7 }
+        };
+        for (std::size_t q = 0; q < 4; ++q)
+        {
+            _mm512_storeu_pd(dst + columns[q][0] * ldDst,
+                             _mm512_maskz_shuffle_f64x2(all, rows[q],
+                                                        rows[q + 4], 0x88));
+            _mm512_storeu_pd(dst + columns[q][1] * ldDst,
+                             _mm512_maskz_shuffle_f64x2(all, rows[q],
+                                                        rows[q + 4], 0xDD));
+        }
+    }
+};
+
+struct Int32
+{
+    using Scalar = int;
+    using Vector = __m512i;
+    static constexpr std::size_t Width = 16;
+
+    static Vector Zero()
+    {
+        return _mm512_setzero_si512();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm512_set1_epi32(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm512_loadu_si512(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm512_storeu_si512(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        return _mm512_maskz_loadu_epi32(LaneMask(size), ptr);
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        _mm512_mask_storeu_epi32(ptr, LaneMask(size), vec);
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm512_add_epi32(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm512_sub_epi32(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm512_mullo_epi32(a, b);
+    }
+
+    //! Divides in double precision, which is exact for 32 bit integers and
+    //! truncates toward zero like integer division
+    //! Masked forms are used for every conversion because the unmasked ones
+    //! trip -Wmaybe-uninitialized inside of GCC headers
+    static Vector Div(Vector a, Vector b)
+    {
+        constexpr __mmask8 all = 0xFF;
+        const auto lowA = _mm512_maskz_extracti64x4_epi64(0xF, a, 0);
+        const auto lowB = _mm512_maskz_extracti64x4_epi64(0xF, b, 0);
+        const auto highA = _mm512_maskz_extracti64x4_epi64(0xF, a, 1);
+        const auto highB = _mm512_maskz_extracti64x4_epi64(0xF, b, 1);
+
+        const auto low = _mm512_maskz_cvttpd_epi32(
+            all, _mm512_div_pd(_mm512_maskz_cvtepi32_pd(all, lowA),
+                               _mm512_maskz_cvtepi32_pd(all, lowB)));
+        const auto high = _mm512_maskz_cvttpd_epi32(
+            all, _mm512_div_pd(_mm512_maskz_cvtepi32_pd(all, highA),
+                               _mm512_maskz_cvtepi32_pd(all, highB)));
+
+        const auto result =
+            _mm512_maskz_inserti64x4(0x0F, _mm512_setzero_si512(), low, 0);
+        return _mm512_mask_inserti64x4(result, 0xF0, result, high, 1);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm512_maskz_max_epi32(0xFFFF, a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm512_maskz_min_epi32(0xFFFF, a, b);
+    }
+
+    //! Adds products of the four unsigned bytes of a and the four signed
+    //! bytes of b in every lane to acc (AVX-512BW)
+    //! Pairs of products are added with int16 saturation, so the result is
+    //! exact only while |b| <= 64 (see QuantizedWeightMax)
+    static Vector MulAddBytes(Vector acc, Vector a, Vector b)
+    {
+        return _mm512_add_epi32(
+            acc, _mm512_madd_epi16(_mm512_maddubs_epi16(a, b),
+                                   _mm512_set1_epi16(1)));
+    }
+
+    //! Adds the number of bits which differ between a and b to acc
+    //! Bits are counted with a nibble lookup table (vpshufb of AVX-512BW)
+    //! and summed per 64 bits, so only the sum of every lane is meaningful
+    static Vector XorPopCount(Vector acc, Vector a, Vector b)
+    {
+        // Bit counts of nibbles 0 to 15 in every 128 bit lane
+        const auto table =
+            _mm512_set4_epi64(0x0403030203020201, 0x0302020102010100,
+                              0x0403030203020201, 0x0302020102010100);
+        const auto nibble = _mm512_set1_epi8(0x0f);
+        const auto bits = _mm512_xor_si512(a, b);
+        const auto counts = _mm512_add_epi8(
+            _mm512_shuffle_epi8(table, _mm512_and_si512(bits, nibble)),
+            _mm512_shuffle_epi8(
+                table, _mm512_and_si512(_mm512_srli_epi16(bits, 4), nibble)));
+        return _mm512_add_epi32(
+            acc, _mm512_sad_epu8(counts, _mm512_setzero_si512()));
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = Float32::TransposeBlock;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Shuffles only move bits, so the float version is reused
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        Float32::Transpose(reinterpret_cast<const float*>(src), ldSrc,
+                           reinterpret_cast<float*>(dst), ldDst);
+    }
+};
+
+//! Int32 traits for processors with AVX-512 VNNI, whose vpdpbusd adds
+//! products of bytes without intermediate saturation
+//! vpdpbusd is emitted with inline assembly, so the traits can live in the
+//! AVX-512 target region although the region does not enable VNNI. Kernels
+//! using them must only be selected if HasAvx512Vnni() is true
+struct Int32Vnni : Int32
+{
+    static Vector MulAddBytes(Vector acc, Vector a, Vector b)
+    {
+#ifdef _MSC_VER
+        return _mm512_dpbusd_epi32(acc, a, b);
+#else
+        asm("vpdpbusd %2, %1, %0" : "+v"(acc) : "v"(a), "v"(b));
+        return acc;
+#endif
+    }
+};
+
+//! Int32 traits for processors with AVX-512 VPOPCNTDQ, whose vpopcntq
+//! counts bits of every 64 bit lane at once
+//! vpopcntq is emitted with inline assembly like vpdpbusd of Int32Vnni.
+//! Kernels using them must only be selected if HasAvx512Vpopcntdq() is true
+struct Int32Vpopcntdq : Int32
+{
+    static Vector XorPopCount(Vector acc, Vector a, Vector b)
+    {
+        const auto bits = _mm512_xor_si512(a, b);
+#ifdef _MSC_VER
+        return _mm512_add_epi64(acc, _mm512_popcnt_epi64(bits));
+#else
+        Vector counts;
+        asm("vpopcntq %1, %0" : "=v"(counts) : "v"(bits));
+        return _mm512_add_epi64(acc, counts);
+#endif
+    }
+};
+} // namespace Takion::Compute::CPU::Simd::Avx512
+
+#endif
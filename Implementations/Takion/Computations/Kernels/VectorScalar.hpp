@@ -0,0 +1,201 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_VECTORSCALAR_HPP
+#define TAKION_COMPUTE_VECTORSCALAR_HPP
+
+#include <Takion/Utils/HalfPrecision.hpp>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+//! Single lane "vectors" for processors without SIMD extensions
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Simd::Scalar
+{
+template <typename T>
+struct ScalarVector
+{
+    using Scalar = T;
+    using Vector = T;
+    static constexpr std::size_t Width = 1;
+
+    static Vector Zero()
+    {
+        return static_cast<T>(0);
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return value;
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return *ptr;
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        *ptr = vec;
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t)
+    {
+        return *ptr;
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t)
+    {
+        *ptr = vec;
+    }
+
+    //! 16 bit storage types are converted on load and rounded to nearest
+    //! even on store
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static Vector Load(const H* ptr)
+    {
+        return static_cast<T>(static_cast<float>(*ptr));
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static void Store(H* ptr, Vector vec)
+    {
+        *ptr = H(static_cast<float>(vec));
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static Vector LoadPartial(const H* ptr, std::size_t)
+    {
+        return Load(ptr);
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static void StorePartial(H* ptr, Vector vec, std::size_t)
+    {
+        Store(ptr, vec);
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return a + b;
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return a - b;
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return a * b;
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return a / b;
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return a * b + c;
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return a > b ? a : b;
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return a < b ? a : b;
+    }
+
+    //! Rounds toward negative infinity
+    static Vector Floor(Vector a)
+    {
+        return std::floor(a);
+    }
+
+    //! Returns 2^n for integral n in [-126, 127]
+    static Vector Pow2(Vector n)
+    {
+        return std::ldexp(static_cast<T>(1), static_cast<int>(n));
+    }
+
+    //! Returns mantissa of positive normal a in [0.5, 1) and writes exponent
+    //! so that a = mantissa * 2^exponent
+    static Vector SplitExponent(Vector a, Vector& exponent)
+    {
+        int exp;
+        const auto mantissa = std::frexp(a, &exp);
+        exponent = static_cast<T>(exp);
+        return mantissa;
+    }
+
+    //! Returns ifLess where a < b and otherwise elsewhere
+    static Vector SelectLess(Vector a, Vector b, Vector ifLess,
+                             Vector otherwise)
+    {
+        return a < b ? ifLess : otherwise;
+    }
+
+    //! Converts int32 lanes to T
+    static Vector ConvertInt32(int a)
+    {
+        return static_cast<T>(a);
+    }
+
+    //! Rounds to the nearest integer, ties to even
+    static int RoundToInt32(Vector a)
+    {
+        return static_cast<int>(std::nearbyint(a));
+    }
+
+    //! Adds products of the four unsigned bytes of a and the four signed
+    //! bytes of b (lowest byte first) to acc
+    static Vector MulAddBytes(Vector acc, Vector a, Vector b)
+    {
+        const auto bitsA = static_cast<unsigned>(a);
+        const auto bitsB = static_cast<unsigned>(b);
+        for (unsigned shift = 0; shift < 32; shift += 8)
+            acc += static_cast<T>(
+                static_cast<int>((bitsA >> shift) & 0xffu) *
+                static_cast<int>(
+                    static_cast<signed char>((bitsB >> shift) & 0xffu)));
+        return acc;
+    }
+
+    //! Adds the number of bits which differ between a and b to acc
+    static Vector XorPopCount(Vector acc, Vector a, Vector b)
+    {
+        auto bits = static_cast<unsigned>(a) ^ static_cast<unsigned>(b);
+        bits = bits - ((bits >> 1) & 0x55555555u);
+        bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+        bits = (bits + (bits >> 4)) & 0x0f0f0f0fu;
+        return acc + static_cast<T>((bits * 0x01010101u) >> 24);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 4;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        for (std::size_t r = 0; r < TransposeBlock; ++r)
+            for (std::size_t c = 0; c < TransposeBlock; ++c)
+                dst[c * ldDst + r] = src[r * ldSrc + c];
+    }
+};
+
+using Float32 = ScalarVector<float>;
+using Float64 = ScalarVector<double>;
+using Int32 = ScalarVector<int>;
+} // namespace Takion::Compute::CPU::Simd::Scalar
+
+#endif
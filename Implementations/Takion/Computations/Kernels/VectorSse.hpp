@@ -0,0 +1,431 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_COMPUTE_VECTORSSE_HPP
+#define TAKION_COMPUTE_VECTORSSE_HPP
+
+#include <Takion/Utils/HalfPrecision.hpp>
+#include <immintrin.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+//! 128 bit vectors using SSE4.1
+//! Must be included inside of a target region (see TargetRegion.hpp)
+namespace Takion::Compute::CPU::Simd::Sse
+{
+struct Float32
+{
+    using Scalar = float;
+    using Vector = __m128;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Zero()
+    {
+        return _mm_setzero_ps();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm_set1_ps(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm_loadu_ps(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm_storeu_ps(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        alignas(16) Scalar buffer[Width] = {};
+        std::memcpy(buffer, ptr, size * sizeof(Scalar));
+        return _mm_load_ps(buffer);
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        alignas(16) Scalar buffer[Width];
+        _mm_store_ps(buffer, vec);
+        std::memcpy(ptr, buffer, size * sizeof(Scalar));
+    }
+
+    //! SSE4.1 has no half precision conversions, so Float16 is converted
+    //! one lane at a time
+    static Vector Load(const Float16* ptr)
+    {
+        alignas(16) Scalar buffer[Width];
+        for (std::size_t i = 0; i < Width; ++i)
+            buffer[i] = ptr[i];
+        return _mm_load_ps(buffer);
+    }
+
+    static void Store(Float16* ptr, Vector vec)
+    {
+        alignas(16) Scalar buffer[Width];
+        _mm_store_ps(buffer, vec);
+        for (std::size_t i = 0; i < Width; ++i)
+            ptr[i] = buffer[i];
+    }
+
+    //! bfloat16 is the upper half of float
+    static Vector Load(const BFloat16* ptr)
+    {
+        return _mm_castsi128_ps(_mm_unpacklo_epi16(
+            _mm_setzero_si128(),
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr))));
+    }
+
+    //! Rounds to nearest even, keeping NaN quiet
+    static void Store(BFloat16* ptr, Vector vec)
+    {
+        const auto bits = _mm_castps_si128(vec);
+        const auto rounded = _mm_srli_epi32(
+            _mm_add_epi32(bits, _mm_add_epi32(_mm_set1_epi32(0x7fff),
+                                              _mm_and_si128(
+                                                  _mm_srli_epi32(bits, 16),
+                                                  _mm_set1_epi32(1)))),
+            16);
+        const auto nan =
+            _mm_or_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x40));
+        const auto result = _mm_blendv_epi8(
+            rounded, nan, _mm_castps_si128(_mm_cmpunord_ps(vec, vec)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(ptr),
+                         _mm_packus_epi32(result, result));
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static Vector LoadPartial(const H* ptr, std::size_t size)
+    {
+        H buffer[Width] = {};
+        std::memcpy(buffer, ptr, size * sizeof(H));
+        return Load(buffer);
+    }
+
+    template <typename H, std::enable_if_t<IsHalfPrecisionV<H>, int> = 0>
+    static void StorePartial(H* ptr, Vector vec, std::size_t size)
+    {
+        H buffer[Width];
+        Store(buffer, vec);
+        std::memcpy(ptr, buffer, size * sizeof(H));
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm_mul_ps(a, b);
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return _mm_div_ps(a, b);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm_max_ps(a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm_min_ps(a, b);
+    }
+
+    //! Rounds toward negative infinity
+    static Vector Floor(Vector a)
+    {
+        return _mm_floor_ps(a);
+    }
+
+    //! Returns 2^n for integral n in [-126, 127]
+    static Vector Pow2(Vector n)
+    {
+        return _mm_castsi128_ps(_mm_slli_epi32(
+            _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23));
+    }
+
+    //! Returns mantissa of positive normal a in [0.5, 1) and writes exponent
+    //! so that a = mantissa * 2^exponent
+    static Vector SplitExponent(Vector a, Vector& exponent)
+    {
+        const auto bits = _mm_castps_si128(a);
+        exponent = _mm_cvtepi32_ps(_mm_sub_epi32(
+            _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff)),
+            _mm_set1_epi32(126)));
+        return _mm_castsi128_ps(
+            _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+                         _mm_set1_epi32(0x3f000000)));
+    }
+
+    //! Returns ifLess where a < b and otherwise elsewhere
+    static Vector SelectLess(Vector a, Vector b, Vector ifLess,
+                             Vector otherwise)
+    {
+        return _mm_blendv_ps(otherwise, ifLess, _mm_cmplt_ps(a, b));
+    }
+
+    static Vector ConvertInt32(__m128i a)
+    {
+        return _mm_cvtepi32_ps(a);
+    }
+
+    //! Rounds to the nearest integer, ties to even
+    static __m128i RoundToInt32(Vector a)
+    {
+        return _mm_cvtps_epi32(a);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 4;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        auto row0 = _mm_loadu_ps(src);
+        auto row1 = _mm_loadu_ps(src + ldSrc);
+        auto row2 = _mm_loadu_ps(src + 2 * ldSrc);
+        auto row3 = _mm_loadu_ps(src + 3 * ldSrc);
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+        _mm_storeu_ps(dst, row0);
+        _mm_storeu_ps(dst + ldDst, row1);
+        _mm_storeu_ps(dst + 2 * ldDst, row2);
+        _mm_storeu_ps(dst + 3 * ldDst, row3);
+    }
+};
+
+struct Float64
+{
+    using Scalar = double;
+    using Vector = __m128d;
+    static constexpr std::size_t Width = 2;
+
+    static Vector Zero()
+    {
+        return _mm_setzero_pd();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm_set1_pd(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm_loadu_pd(ptr);
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm_storeu_pd(ptr, vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        alignas(16) Scalar buffer[Width] = {};
+        std::memcpy(buffer, ptr, size * sizeof(Scalar));
+        return _mm_load_pd(buffer);
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        alignas(16) Scalar buffer[Width];
+        _mm_store_pd(buffer, vec);
+        std::memcpy(ptr, buffer, size * sizeof(Scalar));
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm_add_pd(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm_sub_pd(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm_mul_pd(a, b);
+    }
+
+    static Vector Div(Vector a, Vector b)
+    {
+        return _mm_div_pd(a, b);
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm_add_pd(_mm_mul_pd(a, b), c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm_max_pd(a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm_min_pd(a, b);
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = 2;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        const auto row0 = _mm_loadu_pd(src);
+        const auto row1 = _mm_loadu_pd(src + ldSrc);
+        _mm_storeu_pd(dst, _mm_unpacklo_pd(row0, row1));
+        _mm_storeu_pd(dst + ldDst, _mm_unpackhi_pd(row0, row1));
+    }
+};
+
+struct Int32
+{
+    using Scalar = int;
+    using Vector = __m128i;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Zero()
+    {
+        return _mm_setzero_si128();
+    }
+
+    static Vector Set1(Scalar value)
+    {
+        return _mm_set1_epi32(value);
+    }
+
+    static Vector Load(const Scalar* ptr)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    }
+
+    static void Store(Scalar* ptr, Vector vec)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), vec);
+    }
+
+    static Vector LoadPartial(const Scalar* ptr, std::size_t size)
+    {
+        alignas(16) Scalar buffer[Width] = {};
+        std::memcpy(buffer, ptr, size * sizeof(Scalar));
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(buffer));
+    }
+
+    static void StorePartial(Scalar* ptr, Vector vec, std::size_t size)
+    {
+        alignas(16) Scalar buffer[Width];
+        _mm_store_si128(reinterpret_cast<__m128i*>(buffer), vec);
+        std::memcpy(ptr, buffer, size * sizeof(Scalar));
+    }
+
+    static Vector Add(Vector a, Vector b)
+    {
+        return _mm_add_epi32(a, b);
+    }
+
+    static Vector Sub(Vector a, Vector b)
+    {
+        return _mm_sub_epi32(a, b);
+    }
+
+    static Vector Mul(Vector a, Vector b)
+    {
+        return _mm_mullo_epi32(a, b);
+    }
+
+    //! Divides in double precision, which is exact for 32 bit integers and
+    //! truncates toward zero like integer division
+    static Vector Div(Vector a, Vector b)
+    {
+        const auto low = _mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b));
+        const auto high = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(a, 8)),
+                                     _mm_cvtepi32_pd(_mm_srli_si128(b, 8)));
+        return _mm_unpacklo_epi64(_mm_cvttpd_epi32(low),
+                                  _mm_cvttpd_epi32(high));
+    }
+
+    //! Returns a * b + c
+    static Vector MulAdd(Vector a, Vector b, Vector c)
+    {
+        return _mm_add_epi32(_mm_mullo_epi32(a, b), c);
+    }
+
+    static Vector Max(Vector a, Vector b)
+    {
+        return _mm_max_epi32(a, b);
+    }
+
+    static Vector Min(Vector a, Vector b)
+    {
+        return _mm_min_epi32(a, b);
+    }
+
+    //! Adds products of the four unsigned bytes of a and the four signed
+    //! bytes of b in every lane to acc
+    //! Pairs of products are added with int16 saturation, so the result is
+    //! exact only while |b| <= 64 (see QuantizedWeightMax)
+    static Vector MulAddBytes(Vector acc, Vector a, Vector b)
+    {
+        return _mm_add_epi32(
+            acc, _mm_madd_epi16(_mm_maddubs_epi16(a, b), _mm_set1_epi16(1)));
+    }
+
+    //! Adds the number of bits which differ between a and b to acc
+    //! Bits are counted with a nibble lookup table (pshufb) and summed per
+    //! 64 bits, so only the sum of every lane is meaningful
+    static Vector XorPopCount(Vector acc, Vector a, Vector b)
+    {
+        const auto table =
+            _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const auto nibble = _mm_set1_epi8(0x0f);
+        const auto bits = _mm_xor_si128(a, b);
+        const auto counts = _mm_add_epi8(
+            _mm_shuffle_epi8(table, _mm_and_si128(bits, nibble)),
+            _mm_shuffle_epi8(table,
+                             _mm_and_si128(_mm_srli_epi16(bits, 4), nibble)));
+        return _mm_add_epi32(acc, _mm_sad_epu8(counts, _mm_setzero_si128()));
+    }
+
+    //! Number of rows and columns of tiles transposed by Transpose
+    static constexpr std::size_t TransposeBlock = Float32::TransposeBlock;
+
+    //! Writes transposed TransposeBlock x TransposeBlock tile of src to dst
+    //! Shuffles only move bits, so the float version is reused
+    static void Transpose(const Scalar* src, std::size_t ldSrc, Scalar* dst,
+                          std::size_t ldDst)
+    {
+        Float32::Transpose(reinterpret_cast<const float*>(src), ldSrc,
+                           reinterpret_cast<float*>(dst), ldDst);
+    }
+};
+} // namespace Takion::Compute::CPU::Simd::Sse
+
+#endif
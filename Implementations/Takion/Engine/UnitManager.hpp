@@ -11,11 +11,13 @@
 #include <Takion/Units/HiddenUnits/Dense.hpp>
 #include <Takion/Units/SourceUnits/ConstantUnit.hpp>
 #include <Takion/Units/SourceUnits/PlaceHolder.hpp>
+#include <Takion/Units/SourceUnits/SparsePlaceHolder.hpp>
 #include <Takion/Units/HiddenUnits/Activations/ReLU.hpp>
 #include <Takion/Units/HiddenUnits/Activations/Sigmoid.hpp>
 #include <Takion/Units/HiddenUnits/Activations/SoftMax.hpp>
 #include <Takion/Units/SinkUnits/MSE.hpp>
 #include <Takion/Units/SinkUnits/CrossEntropy.hpp>
+#include <type_traits>
 
 
 namespace Takion::Engine
@@ -56,6 +58,13 @@ void UnitManager<T>::SetLoader(const UnitId& unitId,
     m_loaderMap[unitId] = std::move(loader);
 }
 
+template <typename T>
+void UnitManager<T>::SetLoader(const UnitId& unitId,
+                               std::unique_ptr<Util::SparseLoader<T>> loader)
+{
+    m_sparseLoaderMap[unitId] = std::move(loader);
+}
+
 
 template <typename T>
 Shape UnitManager<T>::GetUnitOutputShape(const UnitId& unitId)
@@ -77,6 +86,10 @@ void UnitManager<T>::Compile(const std::string& optimizerName,
             continue;
         throw std::runtime_error("No matching unit type");
     }
+
+    m_fuseActivations();
+    m_linkSparseInputs();
+    m_resolveKernels();
 }
 
 template <typename T>
@@ -202,6 +215,54 @@ void UnitManager<T>::ChangeBatchSize(std::size_t batchSize)
     m_batchSize = batchSize;
 }
 
+template <typename T>
+void UnitManager<T>::RecordRanges()
+{
+    for (const auto& [key, unitPtr] : m_unitMap)
+    {
+        if (key.Type.Name() == "Dense")
+            dynamic_cast<Graph::DenseUnit<T>&>(*unitPtr).RecordRange();
+        else if (key.Type.Name() == "ReLU")
+            dynamic_cast<Graph::ReLU<T>&>(*unitPtr).RecordRange();
+        else if (key.Type.Name() == "Sigmoid")
+            dynamic_cast<Graph::Sigmoid<T>&>(*unitPtr).RecordRange();
+    }
+}
+
+template <typename T>
+void UnitManager<T>::Quantize()
+{
+    for (const auto& [key, unitPtr] : m_unitMap)
+        if (key.Type.Name() == "Dense")
+            dynamic_cast<Graph::DenseUnit<T>&>(*unitPtr).Quantize();
+}
+
+template <typename T>
+void UnitManager<T>::Sparsify(Compute::SparseFormat format, float threshold)
+{
+    for (const auto& [key, unitPtr] : m_unitMap)
+        if (key.Type.Name() == "Dense")
+            dynamic_cast<Graph::DenseUnit<T>&>(*unitPtr).Sparsify(format,
+                                                                  threshold);
+}
+
+template <typename T>
+void UnitManager<T>::SetPrecision(Compute::Precision precision)
+{
+    for (const auto& [key, unitPtr] : m_unitMap)
+        if (key.Type.Name() == "Dense")
+            dynamic_cast<Graph::DenseUnit<T>&>(*unitPtr).SetPrecision(
+                precision);
+}
+
+template <typename T>
+void UnitManager<T>::Binarize()
+{
+    for (const auto& [key, unitPtr] : m_unitMap)
+        if (key.Type.Name() == "Dense")
+            dynamic_cast<Graph::DenseUnit<T>&>(*unitPtr).Binarize();
+}
+
 
 template <typename T>
 const Tensor<T>& UnitManager<T>::GetOutput(UnitId unitId) const
@@ -339,6 +400,14 @@ bool UnitManager<T>::m_appendSource(
             std::make_unique<Graph::PlaceHolder<T>>(std::move(unit));
         return true;
     }
+    if (type.Name() == "SparseFetcher")
+    {
+        auto unit = Graph::SparsePlaceHolder<T>::CreateUnit(
+            unitMetaData, std::move(m_sparseLoaderMap[unitId]));
+        m_unitMap[unitId] =
+            std::make_unique<Graph::SparsePlaceHolder<T>>(std::move(unit));
+        return true;
+    }
     if (type.Name() == "Constant")
     {
         auto unit = Graph::ConstantUnit<T>::CreateUnit(unitMetaData);
@@ -405,6 +474,69 @@ bool UnitManager<T>::m_appendHidden(
     return false;
 }
 
+template <typename T>
+void UnitManager<T>::m_fuseActivations()
+{
+    // Integer GEMM applies leaky ReLU and sigmoid outside of registers, so
+    // only floating point graphs are fused
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        for (const auto& [key, unitMetaData] : m_unitMetaDataMap)
+        {
+            const auto outputUnitVector = unitMetaData.OutputUnitVector();
+            if (key.Type.Name() != "Dense" || outputUnitVector.size() != 1)
+                continue;
+
+            const auto& outputUnitId = outputUnitVector.at(0);
+            auto& denseUnit =
+                dynamic_cast<Graph::DenseUnit<T>&>(*m_unitMap.at(key));
+
+            if (outputUnitId.Type.Name() == "ReLU")
+            {
+                denseUnit.FuseActivation(Compute::ActivationType::LeakyReLU);
+                dynamic_cast<Graph::ReLU<T>&>(*m_unitMap.at(outputUnitId))
+                    .FuseIntoSource();
+            }
+            else if (outputUnitId.Type.Name() == "Sigmoid")
+            {
+                denseUnit.FuseActivation(Compute::ActivationType::Sigmoid);
+                dynamic_cast<Graph::Sigmoid<T>&>(*m_unitMap.at(outputUnitId))
+                    .FuseIntoSource();
+            }
+        }
+    }
+}
+
+template <typename T>
+void UnitManager<T>::m_linkSparseInputs()
+{
+    for (const auto& [key, unitMetaData] : m_unitMetaDataMap)
+    {
+        if (key.Type.Name() != "SparseFetcher")
+            continue;
+
+        const auto& placeHolder = dynamic_cast<Graph::SparsePlaceHolder<T>&>(
+            *m_unitMap.at(key));
+        for (const auto& outputUnitId : unitMetaData.OutputUnitVector())
+        {
+            if (outputUnitId.Type.Name() != "Dense")
+                throw std::runtime_error(
+                    "Sparse Fetcher " + key.UnitName +
+                    " can only be read by Dense units");
+            dynamic_cast<Graph::DenseUnit<T>&>(*m_unitMap.at(outputUnitId))
+                .SetSparseInput(placeHolder.SparseOutput());
+        }
+    }
+}
+
+template <typename T>
+void UnitManager<T>::m_resolveKernels()
+{
+    for (const auto& [key, unitPtr] : m_unitMap)
+        if (key.Type.Name() == "Dense")
+            dynamic_cast<Graph::DenseUnit<T>&>(*unitPtr).ResolveKernels();
+}
+
 template <typename T>
 bool UnitManager<T>::m_appendLoss(const FrontEnd::UnitMetaData<T>& unitMetaData)
 {
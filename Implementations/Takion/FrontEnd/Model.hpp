@@ -67,6 +67,33 @@ AbsTensor<T> Model<T>::Fetcher(const Shape& shape,
     return AbsTensor<T>(shape, subjectUnitId);
 }
 
+template <typename T>
+AbsTensor<T> Model<T>::SparseFetcher(
+    const Shape& shape, std::unique_ptr<Util::SparseLoader<T>> loader,
+    std::string name)
+{
+    const UnitId subjectUnitId{
+        UnitType(UnitBaseType::Fetcher, "SparseFetcher"), m_id++,
+        std::move(name)
+    };
+
+    UnitMetaData<T> unitMetaData(subjectUnitId, m_batchSize, {}, {}, {}, shape,
+                                 {}, m_device);
+
+    m_unitManager.AppendUnit(std::move(unitMetaData));
+    m_unitManager.SetLoader(subjectUnitId, std::move(loader));
+
+    return AbsTensor<T>(shape, subjectUnitId);
+}
+
+template <typename T>
+AbsTensor<T> Model<T>::SparseFetcher(const Shape& shape, std::string name)
+{
+    return SparseFetcher(
+        shape, std::make_unique<Util::SparseLoader<T>>(shape, m_batchSize),
+        std::move(name));
+}
+
 template <typename T>
 AbsTensor<T> Model<T>::Constant(const Shape& shape, std::vector<T> data,
                                 std::string name)
@@ -357,6 +384,55 @@ void Model<T>::Fit(std::size_t epochs)
     }
 }
 
+template <typename T>
+void Model<T>::Calibrate(std::size_t numBatches)
+{
+    for (std::size_t cycle = 0; cycle < numBatches; ++cycle)
+    {
+        m_unitManager.Forward();
+        m_unitManager.RecordRanges();
+        m_unitManager.ResetState();
+    }
+}
+
+template <typename T>
+void Model<T>::Calibrate(std::map<AbsTensor<T>, std::vector<T>> inputDataMap)
+{
+    for (const auto& [inputUnit, data] : inputDataMap)
+    {
+        const auto inputUnitId = inputUnit.GetPrevOutput();
+        auto& dataFetcher = dynamic_cast<Graph::PlaceHolder<T>*>(
+                m_unitManager.GetUnit(inputUnitId).get())
+            ->GetLoader();
+        dataFetcher->SetData(data);
+    }
+    Calibrate(1);
+}
+
+template <typename T>
+void Model<T>::Quantize()
+{
+    m_unitManager.Quantize();
+}
+
+template <typename T>
+void Model<T>::Sparsify(Compute::SparseFormat format, float threshold)
+{
+    m_unitManager.Sparsify(format, threshold);
+}
+
+template <typename T>
+void Model<T>::SetPrecision(Compute::Precision precision)
+{
+    m_unitManager.SetPrecision(precision);
+}
+
+template <typename T>
+void Model<T>::Binarize()
+{
+    m_unitManager.Binarize();
+}
+
 template <typename T>
 Util::TensorData<T> Model<T>::Output(
     AbsTensor<T> absTensor) const
@@ -401,6 +477,19 @@ void Model<T>::ChangeLoader(AbsTensor<T> loaderId,
         ->SetLoader(loaderFunction);
 }
 
+template <typename T>
+void Model<T>::SetSparseData(AbsTensor<T> fetcher, Compute::CsrMatrix<T> data)
+{
+    const auto unitId = fetcher.GetPrevOutput();
+    if (unitId.Type.Name() != "SparseFetcher")
+        throw std::invalid_argument("Given unit must be SparseFetcher");
+
+    dynamic_cast<Graph::SparsePlaceHolder<T>&>(
+        *m_unitManager.GetUnit(unitId))
+        .GetLoader()
+        ->SetData(std::move(data));
+}
+
 template <typename T>
 void Model<T>::m_appendSubjectUnitToPreviousOutput(
     const UnitId& subjectUnit, const UnitId& previousUnit)
@@ -35,7 +35,9 @@ ReLU<T>::ReLU(
 template <typename T>
 ReLU<T>::ReLU(ReLU<T>&& activationUnit) noexcept
     : ComputableUnit<T>(std::move(activationUnit)),
-      m_sourceUnitId(std::move(activationUnit.m_sourceUnitId))
+      m_sourceUnitId(std::move(activationUnit.m_sourceUnitId)),
+      m_fusedIntoSource(activationUnit.m_fusedIntoSource),
+      m_outputRange(activationUnit.m_outputRange)
 {
 }
 
@@ -44,6 +46,8 @@ ReLU<T>& ReLU<T>::operator=(
     ReLU<T>&& activationUnit) noexcept
 {
     ComputableUnit<T>::operator=(std::move(activationUnit));
+    m_fusedIntoSource = activationUnit.m_fusedIntoSource;
+    m_outputRange = activationUnit.m_outputRange;
     return *this;
 }
 
@@ -88,11 +92,10 @@ void ReLU<T>::Forward()
 {
     const Tensor<T>& inputTensor = ForwardInputMap.at(m_sourceUnitId);
 
-    const auto lambdaForward = [](T val)
-    {
-        return val > static_cast<T>(0) ? val : static_cast<T>(0.1f*val);
-    };
-    Compute::Apply(inputTensor, ForwardOutput, lambdaForward);
+    if (m_fusedIntoSource)
+        Util::Span<T>::DeepCopy(ForwardOutput.Data, inputTensor.Data);
+    else
+        Compute::Apply(inputTensor, ForwardOutput, Compute::LeakyReLU());
 }
 
 template <typename T>
@@ -100,11 +103,10 @@ void ReLU<T>::AsyncForward(std::promise<bool> promise)
 {
     const Tensor<T>& inputTensor = ForwardInputMap.at(m_sourceUnitId);
 
-    const auto lambdaForward = [](T val)
-    {
-        return val > static_cast<T>(0) ? val : static_cast<T>(0.1f * val);
-    };
-    Compute::Apply(inputTensor, ForwardOutput, lambdaForward);
+    if (m_fusedIntoSource)
+        Util::Span<T>::DeepCopy(ForwardOutput.Data, inputTensor.Data);
+    else
+        Compute::Apply(inputTensor, ForwardOutput, Compute::LeakyReLU());
 
     promise.set_value(true);
 }
@@ -132,7 +134,7 @@ void ReLU<T>::Backward()
 
         return val > static_cast<T>(0)
                    ? static_cast<T>(1)
-                   : static_cast<T>(0.1f);
+                   : static_cast<T>(LeakyReLUSlope);
     };
 
     Compute::ScalarDiv(backwardTemp, static_cast<T>(BackwardInputMap.size()));
@@ -158,7 +160,7 @@ void ReLU<T>::AsyncBackward(std::promise<bool> promise)
 
     const auto lambdaBackward = [](T val) {
         return val > static_cast<T>(0) ? static_cast<T>(1)
-                                       : static_cast<T>(0.1f);
+                                       : static_cast<T>(LeakyReLUSlope);
     };
 
     Compute::ScalarDiv(backwardTemp, static_cast<T>(BackwardInputMap.size()));
@@ -168,6 +170,18 @@ void ReLU<T>::AsyncBackward(std::promise<bool> promise)
     promise.set_value(true);
 }
 
+template <typename T>
+void ReLU<T>::FuseIntoSource()
+{
+    m_fusedIntoSource = true;
+}
+
+template <typename T>
+void ReLU<T>::RecordRange()
+{
+    m_outputRange.Record(ForwardOutput);
+}
+
 template <typename T>
 void ReLU<T>::ChangeBatchSize(std::size_t batchSize)
 {
@@ -34,7 +34,9 @@ Sigmoid<T>::Sigmoid(const UnitId& unitId, UnitId sourceUnitId,
 template <typename T>
 Sigmoid<T>::Sigmoid(Sigmoid<T>&& activationUnit) noexcept
     : ComputableUnit<T>(std::move(activationUnit)),
-      m_sourceUnitId(std::move(activationUnit.m_sourceUnitId))
+      m_sourceUnitId(std::move(activationUnit.m_sourceUnitId)),
+      m_fusedIntoSource(activationUnit.m_fusedIntoSource),
+      m_outputRange(activationUnit.m_outputRange)
 {
 }
 
@@ -42,6 +44,8 @@ template <typename T>
 Sigmoid<T>& Sigmoid<T>::operator=(Sigmoid<T>&& activationUnit) noexcept
 {
     ComputableUnit<T>::operator=(std::move(activationUnit));
+    m_fusedIntoSource = activationUnit.m_fusedIntoSource;
+    m_outputRange = activationUnit.m_outputRange;
     return *this;
 }
 
@@ -86,11 +90,10 @@ void Sigmoid<T>::Forward()
 {
     const Tensor<T>& inputTensor = ForwardInputMap.at(m_sourceUnitId);
 
-    const auto lambdaForward = [](T val)
-    {
-        return static_cast<T>(static_cast<T>(1) / (1 + std::exp(-val)));
-    };
-    Compute::Apply(inputTensor, ForwardOutput, lambdaForward);
+    if (m_fusedIntoSource)
+        Util::Span<T>::DeepCopy(ForwardOutput.Data, inputTensor.Data);
+    else
+        Compute::Apply(inputTensor, ForwardOutput, Compute::Sigmoid());
 }
 
 template <typename T>
@@ -98,12 +101,10 @@ void Sigmoid<T>::AsyncForward(std::promise<bool> promise)
 {
     const Tensor<T>& inputTensor = ForwardInputMap.at(m_sourceUnitId);
 
-    const auto lambdaForward = [](T val)
-    {
-        return static_cast<T>(static_cast<T>(std::exp(val)) / (1 + std::exp(val)
-                              ));
-    };
-    Compute::Apply(inputTensor, ForwardOutput, lambdaForward);
+    if (m_fusedIntoSource)
+        Util::Span<T>::DeepCopy(ForwardOutput.Data, inputTensor.Data);
+    else
+        Compute::Apply(inputTensor, ForwardOutput, Compute::Sigmoid());
 
     promise.set_value(true);
 }
@@ -115,7 +116,6 @@ void Sigmoid<T>::Backward()
 
     Tensor<T>& backwardTemp = InternalTensorMap.at("backwardTemp");
     Tensor<T>& backwardOutput = BackwardOutputMap.at(m_sourceUnitId);
-    const Tensor<T>& inputTensor = ForwardInputMap.at(m_sourceUnitId);
 
     zeroInitializer.Initialize(backwardTemp);
 
@@ -124,19 +124,15 @@ void Sigmoid<T>::Backward()
         Compute::Add(tensor, backwardTemp);
     }
 
-    const auto lambdaForward = [](T val)
-    {
-        return static_cast<T>(static_cast<T>(std::exp(val)) /
-                              (1 + std::exp(val)));
-    };
-
-    const auto lambdaBackward = [=](T val)
+    // Derivative is computed from the forward output, which holds sigmoid
+    // of the input whether or not it was fused into the source unit
+    const auto lambdaBackward = [](T val)
     {
-        return static_cast<T>(lambdaForward(val) * (1 - lambdaForward(val)));
+        return static_cast<T>(val * (1 - val));
     };
 
     Compute::ScalarDiv(backwardTemp, static_cast<T>(BackwardInputMap.size()));
-    Compute::Apply(inputTensor, backwardOutput, lambdaBackward);
+    Compute::Apply(ForwardOutput, backwardOutput, lambdaBackward);
     Compute::Dot(backwardTemp, backwardOutput, backwardOutput);
 }
 
@@ -147,7 +143,6 @@ void Sigmoid<T>::AsyncBackward(std::promise<bool> promise)
 
     Tensor<T>& backwardTemp = InternalTensorMap.at("backwardTemp");
     Tensor<T>& backwardOutput = BackwardOutputMap.at(m_sourceUnitId);
-    const Tensor<T>& inputTensor = ForwardInputMap.at(m_sourceUnitId);
 
     zeroInitializer.Initialize(backwardTemp);
 
@@ -156,17 +151,28 @@ void Sigmoid<T>::AsyncBackward(std::promise<bool> promise)
 
     const auto lambdaBackward = [](T val)
     {
-        return static_cast<T>(std::exp(val) / (1 + exp(val)) -
-                              (std::exp(val) / std::pow(1 + exp(val), 2)));
+        return static_cast<T>(val * (1 - val));
     };
 
     Compute::ScalarDiv(backwardTemp, static_cast<T>(BackwardInputMap.size()));
-    Compute::Apply(backwardTemp, backwardOutput, lambdaBackward);
-    Compute::Dot(inputTensor, backwardOutput, backwardOutput);
+    Compute::Apply(ForwardOutput, backwardOutput, lambdaBackward);
+    Compute::Dot(backwardTemp, backwardOutput, backwardOutput);
 
     promise.set_value(true);
 }
 
+template <typename T>
+void Sigmoid<T>::FuseIntoSource()
+{
+    m_fusedIntoSource = true;
+}
+
+template <typename T>
+void Sigmoid<T>::RecordRange()
+{
+    m_outputRange.Record(ForwardOutput);
+}
+
 template <typename T>
 void Sigmoid<T>::ChangeBatchSize(std::size_t batchSize)
 {
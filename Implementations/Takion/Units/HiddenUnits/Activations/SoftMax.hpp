@@ -8,6 +8,7 @@
 #define TAKION_GRAPH_DECL_HPP
 
 #include <Takion/Computations/GEMM/MathKernel.hpp>
+#include <Takion/Computations/Reductions/Reduction.hpp>
 #include <Takion/Units/HiddenUnits/Activations/SoftMaxDecl.hpp>
 #include <algorithm>
 
@@ -56,14 +57,16 @@ SoftMax<T> SoftMax<T>::CreateUnit(const FrontEnd::UnitMetaData<T>& unitMetaData)
     Tensor<T> forwardOutputTensor(outputShape, batchSize, device);
     Tensor<T> backwardOutputTensor(inputShape, batchSize, device);
     Tensor<T> backwardTempTensor(outputShape, batchSize, device);
+    Tensor<T> sampleReductionTensor(Shape({ 1 }), batchSize, device);
 
     auto activationUnit =
         SoftMax<T>(unitMetaData.Id(), sourceUnitId,
                    forwardInputTensor,
                    backwardInputMap, forwardOutputTensor,
                    backwardOutputTensor,
-                   { { "backwardTemp", backwardTempTensor } }, device,
-                   batchSize);
+                   { { "backwardTemp", backwardTempTensor },
+                     { "sampleReduction", sampleReductionTensor } },
+                   device, batchSize);
 
     return activationUnit;
 }
@@ -75,28 +78,38 @@ void SoftMax<T>::Forward()
     const auto shape = ForwardOutput.TensorShape;
     const auto size = shape.Size();
     const Tensor<T>& inputTensor = ForwardInputMap[m_sourceUnitId];
+    Tensor<T>& sampleReduction = InternalTensorMap["sampleReduction"];
 
     if (m_device.Type() == Compute::DeviceType::CPU)
     {
+        // Maximum of each sample is subtracted before exp, so the sum
+        // cannot overflow
+        Compute::ReduceSamples(inputTensor, sampleReduction,
+                               Compute::ReduceOp::Max);
+
 #pragma omp parallel for schedule(static)
         for (long batchIdx = 0; batchIdx < static_cast<long>(batchSize);
              ++batchIdx)
         {
-            T sum = static_cast<T>(0);
+            const auto max = sampleReduction.At(batchIdx);
             for (std::size_t idx = 0; idx < size; ++idx)
             {
                 const auto index = batchIdx * size + idx;
-                const auto val = inputTensor.At(index);
-                T toAdd = static_cast<T>(std::exp(val));
-                sum = sum + toAdd;
+                ForwardOutput.At(index) = inputTensor.At(index) - max;
             }
+        }
+        Compute::Apply(ForwardOutput, ForwardOutput, Compute::Exp());
+
+        Compute::ReduceSamples(ForwardOutput, sampleReduction,
+                               Compute::ReduceOp::Sum);
+
+#pragma omp parallel for schedule(static)
+        for (long batchIdx = 0; batchIdx < static_cast<long>(batchSize);
+             ++batchIdx)
+        {
+            const auto sum = sampleReduction.At(batchIdx);
             for (std::size_t idx = 0; idx < size; ++idx)
-            {
-                const auto index = batchIdx * size + idx;
-                const auto val = inputTensor.At(index);
-                ForwardOutput.At(index) =
-                    static_cast<T>(std::exp(val)) / sum;
-            }
+                ForwardOutput.At(batchIdx * size + idx) /= sum;
         }
     }
     else
@@ -112,30 +125,38 @@ void SoftMax<T>::AsyncForward(std::promise<bool> promise)
     const auto shape = ForwardOutput.TensorShape;
     const auto size = shape.Size();
     const Tensor<T>& inputTensor = ForwardInputMap[m_sourceUnitId];
+    Tensor<T>& sampleReduction = InternalTensorMap["sampleReduction"];
 
     if (m_device.Type() == Compute::DeviceType::CPU)
     {
+        // Maximum of each sample is subtracted before exp, so the sum
+        // cannot overflow
+        Compute::ReduceSamples(inputTensor, sampleReduction,
+                               Compute::ReduceOp::Max);
+
 #pragma omp parallel for schedule(static)
         for (long batchIdx = 0; batchIdx < static_cast<long>(batchSize);
              ++batchIdx)
         {
-            T sum = static_cast<T>(0);
+            const auto max = sampleReduction.At(batchIdx);
             for (std::size_t idx = 0; idx < size; ++idx)
             {
                 const auto index = batchIdx * size + idx;
-                const auto val = inputTensor.At(index);
-                T toAdd = std::min(static_cast<T>(std::exp(val)),
-                                   std::numeric_limits<T>::max());
-                sum = std::min(sum + toAdd, std::numeric_limits<T>::max());
+                ForwardOutput.At(index) = inputTensor.At(index) - max;
             }
+        }
+        Compute::Apply(ForwardOutput, ForwardOutput, Compute::Exp());
+
+        Compute::ReduceSamples(ForwardOutput, sampleReduction,
+                               Compute::ReduceOp::Sum);
+
+#pragma omp parallel for schedule(static)
+        for (long batchIdx = 0; batchIdx < static_cast<long>(batchSize);
+             ++batchIdx)
+        {
+            const auto sum = sampleReduction.At(batchIdx);
             for (std::size_t idx = 0; idx < size; ++idx)
-            {
-                const auto index = batchIdx * size + idx;
-                const auto val = inputTensor.At(index);
-                ForwardOutput.At(index) =
-                    std::min(static_cast<T>(std::exp(val)),
-                             std::numeric_limits<T>::max()) / sum;
-            }
+                ForwardOutput.At(batchIdx * size + idx) /= sum;
         }
     }
     else
@@ -280,6 +301,8 @@ void SoftMax<T>::ChangeBatchSize(std::size_t batchSize)
     ComputableUnit<T>::ChangeBatchSize(batchSize);
     Tensor<T>& backwardTemp = InternalTensorMap.at("backwardTemp");
     backwardTemp.ChangeBatchSize(batchSize);
+    Tensor<T>& sampleReduction = InternalTensorMap.at("sampleReduction");
+    sampleReduction.ChangeBatchSize(batchSize);
 }
 
 template <typename T>
@@ -10,6 +10,9 @@
 
 #include <Takion/Units/HiddenUnits/DenseDecl.hpp>
 #include <Takion/Computations/GEMM/MathKernel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <unordered_map>
 
 
@@ -37,7 +40,17 @@ template <typename T>
 DenseUnit<T>::DenseUnit(DenseUnit<T>&& denseUnit) noexcept
     : ComputableUnit<T>(std::move(denseUnit)),
       TrainableUnit<T>(std::move(denseUnit)),
-      m_sourceUnitId(std::move(denseUnit.m_sourceUnitId))
+      m_sourceUnitId(std::move(denseUnit.m_sourceUnitId)),
+      m_activation(denseUnit.m_activation),
+      m_inputRange(denseUnit.m_inputRange),
+      m_kernels(denseUnit.m_kernels),
+      m_quantized(std::move(denseUnit.m_quantized)),
+      m_sparseWeight(std::move(denseUnit.m_sparseWeight)),
+      m_sparseInput(std::move(denseUnit.m_sparseInput)),
+      m_sparseWeightUpdate(std::move(denseUnit.m_sparseWeightUpdate)),
+      m_float16(std::move(denseUnit.m_float16)),
+      m_bfloat16(std::move(denseUnit.m_bfloat16)),
+      m_binary(std::move(denseUnit.m_binary))
 {
 }
 
@@ -47,6 +60,16 @@ DenseUnit<T>& DenseUnit<T>::operator=(DenseUnit<T>&& denseUnit) noexcept
 {
     ComputableUnit<T>::operator=(std::move(denseUnit));
     TrainableUnit<T>::operator=(std::move(denseUnit));
+    m_activation = denseUnit.m_activation;
+    m_inputRange = denseUnit.m_inputRange;
+    m_kernels = denseUnit.m_kernels;
+    m_quantized = std::move(denseUnit.m_quantized);
+    m_sparseWeight = std::move(denseUnit.m_sparseWeight);
+    m_sparseInput = std::move(denseUnit.m_sparseInput);
+    m_sparseWeightUpdate = std::move(denseUnit.m_sparseWeightUpdate);
+    m_float16 = std::move(denseUnit.m_float16);
+    m_bfloat16 = std::move(denseUnit.m_bfloat16);
+    m_binary = std::move(denseUnit.m_binary);
 
     return *this;
 }
@@ -63,7 +86,6 @@ DenseUnit<T> DenseUnit<T>::CreateUnit(
     const auto biasShape = unitMetaData.InternalVariableShape("bias");
     const auto inputShape = unitMetaData.GetInputShape("input");
     const auto outputShape = unitMetaData.GetOutputShape();
-    const auto weightTransposeShape = weightShape.GetTransposedShape();
 
     DenseUnit<T>::m_checkShape(inputShape, outputShape, weightShape, biasShape,
                                unitId.UnitName);
@@ -71,7 +93,12 @@ DenseUnit<T> DenseUnit<T>::CreateUnit(
     const auto& weightInitializer = unitMetaData.GetInitializer("weight");
     const auto& biasInitializer = unitMetaData.GetInitializer("bias");
 
-    Tensor<T> forwardInputTensor(unitMetaData.GetInputShape("input"),
+    // Sparse inputs are read from the placeholder (see SetSparseInput), so
+    // input tensors only hold one element per sample
+    const bool sparseInput = sourceUnitId.Type.Name() == "SparseFetcher";
+    const auto inputTensorShape = sparseInput ? Shape({ 1 }) : inputShape;
+
+    Tensor<T> forwardInputTensor(inputTensorShape,
                                  unitMetaData.BatchSize(),
                                  unitMetaData.Device);
 
@@ -88,14 +115,12 @@ DenseUnit<T> DenseUnit<T>::CreateUnit(
     Tensor<T> forwardOutputTensor(outputShape,
                                   batchSize, unitMetaData.Device);
 
-    Tensor<T> backwardOutputTensor(inputShape,
+    Tensor<T> backwardOutputTensor(inputTensorShape,
                                    batchSize,
                                    unitMetaData.Device);
 
     Tensor<T> weight(weightShape, unitMetaData.Device);
-    Tensor<T> weightTranspose(weightTransposeShape, unitMetaData.Device);
 
-    Tensor<T> weightUpdate(weightShape, batchSize, unitMetaData.Device);
     Tensor<T> weightUpdateMean(weightShape, unitMetaData.Device);
 
     Tensor<T> bias(biasShape, unitMetaData.Device);
@@ -104,11 +129,6 @@ DenseUnit<T> DenseUnit<T>::CreateUnit(
     Tensor<T> delta(unitMetaData.GetOutputShape(), batchSize,
                     unitMetaData.Device);
 
-    Tensor<T> previousInputTranspose(
-        inputShape.GetTransposedShape(),
-        unitMetaData.BatchSize(),
-        unitMetaData.Device);
-
     weightInitializer->Initialize(weight);
     biasInitializer->Initialize(bias);
 
@@ -119,12 +139,9 @@ DenseUnit<T> DenseUnit<T>::CreateUnit(
 
     std::unordered_map<std::string, Tensor<T>> internalTensorMap =
     {
-        { "weightTranspose", weightTranspose },
-        { "weightUpdate", weightUpdate },
         { "weightUpdateMean", weightUpdateMean },
         { "biasUpdateMean", biasUpdateMean },
-        { "delta", delta },
-        { "previousInputTranspose", previousInputTranspose }
+        { "delta", delta }
     };
 
     auto denseUnit = DenseUnit<T>(
@@ -141,25 +158,81 @@ DenseUnit<T> DenseUnit<T>::CreateUnit(
 template <typename T>
 void DenseUnit<T>::Forward()
 {
-    const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
-    const Tensor<T>& weight = TrainableTensorMap.at("weight");
-    const Tensor<T>& bias = TrainableTensorMap.at("bias");
-    Tensor<T>& output = ForwardOutput;
+    if (m_quantized)
+    {
+        m_quantizedForward();
+        return;
+    }
+    if (m_sparseWeight)
+    {
+        m_sparseForward();
+        return;
+    }
+    if (m_float16)
+    {
+        m_halfForward(*m_float16);
+        return;
+    }
+    if (m_bfloat16)
+    {
+        m_halfForward(*m_bfloat16);
+        return;
+    }
+    if (m_binary)
+    {
+        m_binaryForward();
+        return;
+    }
+    if (m_sparseInput)
+    {
+        m_sparseInputForward();
+        return;
+    }
 
-    Compute::Multiply(input, weight, output);
-    Compute::Add(bias, output, output);
+    m_forward();
 }
 
 template <typename T>
 void DenseUnit<T>::AsyncForward(std::promise<bool> promise)
 {
-    const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
-    const Tensor<T>& weight = TrainableTensorMap.at("weight");
-    const Tensor<T>& bias = TrainableTensorMap.at("bias");
-    Tensor<T>& output = ForwardOutput;
+    if (m_quantized)
+    {
+        m_quantizedForward();
+        promise.set_value(true);
+        return;
+    }
+    if (m_sparseWeight)
+    {
+        m_sparseForward();
+        promise.set_value(true);
+        return;
+    }
+    if (m_float16)
+    {
+        m_halfForward(*m_float16);
+        promise.set_value(true);
+        return;
+    }
+    if (m_bfloat16)
+    {
+        m_halfForward(*m_bfloat16);
+        promise.set_value(true);
+        return;
+    }
+    if (m_binary)
+    {
+        m_binaryForward();
+        promise.set_value(true);
+        return;
+    }
+    if (m_sparseInput)
+    {
+        m_sparseInputForward();
+        promise.set_value(true);
+        return;
+    }
 
-    Compute::Multiply(input, weight, output);
-    Compute::Add(bias, output, output);
+    m_forward();
 
     promise.set_value(true);
 }
@@ -167,20 +240,14 @@ void DenseUnit<T>::AsyncForward(std::promise<bool> promise)
 template <typename T>
 void DenseUnit<T>::Backward()
 {
-    Tensor<T>& weight = TrainableTensorMap.at("weight");
-    Tensor<T>& weightTranspose = InternalTensorMap.at("weightTranspose");
-    Tensor<T>& weightUpdate = InternalTensorMap.at("weightUpdate");
-    Tensor<T>& weightUpdateMean = InternalTensorMap.at("weightUpdateMean");
+    m_checkTrainable();
 
+    Tensor<T>& weight = TrainableTensorMap.at("weight");
     Tensor<T>& bias = TrainableTensorMap.at("bias");
     Tensor<T>& biasUpdateMean = InternalTensorMap.at("biasUpdateMean");
 
     Tensor<T>& delta = InternalTensorMap.at("delta");
 
-    Tensor<T>& previousInputTranspose =
-        InternalTensorMap.at("previousInputTranspose");
-
-    Tensor<T>& previousForwardInput = ForwardInputMap.at(m_sourceUnitId);
     Tensor<T>& backwardOutput = BackwardOutputMap.at(m_sourceUnitId);
 
     const Compute::Zeros<T> zeroInitializer;
@@ -201,36 +268,32 @@ void DenseUnit<T>::Backward()
     }
 
     Compute::ScalarDiv(delta, static_cast<T>(BackwardInputMap.size()));
-    Compute::Transpose(weight, weightTranspose);
-    Compute::Multiply(delta, weightTranspose, backwardOutput);
-
-    Compute::Transpose(previousForwardInput, previousInputTranspose);
-    Compute::Multiply(previousInputTranspose, delta, weightUpdate);
-
-    Compute::Shrink(weightUpdate, weightUpdateMean);
+    if (m_sparseInput)
+        m_sparseInputUpdate(delta);
+    else
+    {
+        Tensor<T>& weightUpdateMean =
+            InternalTensorMap.at("weightUpdateMean");
+        m_gradient(delta, backwardOutput, weightUpdateMean);
+        m_optimizer->Optimize(weight, weightUpdateMean);
+    }
     Compute::Shrink(delta, biasUpdateMean);
 
-    m_optimizer->Optimize(weight, weightUpdateMean);
     m_optimizer->Optimize(bias, biasUpdateMean);
+    m_convertMasterWeight();
 }
 
 template <typename T>
 void DenseUnit<T>::AsyncBackward(std::promise<bool> promise)
 {
-    Tensor<T>& weight = TrainableTensorMap.at("weight");
-    Tensor<T>& weightTranspose = InternalTensorMap.at("weightTranspose");
-    Tensor<T>& weightUpdate = InternalTensorMap.at("weightUpdate");
-    Tensor<T>& weightUpdateMean = InternalTensorMap.at("weightUpdateMean");
+    m_checkTrainable();
 
+    Tensor<T>& weight = TrainableTensorMap.at("weight");
     Tensor<T>& bias = TrainableTensorMap.at("bias");
     Tensor<T>& biasUpdateMean = InternalTensorMap.at("biasUpdateMean");
 
     Tensor<T>& delta = InternalTensorMap.at("delta");
 
-    Tensor<T>& previousInputTranspose =
-        InternalTensorMap.at("previousInputTranspose");
-
-    Tensor<T>& previousForwardInput = ForwardInputMap.at(m_sourceUnitId);
     Tensor<T>& backwardOutput = BackwardOutputMap.at(m_sourceUnitId);
 
     const Compute::Zeros<T> zeroInitializer;
@@ -242,17 +305,19 @@ void DenseUnit<T>::AsyncBackward(std::promise<bool> promise)
     }
 
     Compute::ScalarDiv(delta, static_cast<T>(BackwardInputMap.size()));
-    Compute::Transpose(weight, weightTranspose);
-    Compute::Multiply(delta, weightTranspose, backwardOutput);
-
-    Compute::Transpose(previousForwardInput, previousInputTranspose);
-    Compute::Multiply(previousInputTranspose, delta, weightUpdate);
-
-    Compute::Shrink(weightUpdate, weightUpdateMean);
+    if (m_sparseInput)
+        m_sparseInputUpdate(delta);
+    else
+    {
+        Tensor<T>& weightUpdateMean =
+            InternalTensorMap.at("weightUpdateMean");
+        m_gradient(delta, backwardOutput, weightUpdateMean);
+        m_optimizer->Optimize(weight, weightUpdateMean);
+    }
     Compute::Shrink(delta, biasUpdateMean);
 
-    m_optimizer->Optimize(weight, weightUpdateMean);
     m_optimizer->Optimize(bias, biasUpdateMean);
+    m_convertMasterWeight();
 
     promise.set_value(true);
 }
@@ -261,10 +326,520 @@ template <typename T>
 void DenseUnit<T>::ChangeBatchSize(std::size_t batchSize)
 {
     ComputableUnit<T>::ChangeBatchSize(batchSize);
-    Tensor<T>& weightUpdate = InternalTensorMap.at("weightUpdate");
-    weightUpdate.ChangeBatchSize(batchSize);
+    Tensor<T>& delta = InternalTensorMap.at("delta");
+    delta.ChangeBatchSize(batchSize);
+    if (m_quantized)
+        m_quantized->Input.ChangeBatchSize(batchSize);
+    if (m_float16)
+        m_float16->Input.ChangeBatchSize(batchSize);
+    if (m_bfloat16)
+        m_bfloat16->Input.ChangeBatchSize(batchSize);
+    if (const auto binaryInput = InternalTensorMap.find("binaryInput");
+        binaryInput != InternalTensorMap.end())
+        binaryInput->second.ChangeBatchSize(batchSize);
+    // Folded GEMMs grow with the batch, so blocking is tuned and kernels are
+    // generated again
+    if (m_kernels.Forward)
+        m_resolveShapeKernels();
+}
+
+
+template <typename T>
+void DenseUnit<T>::FuseActivation(Compute::ActivationType activation)
+{
+    m_activation = activation;
+}
+
+template <typename T>
+void DenseUnit<T>::ResolveKernels()
+{
+    using Compute::BroadcastMode;
+    using Compute::KernelLayout;
+    using Compute::KernelOp;
+
+    // Broadcast variants also handle inputs with batch size of 1, so kernels
+    // stay valid when the batch size changes
+    m_kernels.Forward = Compute::ResolveGemmKernel<T>(
+        KernelOp::MultiplyAdd, BroadcastMode::BroadcastB,
+        KernelLayout::RowMajor);
+    m_kernels.BackwardOutput = Compute::ResolveGemmKernel<T>(
+        KernelOp::Multiply, BroadcastMode::BroadcastB,
+        KernelLayout::TransposeB);
+    m_kernels.WeightGradient = Compute::ResolveGemmKernel<T>(
+        KernelOp::MultiplyTransposedMean, BroadcastMode::None,
+        KernelLayout::TransposeA);
+    m_resolveShapeKernels();
+}
+
+template <typename T>
+void DenseUnit<T>::SetSparseInput(
+    std::shared_ptr<const Compute::CsrMatrix<T>> input)
+{
+    const auto& unitName = ComputableUnit<T>::m_unitId.UnitName;
+    if (m_quantized || m_sparseWeight || m_float16 || m_bfloat16 || m_binary)
+        throw std::runtime_error(
+            "Dense " + unitName +
+            " - Only float or double weights can read sparse inputs");
+
+    m_sparseInput = std::move(input);
+    // Weight gradient is kept only for rows read by the batch
+    InternalTensorMap.erase("weightUpdateMean");
+}
+
+template <typename T>
+void DenseUnit<T>::RecordRange()
+{
+    if (m_sparseInput)
+        return;
+    m_inputRange.Record(ForwardInputMap.at(m_sourceUnitId));
+}
+
+template <typename T>
+void DenseUnit<T>::m_resolveShapeKernels()
+{
+    using Compute::BroadcastMode;
+    using Compute::KernelLayout;
+
+    // Quantized, sparse and binarized units have released their float
+    // weights, and sparse inputs are not multiplied by GEMM kernels
+    if (m_quantized || m_sparseWeight || m_sparseInput || IsBinarized())
+        return;
+
+    auto& tuner = Compute::GemmTuner::Get();
+    const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
+    const Tensor<T>& weight = TrainableTensorMap.at("weight");
+    Tensor<T>& delta = InternalTensorMap.at("delta");
+
+    const auto forwardArguments = Compute::MakeGemmArguments(
+        input, weight, TrainableTensorMap.at("bias"), ForwardOutput,
+        m_activation, static_cast<T>(1));
+    m_kernels.ForwardBlocking = tuner.Resolve(Compute::MakeGemmTuningKey(
+        forwardArguments, BroadcastMode::BroadcastB, KernelLayout::RowMajor));
+    // Single sample of a single row is left to the GEMV kernel of Forward,
+    // which streams weights with the widest vectors of the processor
+    if constexpr (std::is_same_v<T, float>)
+        m_kernels.JitForward =
+            forwardArguments.M * forwardArguments.NumMatrices > 1
+                ? Compute::Jit::CompileGemm(forwardArguments)
+                : nullptr;
+
+    // Units which are not trained may have no backward output
+    const auto backwardOutput = BackwardOutputMap.find(m_sourceUnitId);
+    if (backwardOutput != BackwardOutputMap.end())
+        m_kernels.BackwardOutputBlocking =
+            tuner.Resolve(Compute::MakeGemmTuningKey(
+                Compute::MakeGemmArguments(delta, weight,
+                                           backwardOutput->second, false,
+                                           true),
+                BroadcastMode::BroadcastB, KernelLayout::TransposeB));
+
+    m_kernels.WeightGradientBlocking = tuner.Resolve(Compute::MakeGemmTuningKey(
+        Compute::MakeMultiplyTransposedMeanArguments(
+            input, delta, InternalTensorMap.at("weightUpdateMean")),
+        BroadcastMode::None, KernelLayout::TransposeA));
+}
+
+template <typename T>
+void DenseUnit<T>::Quantize()
+{
+    const auto& unitName = ComputableUnit<T>::m_unitId.UnitName;
+    if constexpr (!std::is_same_v<T, float>)
+    {
+        throw std::runtime_error("Dense " + unitName +
+                                 " - Only float units can be quantized");
+    }
+    else
+    {
+        if (m_quantized)
+            return;
+        if (m_sparseWeight)
+            throw std::runtime_error("Dense " + unitName +
+                                     " - Sparse units cannot be quantized");
+        if (IsBinarized())
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Binarized units cannot be quantized");
+        if (m_sparseInput)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Units with sparse input cannot be quantized");
+        if (m_inputRange.Empty())
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Input range should be recorded before quantization");
+
+        const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
+        const Tensor<T>& weight = TrainableTensorMap.at("weight");
+        const Tensor<T>& bias = TrainableTensorMap.at("bias");
+        const auto numRow = weight.TensorShape.NumRow();
+        const auto numCol = weight.TensorShape.NumCol();
+
+        const auto ldWeight = weight.ColumnElementSize();
+        auto state = std::make_unique<QuantizedState>(input, weight);
+        const auto ldQuantized = state->Weight.ColumnElementSize();
+        state->InputQuantization = Compute::ChooseQuantizationParameters(
+            m_inputRange.Min, m_inputRange.Max);
+
+        // Each output channel (column of weight) gets its own scale, so
+        // that the largest weight of every channel is mapped to
+        // QuantizedWeightMax
+        auto& requantization = state->Requantization;
+        requantization.Scale.assign(numCol, 0.0f);
+        requantization.Bias.assign(numCol, 0.0f);
+        requantization.ZeroPointA = state->InputQuantization.ZeroPoint;
+        requantization.Activation = m_activation;
+
+        const auto weightMax = static_cast<float>(Compute::CPU::QuantizedWeightMax);
+        for (std::size_t col = 0; col < numCol; ++col)
+        {
+            float maxAbs = 0.0f;
+            for (std::size_t row = 0; row < numRow; ++row)
+                maxAbs = std::max(maxAbs,
+                                  std::abs(weight.Data[row * ldWeight + col]));
+
+            const auto weightScale = maxAbs > 0.0f ? maxAbs / weightMax : 1.0f;
+            for (std::size_t row = 0; row < numRow; ++row)
+                state->Weight.Data[row * ldQuantized + col] =
+                    static_cast<std::int8_t>(std::nearbyint(
+                        weight.Data[row * ldWeight + col] / weightScale));
+
+            requantization.Scale[col] =
+                state->InputQuantization.Scale * weightScale;
+            requantization.Bias[col] = bias.At(col);
+        }
+
+        m_quantized = std::move(state);
+        m_float16.reset();
+        m_bfloat16.reset();
+        m_binary.reset();
+        InternalTensorMap.erase("binaryInput");
+        InternalTensorMap.erase("binaryWeight");
+
+        // Float weights are no longer read
+        TrainableTensorMap.erase("weight");
+        InternalTensorMap.erase("weightUpdateMean");
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::Sparsify(Compute::SparseFormat format, float threshold)
+{
+    const auto& unitName = ComputableUnit<T>::m_unitId.UnitName;
+    if constexpr (!std::is_same_v<T, float>)
+    {
+        throw std::runtime_error("Dense " + unitName +
+                                 " - Only float units can be sparsified");
+    }
+    else
+    {
+        if (m_sparseWeight)
+            return;
+        if (m_quantized)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Quantized units cannot be sparsified");
+        if (IsBinarized())
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Binarized units cannot be sparsified");
+        if (m_sparseInput)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Units with sparse input cannot be sparsified");
+
+        const Tensor<T>& weight = TrainableTensorMap.at("weight");
+        m_sparseWeight = std::make_unique<Compute::SparseMatrix>(
+            Compute::SparseMatrix::FromDense(
+                weight.Data.Base(), weight.TensorShape.NumRow(),
+                weight.TensorShape.NumCol(), weight.ColumnElementSize(),
+                format, threshold));
+        m_float16.reset();
+        m_bfloat16.reset();
+        m_binary.reset();
+        InternalTensorMap.erase("binaryInput");
+        InternalTensorMap.erase("binaryWeight");
+
+        // Float weights are no longer read
+        TrainableTensorMap.erase("weight");
+        InternalTensorMap.erase("weightUpdateMean");
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::m_forward()
+{
+    const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
+    const Tensor<T>& weight = TrainableTensorMap.at("weight");
+    const Tensor<T>& bias = TrainableTensorMap.at("bias");
+    Tensor<T>& output = ForwardOutput;
+
+    if (!m_kernels.Forward)
+        ResolveKernels();
+    auto arguments = Compute::MakeGemmArguments(
+        input, weight, bias, output, m_activation, static_cast<T>(1));
+
+    // Generated kernel is skipped if the shape changed since it was compiled
+    if constexpr (std::is_same_v<T, float>)
+        if (m_kernels.JitForward && m_kernels.JitForward->Matches(arguments))
+        {
+            (*m_kernels.JitForward)(arguments);
+            return;
+        }
+
+    arguments.Blocking = m_kernels.ForwardBlocking;
+    m_kernels.Forward(arguments);
+}
+
+template <typename T>
+void DenseUnit<T>::m_quantizedForward()
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        Compute::Quantize(ForwardInputMap.at(m_sourceUnitId),
+                          m_quantized->Input,
+                          m_quantized->InputQuantization);
+        Compute::Multiply(m_quantized->Input, m_quantized->Weight,
+                          ForwardOutput, m_quantized->Requantization);
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::m_sparseForward()
+{
+    if constexpr (std::is_same_v<T, float>)
+        Compute::MultiplyAdd(ForwardInputMap.at(m_sourceUnitId),
+                             *m_sparseWeight, TrainableTensorMap.at("bias"),
+                             ForwardOutput, m_activation);
+}
+
+template <typename T>
+void DenseUnit<T>::m_binaryForward()
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        Compute::PackSigns(ForwardInputMap.at(m_sourceUnitId),
+                           m_binary->Input);
+        Compute::MultiplyAdd(m_binary->Input, m_binary->Weight,
+                             TrainableTensorMap.at("bias"), ForwardOutput,
+                             m_activation);
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::m_sparseInputForward()
+{
+    Compute::MultiplyAdd(*m_sparseInput, TrainableTensorMap.at("weight"),
+                         TrainableTensorMap.at("bias"), ForwardOutput,
+                         m_activation);
+}
+
+template <typename T>
+void DenseUnit<T>::m_sparseInputUpdate(const Tensor<T>& delta)
+{
+    Compute::MultiplyTransposedMean(*m_sparseInput, delta,
+                                    m_sparseWeightUpdate);
+    m_optimizer->OptimizeRows(TrainableTensorMap.at("weight"),
+                              m_sparseWeightUpdate);
+}
+
+template <typename T>
+void DenseUnit<T>::SetPrecision(Compute::Precision precision)
+{
+    const auto& unitName = ComputableUnit<T>::m_unitId.UnitName;
+    if constexpr (!std::is_same_v<T, float>)
+    {
+        if (precision != Compute::Precision::Float32)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Only float units can use 16 bit or binary precision");
+    }
+    else
+    {
+        if (m_quantized)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Precision of quantized units cannot be changed");
+        if (m_sparseWeight)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Precision of sparse units cannot be changed");
+        if (m_sparseInput)
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Precision of units with sparse input cannot be changed");
+        if (IsBinarized())
+            throw std::runtime_error(
+                "Dense " + unitName +
+                " - Precision of binarized units cannot be changed");
+
+        m_float16.reset();
+        m_bfloat16.reset();
+        m_binary.reset();
+        InternalTensorMap.erase("binaryInput");
+        InternalTensorMap.erase("binaryWeight");
+
+        const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
+        const Tensor<T>& weight = TrainableTensorMap.at("weight");
+        if (precision == Compute::Precision::Float16)
+            m_float16 =
+                std::make_unique<HalfState<Float16>>(input, weight);
+        else if (precision == Compute::Precision::BFloat16)
+            m_bfloat16 =
+                std::make_unique<HalfState<BFloat16>>(input, weight);
+        else if (precision == Compute::Precision::Binary)
+        {
+            m_binary = std::make_unique<BinaryState>();
+            InternalTensorMap.emplace(
+                "binaryInput",
+                Tensor<T>(input.TensorShape, input.BatchSize, input.Device));
+            InternalTensorMap.emplace(
+                "binaryWeight",
+                Tensor<T>(Shape({ weight.TensorShape.NumCol(),
+                                  weight.TensorShape.NumRow() }),
+                          weight.Device));
+        }
+        m_convertMasterWeight();
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::Binarize()
+{
+    const auto& unitName = ComputableUnit<T>::m_unitId.UnitName;
+    if constexpr (!std::is_same_v<T, float>)
+    {
+        throw std::runtime_error("Dense " + unitName +
+                                 " - Only float units can be binarized");
+    }
+    else
+    {
+        if (IsBinarized())
+            return;
+        if (!m_binary)
+            SetPrecision(Compute::Precision::Binary);
+
+        // Float weights and the values backward multiplies are no longer
+        // read
+        TrainableTensorMap.erase("weight");
+        InternalTensorMap.erase("weightUpdateMean");
+        InternalTensorMap.erase("binaryInput");
+        InternalTensorMap.erase("binaryWeight");
+    }
+}
+
+template <typename T>
+template <typename T16>
+void DenseUnit<T>::m_halfForward(HalfState<T16>& state)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        Compute::Convert(ForwardInputMap.at(m_sourceUnitId), state.Input);
+        Compute::MultiplyAdd(state.Input, state.Weight,
+                             TrainableTensorMap.at("bias"), ForwardOutput,
+                             m_activation);
+    }
+}
+
+template <typename T>
+template <typename T16>
+void DenseUnit<T>::m_halfGradient(HalfState<T16>& state,
+                                  const Tensor<T>& delta,
+                                  Tensor<T>& backwardOutput,
+                                  Tensor<T>& weightUpdateMean)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        Compute::Multiply(delta, state.Weight, backwardOutput, false, true);
+        Compute::MultiplyTransposedMean(state.Input, delta, weightUpdateMean);
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::m_binaryGradient(const Tensor<T>& delta,
+                                    Tensor<T>& backwardOutput,
+                                    Tensor<T>& weightUpdateMean)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        const Tensor<T>& input = ForwardInputMap.at(m_sourceUnitId);
+        const Tensor<T>& weight = TrainableTensorMap.at("weight");
+        Tensor<T>& binaryInput = InternalTensorMap.at("binaryInput");
+        Tensor<T>& binaryWeight = InternalTensorMap.at("binaryWeight");
+
+        Compute::UnpackSigns(m_binary->Input, binaryInput);
+        Compute::UnpackSigns(m_binary->Weight, binaryWeight);
+        Compute::Multiply(delta, binaryWeight, backwardOutput);
+        Compute::MultiplyTransposedMean(binaryInput, delta, weightUpdateMean);
+
+        // Gradients of values whose sign saturated are cancelled
+        for (std::size_t idx = 0; idx < input.TotalElementSize(); ++idx)
+            if (std::abs(input.Data[idx]) > 1.0f)
+                backwardOutput.Data[idx] = 0.0f;
+        for (std::size_t idx = 0; idx < weight.TotalElementSize(); ++idx)
+            if (std::abs(weight.Data[idx]) > 1.0f)
+                weightUpdateMean.Data[idx] = 0.0f;
+    }
 }
 
+template <typename T>
+void DenseUnit<T>::m_gradient(const Tensor<T>& delta,
+                              Tensor<T>& backwardOutput,
+                              Tensor<T>& weightUpdateMean)
+{
+    if (m_float16)
+        m_halfGradient(*m_float16, delta, backwardOutput, weightUpdateMean);
+    else if (m_bfloat16)
+        m_halfGradient(*m_bfloat16, delta, backwardOutput, weightUpdateMean);
+    else if (m_binary)
+        m_binaryGradient(delta, backwardOutput, weightUpdateMean);
+    else
+    {
+        if (!m_kernels.BackwardOutput)
+            ResolveKernels();
+        auto backwardArguments =
+            Compute::MakeGemmArguments(delta, TrainableTensorMap.at("weight"),
+                                       backwardOutput, false, true);
+        backwardArguments.Blocking = m_kernels.BackwardOutputBlocking;
+        m_kernels.BackwardOutput(backwardArguments);
+
+        auto gradientArguments = Compute::MakeMultiplyTransposedMeanArguments(
+            ForwardInputMap.at(m_sourceUnitId), delta, weightUpdateMean);
+        gradientArguments.Blocking = m_kernels.WeightGradientBlocking;
+        m_kernels.WeightGradient(gradientArguments);
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::m_convertMasterWeight()
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        const Tensor<T>& weight = TrainableTensorMap.at("weight");
+        if (m_float16)
+            Compute::Convert(weight, m_float16->Weight);
+        if (m_bfloat16)
+            Compute::Convert(weight, m_bfloat16->Weight);
+        if (m_binary)
+            Compute::PackSigns(weight, m_binary->Weight, true);
+    }
+}
+
+template <typename T>
+void DenseUnit<T>::m_checkTrainable() const
+{
+    if (m_quantized)
+        throw std::runtime_error("Dense " +
+                                 ComputableUnit<T>::m_unitId.UnitName +
+                                 " - Quantized units cannot be trained");
+    if (m_sparseWeight)
+        throw std::runtime_error("Dense " +
+                                 ComputableUnit<T>::m_unitId.UnitName +
+                                 " - Sparse units cannot be trained");
+    if (IsBinarized())
+        throw std::runtime_error("Dense " +
+                                 ComputableUnit<T>::m_unitId.UnitName +
+                                 " - Binarized units cannot be trained");
+}
 
 template <typename T>
 void DenseUnit<T>::m_checkShape(const Shape& inputShape,
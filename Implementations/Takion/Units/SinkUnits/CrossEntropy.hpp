@@ -7,6 +7,7 @@
 #ifndef TAKION_GRAPH_CROSSENTROPY_HPP
 #define TAKION_GRAPH_CROSSENTROPY_HPP
 
+#include <Takion/Computations/Reductions/Reduction.hpp>
 #include <Takion/Units/SinkUnits/CrossEntropyDecl.hpp>
 #include <Takion/Units/UnitType.hpp>
 #include <iostream>
@@ -89,24 +90,11 @@ void CrossEntropy<T>::Forward()
 
     if (m_device.Type() == Compute::DeviceType::CPU)
     {
-        const auto lambda = [](T val)
-        {
-            return static_cast<T>(-std::log(val));
-        };
-
-        Compute::Apply(prediction, ForwardOutput, lambda);
+        Compute::Apply(prediction, ForwardOutput, Compute::NegativeLog());
         Compute::Dot(label, ForwardOutput, ForwardOutput);
 
-        const auto size = ForwardOutput.TensorShape.Size() * batchSize;
-
-        T sum = static_cast<T>(0);
-        for (std::size_t i = 0; i < size; ++i)
-        {
-            const auto output = ForwardOutput.At(i);
-            sum += output;
-        }
-
-        m_loss = sum / static_cast<T>(batchSize);
+        m_loss = Compute::ReduceAll(ForwardOutput, Compute::ReduceOp::Sum) /
+                 static_cast<T>(batchSize);
     }
 }
 
@@ -121,24 +109,11 @@ void CrossEntropy<T>::AsyncForward(std::promise<bool> promise)
 
     if (m_device.Type() == Compute::DeviceType::CPU)
     {
-        const auto lambda = [](T val)
-        {
-            return static_cast<T>(-std::log(val));
-        };
-
-        Compute::Apply(prediction, ForwardOutput, lambda);
+        Compute::Apply(prediction, ForwardOutput, Compute::NegativeLog());
         Compute::Dot(label, ForwardOutput, ForwardOutput);
 
-        const auto size = ForwardOutput.TensorShape.Size() * batchSize;
-
-        T sum = static_cast<T>(0);
-        for (std::size_t i = 0; i < size; ++i)
-        {
-            const auto output = ForwardOutput.At(i);
-            sum += output;
-        }
-
-        m_loss = sum / static_cast<T>(batchSize);
+        m_loss = Compute::ReduceAll(ForwardOutput, Compute::ReduceOp::Sum) /
+                 static_cast<T>(batchSize);
 
         promise.set_value(true);
     }
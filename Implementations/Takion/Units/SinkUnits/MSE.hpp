@@ -7,6 +7,7 @@
 #ifndef TAKION_GRAPH_MSE_HPP
 #define TAKION_GRAPH_MSE_HPP
 
+#include <Takion/Computations/Reductions/Reduction.hpp>
 #include <Takion/Units/SinkUnits/MSEDecl.hpp>
 #include <Takion/Units/UnitType.hpp>
 
@@ -88,15 +89,8 @@ void MSELoss<T>::Forward()
     Compute::Dot(outputTensor, outputTensor);
     Compute::ScalarDiv(outputTensor, static_cast<T>(2));
 
-    const auto size = ForwardOutput.TensorShape.Size() * batchSize;
-    T sum = static_cast<T>(0);
-    for (std::size_t i = 0; i < size; ++i)
-    {
-        const auto output = outputTensor.At(i);
-        sum += output;
-    }
-
-    m_loss = sum / static_cast<T>(batchSize);
+    m_loss = Compute::ReduceAll(outputTensor, Compute::ReduceOp::Sum) /
+             static_cast<T>(batchSize);
 }
 
 template <typename T>
@@ -113,15 +107,8 @@ void MSELoss<T>::AsyncForward(std::promise<bool> promise)
     Compute::Dot(outputTensor, outputTensor);
     Compute::ScalarDiv(outputTensor, static_cast<T>(2));
 
-    const auto size = ForwardOutput.TensorShape.Size() * batchSize;
-    T sum = static_cast<T>(0);
-    for (std::size_t i = 0; i < size; ++i)
-    {
-        const auto output = outputTensor.At(i);
-        sum += output;
-    }
-
-    m_loss = sum / static_cast<T>(batchSize);
+    m_loss = Compute::ReduceAll(outputTensor, Compute::ReduceOp::Sum) /
+             static_cast<T>(batchSize);
     std::cout << "Loss : " << m_loss << std::endl;
 
     promise.set_value(true);
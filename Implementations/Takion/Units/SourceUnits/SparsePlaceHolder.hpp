@@ -0,0 +1,98 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef TAKION_GRAPH_SPARSEPLACEHOLDER_HPP
+#define TAKION_GRAPH_SPARSEPLACEHOLDER_HPP
+
+#include <Takion/Units/SourceUnits/SparsePlaceHolderDecl.hpp>
+#include <algorithm>
+
+namespace Takion::Graph
+{
+template <typename T>
+SparsePlaceHolder<T>::SparsePlaceHolder(
+    const UnitId& unitId, Tensor<T> forwardOutput,
+    std::unique_ptr<Util::SparseLoader<T>> loader, std::size_t numFeatures,
+    std::size_t batchSize)
+    : ComputableUnit<T>(unitId, {}, {}, forwardOutput, {}, {}, batchSize),
+      m_loader(std::move(loader)),
+      m_output(std::make_shared<Compute::CsrMatrix<T>>()),
+      m_numFeatures(numFeatures)
+{
+}
+
+template <typename T>
+SparsePlaceHolder<T> SparsePlaceHolder<T>::CreateUnit(
+    const FrontEnd::UnitMetaData<T>& unitMetaData,
+    std::unique_ptr<Util::SparseLoader<T>> loader)
+{
+    const auto unitId = unitMetaData.Id();
+    const auto shape = unitMetaData.GetOutputShape();
+    const auto batchSize = unitMetaData.BatchSize();
+    const auto device = unitMetaData.Device;
+
+    if (device.Type() != Compute::DeviceType::CPU)
+        throw std::runtime_error(
+            "CreateUnit - Device type of placeHolder must be CPU");
+
+    Tensor<T> state(Shape({ 1 }), batchSize, device);
+    return SparsePlaceHolder<T>(unitId, state, std::move(loader),
+                                shape.Size(), batchSize);
+}
+
+template <typename T>
+void SparsePlaceHolder<T>::Forward()
+{
+    auto batch = (*m_loader)();
+    const auto numNonZeros = batch.Values.size();
+    if (batch.RowOffsets.empty() || batch.NumCol != m_numFeatures ||
+        batch.NumRow() != ForwardOutput.BatchSize ||
+        batch.Columns.size() != numNonZeros ||
+        batch.RowOffsets.front() != 0 ||
+        batch.RowOffsets.back() != numNonZeros ||
+        !std::is_sorted(batch.RowOffsets.begin(), batch.RowOffsets.end()))
+    {
+        const std::string errorMessage =
+            std::string("Loaded sparse batch mismatches expected size ") +
+            "Given rows : " + std::to_string(batch.NumRow()) +
+            " columns : " + std::to_string(batch.NumCol) +
+            " Expected rows : " + std::to_string(ForwardOutput.BatchSize) +
+            " columns : " + std::to_string(m_numFeatures);
+        throw std::runtime_error(errorMessage);
+    }
+
+    for (const auto column : batch.Columns)
+        if (column >= m_numFeatures)
+            throw std::runtime_error(
+                "Loaded sparse batch has feature index " +
+                std::to_string(column) + " out of range " +
+                std::to_string(m_numFeatures));
+
+    *m_output = std::move(batch);
+}
+
+template <typename T>
+void SparsePlaceHolder<T>::AsyncForward(std::promise<bool> promise)
+{
+    Forward();
+    promise.set_value(true);
+}
+
+template <typename T>
+void SparsePlaceHolder<T>::Backward()
+{
+    // Do nothing
+}
+
+template <typename T>
+void SparsePlaceHolder<T>::AsyncBackward(std::promise<bool> promise)
+{
+    // Do nothing
+    promise.set_value(true);
+}
+}
+
+#endif
@@ -0,0 +1,145 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/BinaryGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <stdexcept>
+
+namespace Takion::Compute::CPU::Binary
+{
+using namespace Util;
+
+namespace
+{
+//! Number of columns of transposed input packed by each thread
+constexpr std::size_t PackColumnBlock = 64;
+
+//! Returns the bit of value in a packed word
+std::uint64_t SignBit(float value)
+{
+    return value < 0.0f ? 1 : 0;
+}
+
+void PackRows(const float* input, BinaryMatrix& out, std::size_t ldInput)
+{
+    const auto numCol = out.NumCol;
+    const auto numWords = out.NumWords();
+
+#pragma omp parallel for schedule(static) default(shared)
+    for (long row = 0; row < static_cast<long>(out.NumRow); ++row)
+    {
+        const auto* src = input + row * ldInput;
+        auto* words = out.Words.data() + row * numWords;
+        float sum = 0.0f;
+        for (std::size_t word = 0; word < numWords; ++word)
+        {
+            const auto begin = word * BinaryMatrix::WordBits;
+            const auto end = std::min(numCol, begin + BinaryMatrix::WordBits);
+            std::uint64_t bits = 0;
+            for (std::size_t col = begin; col < end; ++col)
+            {
+                bits |= SignBit(src[col]) << (col - begin);
+                sum += std::abs(src[col]);
+            }
+            words[word] = bits;
+        }
+        out.Scale[row] = numCol ? sum / static_cast<float>(numCol) : 0.0f;
+    }
+}
+
+//! Packs column c of numRow x numCol input into row c of out
+//! Input is read row by row, and columns are split into blocks over threads
+void PackColumns(const float* input, BinaryMatrix& out, std::size_t numRow,
+                 std::size_t numCol, std::size_t ldInput)
+{
+    const auto numWords = out.NumWords();
+    const auto numBlocks = (numCol + PackColumnBlock - 1) / PackColumnBlock;
+    std::fill(out.Words.begin(), out.Words.end(), 0);
+
+#pragma omp parallel for schedule(static) default(shared)
+    for (long blockIdx = 0; blockIdx < static_cast<long>(numBlocks);
+         ++blockIdx)
+    {
+        const auto begin = PackColumnBlock * blockIdx;
+        const auto end = std::min(numCol, begin + PackColumnBlock);
+        float sum[PackColumnBlock] = {};
+        for (std::size_t row = 0; row < numRow; ++row)
+        {
+            const auto* src = input + row * ldInput;
+            const auto word = row / BinaryMatrix::WordBits;
+            const auto shift = row % BinaryMatrix::WordBits;
+            for (std::size_t col = begin; col < end; ++col)
+            {
+                out.Words[col * numWords + word] |= SignBit(src[col]) << shift;
+                sum[col - begin] += std::abs(src[col]);
+            }
+        }
+        for (std::size_t col = begin; col < end; ++col)
+            out.Scale[col] =
+                numRow ? sum[col - begin] / static_cast<float>(numRow) : 0.0f;
+    }
+}
+} // namespace
+
+void PackSignsCpu(const Span<float> input, BinaryMatrix& out,
+                  std::size_t numRow, std::size_t numCol,
+                  std::size_t ldInput, bool transpose)
+{
+    out.NumRow = transpose ? numCol : numRow;
+    out.NumCol = transpose ? numRow : numCol;
+    out.Words.resize(out.NumRow * out.NumWords());
+    out.Scale.resize(out.NumRow);
+
+    if (transpose)
+        PackColumns(input.Base(), out, numRow, numCol, ldInput);
+    else
+        PackRows(input.Base(), out, ldInput);
+}
+
+void UnpackSignsCpu(const BinaryMatrix& input, Span<float> out,
+                    std::size_t ldOut)
+{
+    const auto numWords = input.NumWords();
+
+#pragma omp parallel for schedule(static) default(shared)
+    for (long row = 0; row < static_cast<long>(input.NumRow); ++row)
+    {
+        const auto* words = input.Words.data() + row * numWords;
+        const auto scale = input.Scale[row];
+        auto* dst = out.Address(row * ldOut);
+        for (std::size_t col = 0; col < input.NumCol; ++col)
+        {
+            const auto bit = (words[col / BinaryMatrix::WordBits] >>
+                              (col % BinaryMatrix::WordBits)) &
+                             1;
+            dst[col] = bit ? -scale : scale;
+        }
+    }
+}
+
+void MultiplyAddCpu(const BinaryMatrix& inputA, const BinaryMatrix& inputB,
+                    const Span<float> bias, Span<float> out,
+                    std::size_t ldOut, ActivationType activation)
+{
+    if (inputA.NumCol != inputB.NumCol)
+        throw std::invalid_argument(
+            "Binary matrices should have the same number of columns");
+
+    BinaryEpilogue epilogue;
+    epilogue.RowScale = inputA.Scale.data();
+    epilogue.ColumnScale = inputB.Scale.data();
+    epilogue.Bias = bias.Base();
+    epilogue.Activation = activation;
+
+    Int::GetKernelTable().BinaryGemm(
+        inputA.NumRow, inputB.NumRow, inputA.NumCol, inputA.Words.data(),
+        inputB.Words.data(), inputA.NumWords(), out.Address(0), ldOut, true,
+        epilogue);
+}
+} // namespace Takion::Compute::CPU::Binary
@@ -0,0 +1,152 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/CsrGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace Takion::Compute::CPU
+{
+namespace
+{
+template <typename T>
+void CsrMultiplyAdd(const KernelTable<T>& kernels, const CsrMatrix<T>& A,
+                    const T* B, const T* C, T* out, std::size_t m,
+                    std::size_t n, std::size_t ldB, std::size_t ldOut,
+                    bool broadCastC, ActivationType activation, T scale)
+{
+    GemmEpilogue<T> epilogue;
+    epilogue.Bias = C;
+    epilogue.BiasRowStride = ldOut;
+    epilogue.Scale = scale;
+    epilogue.Activation = activation;
+
+    const auto numRow = A.NumRow();
+    const auto* rowOffsets = A.RowOffsets.data();
+
+    // Every row of A is computed on its own, so matrices are only split if
+    // a shared C has several rows
+    if (!C || !broadCastC || m == 1)
+    {
+        if (broadCastC)
+            epilogue.BiasRowStride = 0;
+        kernels.CsrGemm(numRow, n, rowOffsets, A.Columns.data(),
+                        A.Values.data(), B, ldB, out, ldOut, true, epilogue);
+        return;
+    }
+
+    for (std::size_t row = 0; row < numRow; row += m)
+        kernels.CsrGemm(m, n, rowOffsets + row, A.Columns.data(),
+                        A.Values.data(), B, ldB, out + row * ldOut, ldOut,
+                        true, epilogue);
+}
+
+template <typename T>
+void CsrMultiplyTransposedMean(const KernelTable<T>& kernels,
+                               const CsrMatrix<T>& A, const T* B,
+                               std::size_t n, std::size_t ldB,
+                               std::size_t batchSize, RowSparseMatrix<T>& out)
+{
+    const auto numRow = A.NumRow();
+    const auto numNonZeros = A.NumNonZeros();
+    if (numRow > std::numeric_limits<std::uint32_t>::max())
+        throw std::invalid_argument(
+            "Sparse matrix should have less than 2^32 rows");
+
+    // Elements of A sorted by column are the rows of A^T. Only the columns
+    // holding non-zero elements become rows of out
+    std::vector<std::uint32_t> rowOf(numNonZeros);
+    for (std::size_t row = 0; row < numRow; ++row)
+        std::fill(rowOf.begin() + A.RowOffsets[row],
+                  rowOf.begin() + A.RowOffsets[row + 1],
+                  static_cast<std::uint32_t>(row));
+
+    std::vector<std::size_t> order(numNonZeros);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&A](std::size_t lhs, std::size_t rhs) {
+                         return A.Columns[lhs] < A.Columns[rhs];
+                     });
+
+    CsrMatrix<T> transposed;
+    transposed.NumCol = numRow;
+    transposed.Columns.reserve(numNonZeros);
+    transposed.Values.reserve(numNonZeros);
+    out.NumRow = A.NumCol;
+    out.NumCol = n;
+    out.Rows.clear();
+    for (std::size_t idx = 0; idx < numNonZeros; ++idx)
+    {
+        const auto column = A.Columns[order[idx]];
+        if (out.Rows.empty() || out.Rows.back() != column)
+        {
+            if (!out.Rows.empty())
+                transposed.RowOffsets.emplace_back(idx);
+            out.Rows.emplace_back(column);
+        }
+        transposed.Columns.emplace_back(rowOf[order[idx]]);
+        transposed.Values.emplace_back(A.Values[order[idx]]);
+    }
+    if (!out.Rows.empty())
+        transposed.RowOffsets.emplace_back(numNonZeros);
+
+    GemmEpilogue<T> epilogue;
+    epilogue.Scale = static_cast<T>(1) / static_cast<T>(batchSize);
+
+    out.Values.resize(out.Rows.size() * n);
+    kernels.CsrGemm(out.Rows.size(), n, transposed.RowOffsets.data(),
+                    transposed.Columns.data(), transposed.Values.data(), B,
+                    ldB, out.Values.data(), n, true, epilogue);
+}
+} // namespace
+
+void Float::CsrMultiplyAddCpu(const CsrMatrix<float>& inputA,
+                              const Span<float> inputB,
+                              const Span<float> inputC, Span<float> out,
+                              std::size_t m, std::size_t n, std::size_t ldB,
+                              std::size_t ldOut, bool broadCastC,
+                              ActivationType activation, float scale)
+{
+    CsrMultiplyAdd(Float::GetKernelTable(), inputA, inputB.Base(),
+                   inputC.Base(), out.Address(0), m, n, ldB, ldOut,
+                   broadCastC, activation, scale);
+}
+
+void Float::CsrMultiplyTransposedMeanCpu(const CsrMatrix<float>& inputA,
+                                         const Span<float> inputB,
+                                         std::size_t n, std::size_t ldB,
+                                         std::size_t batchSize,
+                                         RowSparseMatrix<float>& out)
+{
+    CsrMultiplyTransposedMean(Float::GetKernelTable(), inputA, inputB.Base(),
+                              n, ldB, batchSize, out);
+}
+
+void Double::CsrMultiplyAddCpu(const CsrMatrix<double>& inputA,
+                               const Span<double> inputB,
+                               const Span<double> inputC, Span<double> out,
+                               std::size_t m, std::size_t n, std::size_t ldB,
+                               std::size_t ldOut, bool broadCastC,
+                               ActivationType activation, double scale)
+{
+    CsrMultiplyAdd(Double::GetKernelTable(), inputA, inputB.Base(),
+                   inputC.Base(), out.Address(0), m, n, ldB, ldOut,
+                   broadCastC, activation, scale);
+}
+
+void Double::CsrMultiplyTransposedMeanCpu(const CsrMatrix<double>& inputA,
+                                          const Span<double> inputB,
+                                          std::size_t n, std::size_t ldB,
+                                          std::size_t batchSize,
+                                          RowSparseMatrix<double>& out)
+{
+    CsrMultiplyTransposedMean(Double::GetKernelTable(), inputA,
+                              inputB.Base(), n, ldB, batchSize, out);
+}
+} // namespace Takion::Compute::CPU
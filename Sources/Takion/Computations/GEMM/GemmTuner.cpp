@@ -0,0 +1,285 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/GemmTuner.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace Takion::Compute
+{
+namespace
+{
+using CPU::GemmBlocking;
+using CPU::GemmEpilogue;
+using CPU::InstructionSet;
+using CPU::KernelTable;
+
+constexpr const char* CacheHeader = "# Takion GEMM tuning cache v1";
+constexpr int BenchmarkRuns = 3;
+
+template <typename T>
+const KernelTable<T>& TableOf(InstructionSet isa)
+{
+    if constexpr (std::is_same_v<T, float>)
+        return CPU::Float::GetKernelTable(isa);
+    else if constexpr (std::is_same_v<T, double>)
+        return CPU::Double::GetKernelTable(isa);
+    else
+        return CPU::Int::GetKernelTable(isa);
+}
+
+//! Returns seconds taken by the fastest of BenchmarkRuns GEMMs of key with
+//! given blocking, after a run that warms up caches and scratch buffers
+template <typename T>
+double Benchmark(const GemmTuningKey& key, const GemmBlocking& blocking)
+{
+    const bool transposeA = key.Layout == KernelLayout::TransposeA ||
+                            key.Layout == KernelLayout::TransposeAB;
+    const bool transposeB = key.Layout == KernelLayout::TransposeB ||
+                            key.Layout == KernelLayout::TransposeAB;
+    const auto m = key.M;
+    const auto n = key.N;
+    const auto k = key.K;
+
+    const std::vector<T> A(m * k, static_cast<T>(1));
+    const std::vector<T> B(k * n, static_cast<T>(1));
+    std::vector<T> out(m * n);
+
+    const auto& kernels = TableOf<T>(key.Isa);
+    auto run = [&]() {
+        kernels.Gemm(m, n, k, A.data(), transposeA ? 1 : k,
+                     transposeA ? m : 1, B.data(), transposeB ? 1 : n,
+                     transposeB ? k : 1, out.data(), n, false, true,
+                     GemmEpilogue<T>(), blocking);
+    };
+
+    run();
+    auto best = std::numeric_limits<double>::max();
+    for (int i = 0; i < BenchmarkRuns; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+double Benchmark(const GemmTuningKey& key, const GemmBlocking& blocking)
+{
+    switch (key.Type)
+    {
+        case DataType::Float32:
+            return Benchmark<float>(key, blocking);
+        case DataType::Float64:
+            return Benchmark<double>(key, blocking);
+        case DataType::Int32:
+            return Benchmark<int>(key, blocking);
+        default:
+            throw std::runtime_error("Not implemented");
+    }
+}
+
+//! Blocks larger than the matrix are clamped to it, so candidates that only
+//! differ beyond the dimensions of key run identically
+GemmBlocking Clamp(const GemmTuningKey& key, const GemmBlocking& blocking)
+{
+    return { std::min(blocking.MC, key.M), std::min(blocking.KC, key.K),
+             std::min(blocking.NC, key.N) };
+}
+
+std::runtime_error CacheError(const std::string& path, const std::string& line)
+{
+    return std::runtime_error("Malformed GEMM tuning cache " + path +
+                              " at line: " + line);
+}
+} // namespace
+
+GemmTuner& GemmTuner::Get()
+{
+    static GemmTuner tuner;
+    return tuner;
+}
+
+GemmTuner::GemmTuner()
+{
+    const char* enabled = std::getenv("TAKION_GEMM_TUNING");
+    m_enabled = enabled != nullptr && std::string(enabled) == "1";
+
+    const char* path = std::getenv("TAKION_GEMM_TUNING_CACHE");
+    if (path != nullptr && *path != '\0')
+        SetCachePath(path);
+}
+
+void GemmTuner::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enabled;
+}
+
+bool GemmTuner::IsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_enabled;
+}
+
+void GemmTuner::SetCachePath(const std::string& path)
+{
+    if (!path.empty())
+        Load(path);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cachePath = path;
+}
+
+std::string GemmTuner::CachePath() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cachePath;
+}
+
+CPU::GemmBlocking GemmTuner::Resolve(const GemmTuningKey& key)
+{
+    if (const auto blocking = Find(key))
+        return *blocking;
+    if (!IsEnabled())
+        return GemmBlocking();
+
+    const auto blocking = Tune(key);
+    const auto path = CachePath();
+    if (!path.empty())
+        Save(path);
+    return blocking;
+}
+
+CPU::GemmBlocking GemmTuner::Tune(const GemmTuningKey& key)
+{
+    GemmBlocking best;
+    if (key.Isa <= CPU::DetectInstructionSet() && key.M > 0 && key.N > 0 &&
+        key.K > 0)
+    {
+        std::vector<GemmBlocking> benchmarked;
+        auto bestTime = std::numeric_limits<double>::max();
+        for (const auto& candidate : Candidates())
+        {
+            const auto clamped = Clamp(key, candidate);
+            if (std::find(benchmarked.begin(), benchmarked.end(), clamped) !=
+                benchmarked.end())
+                continue;
+            benchmarked.emplace_back(clamped);
+
+            const auto time = Benchmark(key, candidate);
+            if (time < bestTime)
+            {
+                bestTime = time;
+                best = candidate;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blockings[key] = best;
+    return best;
+}
+
+std::optional<CPU::GemmBlocking> GemmTuner::Find(
+    const GemmTuningKey& key) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_blockings.find(key);
+    if (it == m_blockings.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void GemmTuner::Load(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return;
+
+    std::unordered_map<GemmTuningKey, GemmBlocking, GemmTuningKeyHash>
+        blockings;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        std::istringstream stream(line);
+        int type = 0;
+        std::string isa;
+        int layout = 0;
+        GemmTuningKey key;
+        GemmBlocking blocking;
+        if (!(stream >> type >> isa >> layout >> key.M >> key.N >> key.K >>
+              blocking.MC >> blocking.KC >> blocking.NC) ||
+            type < 0 || type >= static_cast<int>(DataType::Unsupported) ||
+            layout < 0 ||
+            layout > static_cast<int>(KernelLayout::TransposeAB))
+            throw CacheError(path, line);
+
+        try
+        {
+            key.Isa = CPU::ToInstructionSet(isa);
+        }
+        catch (const std::invalid_argument&)
+        {
+            throw CacheError(path, line);
+        }
+        key.Type = static_cast<DataType>(type);
+        key.Layout = static_cast<KernelLayout>(layout);
+        blockings[key] = blocking;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [key, blocking] : blockings)
+        m_blockings[key] = blocking;
+}
+
+void GemmTuner::Save(const std::string& path) const
+{
+    std::ostringstream stream;
+    stream << CacheHeader << '\n'
+           << "# type isa layout M N K MC KC NC\n";
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [key, blocking] : m_blockings)
+            stream << static_cast<int>(key.Type) << ' '
+                   << CPU::ToString(key.Isa) << ' '
+                   << static_cast<int>(key.Layout) << ' ' << key.M << ' '
+                   << key.N << ' ' << key.K << ' ' << blocking.MC << ' '
+                   << blocking.KC << ' ' << blocking.NC << '\n';
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!(file << stream.str()))
+        throw std::runtime_error("Failed to write GEMM tuning cache " + path);
+}
+
+void GemmTuner::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blockings.clear();
+}
+
+std::vector<CPU::GemmBlocking> GemmTuner::Candidates()
+{
+    std::vector<GemmBlocking> candidates;
+    for (const std::size_t mc : { 48, 96, 168, 240, 336 })
+        for (const std::size_t kc : { 128, 256, 384, 512 })
+            for (const std::size_t nc : { 1024, 2048, 4096 })
+                candidates.push_back({ mc, kc, nc });
+    return candidates;
+}
+} // namespace Takion::Compute
@@ -0,0 +1,338 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/HalfGemm.hpp>
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Utils/Span.hpp>
+#include <omp.h>
+#include <type_traits>
+#include <vector>
+
+namespace Takion::Compute::CPU::Half
+{
+using namespace Util;
+
+namespace
+{
+//! 16 bit type of a pair of GEMM operands
+template <typename TA, typename TB>
+using StorageType = std::conditional_t<IsHalfPrecisionV<TA>, TA, TB>;
+
+template <typename TA, typename TB>
+void Gemm(std::size_t m, std::size_t n, std::size_t k, const TA* A,
+          std::size_t rowStrideA, std::size_t colStrideA, const TB* B,
+          std::size_t rowStrideB, std::size_t colStrideB, float* C,
+          std::size_t ldc, bool parallel, const GemmEpilogue<float>& epilogue)
+{
+    static_assert(IsHalfPrecisionV<TA> || IsHalfPrecisionV<TB>,
+                  "One of the operands should be stored in a 16 bit type");
+    const auto& kernels = Float::GetHalfKernelTable<StorageType<TA, TB>>();
+    const GemmBlocking blocking;
+
+    if constexpr (std::is_same_v<TA, float>)
+        kernels.GemmFloatA(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                           colStrideB, C, ldc, false, parallel, epilogue,
+                           blocking);
+    else if constexpr (std::is_same_v<TB, float>)
+        kernels.GemmFloatB(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                           colStrideB, C, ldc, false, parallel, epilogue,
+                           blocking);
+    else
+        kernels.Gemm(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                     colStrideB, C, ldc, false, parallel, epilogue, blocking);
+}
+
+//! Multiplies numMatrices pairs of m x k and k x n matrices
+//! (see Gemm in KernelRegistry.cpp)
+//! Products are always computed in float. 16 bit outputs are computed into
+//! a float buffer first, and rounded once every matrix is done
+template <typename TA, typename TB, typename TOut>
+void MultiplyMatrices(std::size_t m, std::size_t n, std::size_t k,
+                      const TA* A, std::size_t rowStrideA,
+                      std::size_t colStrideA, std::size_t strideA,
+                      const TB* B, std::size_t rowStrideB,
+                      std::size_t colStrideB, std::size_t strideB, TOut* out,
+                      std::size_t ldc, std::size_t numMatrices,
+                      const GemmEpilogue<float>& epilogue,
+                      std::size_t strideBias)
+{
+    const auto sizeDest = m * ldc;
+    const bool parallelMatrices =
+        numMatrices >= static_cast<std::size_t>(omp_get_max_threads());
+
+    std::vector<float> buffer;
+    float* dest = nullptr;
+    if constexpr (std::is_same_v<TOut, float>)
+        dest = out;
+    else
+    {
+        buffer.resize(sizeDest * numMatrices);
+        dest = buffer.data();
+    }
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelMatrices)
+    for (long matIdx = 0; matIdx < static_cast<long>(numMatrices); ++matIdx)
+    {
+        auto matEpilogue = epilogue;
+        if (epilogue.Bias)
+            matEpilogue.Bias = epilogue.Bias + strideBias * matIdx;
+
+        Gemm(m, n, k, A + strideA * matIdx, rowStrideA, colStrideA,
+             B + strideB * matIdx, rowStrideB, colStrideB,
+             dest + sizeDest * matIdx, ldc, !parallelMatrices, matEpilogue);
+    }
+
+    if constexpr (!std::is_same_v<TOut, float>)
+        Float::GetHalfKernelTable<TOut>().FromFloat(
+            dest, out, 1, sizeDest * numMatrices, 0, 0);
+}
+} // namespace
+
+template <typename TA, typename TB, typename TOut>
+void MultiplyCpu(const Span<TA> inputA, const Span<TB> inputB,
+                 Span<TOut> out, std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastA, bool broadCastB,
+                 bool transposeA, bool transposeB)
+{
+    const auto rowStrideA = transposeA ? 1 : ldA;
+    const auto colStrideA = transposeA ? ldA : 1;
+    const auto rowStrideB = transposeB ? 1 : ldB;
+    const auto colStrideB = transposeB ? ldB : 1;
+    const auto sizeA = (transposeA ? k : m) * ldA;
+    const auto sizeB = (transposeB ? n : k) * ldB;
+
+    // Rows of A are contiguous over the batch, so it is folded into the row
+    // dimension (see Gemm in KernelRegistry.cpp)
+    if (broadCastB && !broadCastA && !transposeA)
+    {
+        MultiplyMatrices(m * numMatrices, n, k, inputA.Address(0), rowStrideA,
+                         colStrideA, 0, inputB.Address(0), rowStrideB,
+                         colStrideB, 0, out.Address(0), ldOut, 1,
+                         GemmEpilogue<float>(), 0);
+        return;
+    }
+
+    MultiplyMatrices(m, n, k, inputA.Address(0), rowStrideA, colStrideA,
+                     broadCastA ? 0 : sizeA, inputB.Address(0), rowStrideB,
+                     colStrideB, broadCastB ? 0 : sizeB, out.Address(0), ldOut,
+                     numMatrices, GemmEpilogue<float>(), 0);
+}
+
+template <typename TA, typename TB, typename TOut>
+void MultiplyAddCpu(const Span<TA> inputA, const Span<TB> inputB,
+                    const Span<TOut> inputC, Span<TOut> out, std::size_t m,
+                    std::size_t n, std::size_t k, std::size_t ldA,
+                    std::size_t ldB, std::size_t ldOut,
+                    std::size_t numMatrices, bool broadCastA, bool broadCastB,
+                    bool broadCastC, ActivationType activation, float scale)
+{
+    const auto sizeOut = m * ldOut;
+
+    // Epilogue adds float bias, so 16 bit C is converted once up front
+    std::vector<float> bias;
+    const float* biasPtr = nullptr;
+    if constexpr (std::is_same_v<TOut, float>)
+        biasPtr = inputC.Address(0);
+    else
+    {
+        bias.resize(broadCastC ? sizeOut : sizeOut * numMatrices);
+        Float::GetHalfKernelTable<TOut>().ToFloat(
+            inputC.Address(0), bias.data(), 1, bias.size(), 0, 0);
+        biasPtr = bias.data();
+    }
+
+    GemmEpilogue<float> epilogue;
+    epilogue.Bias = biasPtr;
+    epilogue.BiasRowStride = ldOut;
+    epilogue.Scale = scale;
+    epilogue.Activation = activation;
+
+    // A shared C lines up with rows of the folded output only if it has a
+    // single row (see Gemm in KernelRegistry.cpp)
+    if (broadCastB && !broadCastA && (!broadCastC || m == 1))
+    {
+        epilogue.BiasRowStride = broadCastC ? 0 : ldOut;
+        MultiplyMatrices(m * numMatrices, n, k, inputA.Address(0), ldA, 1, 0,
+                         inputB.Address(0), ldB, 1, 0, out.Address(0), ldOut,
+                         1, epilogue, 0);
+        return;
+    }
+
+    MultiplyMatrices(m, n, k, inputA.Address(0), ldA, 1,
+                     broadCastA ? 0 : m * ldA, inputB.Address(0), ldB, 1,
+                     broadCastB ? 0 : k * ldB, out.Address(0), ldOut,
+                     numMatrices, epilogue, broadCastC ? 0 : sizeOut);
+}
+
+template <typename TA, typename TB, typename TOut>
+void MultiplyTransposedMeanCpu(const Span<TA> inputA, const Span<TB> inputB,
+                               Span<TOut> out, std::size_t m, std::size_t n,
+                               std::size_t k, std::size_t ldA,
+                               std::size_t ldB, std::size_t ldOut,
+                               std::size_t batchSize)
+{
+    GemmEpilogue<float> epilogue;
+    epilogue.Scale = 1.0f / static_cast<float>(batchSize);
+    MultiplyMatrices(m, n, k, inputA.Address(0), 1, ldA, 0, inputB.Address(0),
+                     ldB, 1, 0, out.Address(0), ldOut, 1, epilogue, 0);
+}
+
+template <typename TIn, typename TOut>
+void ConvertCpu(const Span<TIn> input, Span<TOut> out, std::size_t numRow,
+                std::size_t numCol, std::size_t ldInput, std::size_t ldOut)
+{
+    if constexpr (std::is_same_v<TIn, float>)
+        Float::GetHalfKernelTable<TOut>().FromFloat(
+            input.Address(0), out.Address(0), numRow, numCol, ldInput, ldOut);
+    else
+        Float::GetHalfKernelTable<TIn>().ToFloat(
+            input.Address(0), out.Address(0), numRow, numCol, ldInput, ldOut);
+}
+
+template <typename T16>
+void AddCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB)
+{
+    Float::GetHalfKernelTable<T16>().Add(
+        inputA.Address(0), inputB.Address(0), out.Address(0), size, batchSize,
+        broadCastA ? 0 : size, broadCastB ? 0 : size);
+}
+
+template <typename T16>
+void SubCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB)
+{
+    Float::GetHalfKernelTable<T16>().Sub(
+        inputA.Address(0), inputB.Address(0), out.Address(0), size, batchSize,
+        broadCastA ? 0 : size, broadCastB ? 0 : size);
+}
+
+template <typename T16>
+void DotCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB)
+{
+    Float::GetHalfKernelTable<T16>().Dot(
+        inputA.Address(0), inputB.Address(0), out.Address(0), size, batchSize,
+        broadCastA ? 0 : size, broadCastB ? 0 : size);
+}
+
+template <typename T16>
+void DivCpu(const Span<T16> inputA, const Span<T16> inputB, Span<T16> out,
+            std::size_t size, std::size_t batchSize, bool broadCastA,
+            bool broadCastB)
+{
+    Float::GetHalfKernelTable<T16>().Div(
+        inputA.Address(0), inputB.Address(0), out.Address(0), size, batchSize,
+        broadCastA ? 0 : size, broadCastB ? 0 : size);
+}
+
+template <typename T16>
+void ScalarMulCpu(const Span<T16> input, float toMul, Span<T16> out,
+                  std::size_t size, std::size_t batchSize)
+{
+    Float::GetHalfKernelTable<T16>().ScalarMul(input.Address(0), toMul,
+                                               out.Address(0), size,
+                                               batchSize);
+}
+
+template <typename T16>
+void ScalarDivCpu(const Span<T16> input, float toDiv, Span<T16> out,
+                  std::size_t size, std::size_t batchSize)
+{
+    Float::GetHalfKernelTable<T16>().ScalarDiv(input.Address(0), toDiv,
+                                               out.Address(0), size,
+                                               batchSize);
+}
+
+template <typename T16>
+void SetCpu(Span<T16> data, float toSet, std::size_t size,
+            std::size_t batchSize)
+{
+    Float::GetHalfKernelTable<T16>().Set(data.Address(0), toSet, size,
+                                         batchSize);
+}
+
+template <typename T16>
+void ApplyCpu(const Span<T16> input, Span<T16> out, std::size_t size,
+              std::size_t batchSize, MathFunction function)
+{
+    Float::GetHalfKernelTable<T16>().Math(input.Address(0), out.Address(0),
+                                          size, batchSize, function);
+}
+
+#define TAKION_INSTANTIATE_HALF(T16)                                          \
+    template void MultiplyCpu<T16, T16, float>(                               \
+        const Span<T16>, const Span<T16>, Span<float>, std::size_t,           \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t, bool, bool, bool, bool);                                 \
+    template void MultiplyCpu<T16, T16, T16>(                                 \
+        const Span<T16>, const Span<T16>, Span<T16>, std::size_t,             \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t, bool, bool, bool, bool);                                 \
+    template void MultiplyCpu<float, T16, float>(                             \
+        const Span<float>, const Span<T16>, Span<float>, std::size_t,         \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t, bool, bool, bool, bool);                                 \
+    template void MultiplyCpu<T16, float, float>(                             \
+        const Span<T16>, const Span<float>, Span<float>, std::size_t,         \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t, bool, bool, bool, bool);                                 \
+    template void MultiplyAddCpu<T16, T16, float>(                            \
+        const Span<T16>, const Span<T16>, const Span<float>, Span<float>,     \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t, std::size_t, bool, bool, bool, ActivationType, float);   \
+    template void MultiplyAddCpu<T16, T16, T16>(                              \
+        const Span<T16>, const Span<T16>, const Span<T16>, Span<T16>,         \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t, std::size_t, bool, bool, bool, ActivationType, float);   \
+    template void MultiplyTransposedMeanCpu<T16, T16, float>(                 \
+        const Span<T16>, const Span<T16>, Span<float>, std::size_t,           \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t);                                                         \
+    template void MultiplyTransposedMeanCpu<T16, T16, T16>(                   \
+        const Span<T16>, const Span<T16>, Span<T16>, std::size_t,             \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t);                                                         \
+    template void MultiplyTransposedMeanCpu<T16, float, float>(               \
+        const Span<T16>, const Span<float>, Span<float>, std::size_t,         \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t);                                                         \
+    template void MultiplyTransposedMeanCpu<float, T16, float>(               \
+        const Span<float>, const Span<T16>, Span<float>, std::size_t,         \
+        std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,      \
+        std::size_t);                                                         \
+    template void ConvertCpu<T16, float>(                                     \
+        const Span<T16>, Span<float>, std::size_t, std::size_t, std::size_t,  \
+        std::size_t);                                                         \
+    template void ConvertCpu<float, T16>(                                     \
+        const Span<float>, Span<T16>, std::size_t, std::size_t, std::size_t,  \
+        std::size_t);                                                         \
+    template void AddCpu<T16>(const Span<T16>, const Span<T16>, Span<T16>,    \
+                              std::size_t, std::size_t, bool, bool);          \
+    template void SubCpu<T16>(const Span<T16>, const Span<T16>, Span<T16>,    \
+                              std::size_t, std::size_t, bool, bool);          \
+    template void DotCpu<T16>(const Span<T16>, const Span<T16>, Span<T16>,    \
+                              std::size_t, std::size_t, bool, bool);          \
+    template void DivCpu<T16>(const Span<T16>, const Span<T16>, Span<T16>,    \
+                              std::size_t, std::size_t, bool, bool);          \
+    template void ScalarMulCpu<T16>(const Span<T16>, float, Span<T16>,        \
+                                    std::size_t, std::size_t);                \
+    template void ScalarDivCpu<T16>(const Span<T16>, float, Span<T16>,        \
+                                    std::size_t, std::size_t);                \
+    template void SetCpu<T16>(Span<T16>, float, std::size_t, std::size_t);    \
+    template void ApplyCpu<T16>(const Span<T16>, Span<T16>, std::size_t,      \
+                                std::size_t, MathFunction);
+
+TAKION_INSTANTIATE_HALF(Float16)
+TAKION_INSTANTIATE_HALF(BFloat16)
+
+#undef TAKION_INSTANTIATE_HALF
+} // namespace Takion::Compute::CPU::Half
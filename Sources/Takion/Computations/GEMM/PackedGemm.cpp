@@ -0,0 +1,46 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Takion::Compute::CPU
+{
+void* GemmScratchBuffer(std::size_t slot, std::size_t byteSize)
+{
+    constexpr std::size_t alignment = 64;
+    thread_local std::vector<unsigned char> storage[2];
+
+    if (slot >= 2)
+        throw std::invalid_argument("Invalid GEMM scratch buffer slot");
+
+    auto& buffer = storage[slot];
+    if (buffer.size() < byteSize + alignment)
+        buffer.resize(byteSize + alignment);
+
+    const auto address = reinterpret_cast<std::uintptr_t>(buffer.data());
+    const auto mask = ~static_cast<std::uintptr_t>(alignment - 1);
+    return reinterpret_cast<void*>((address + alignment - 1) & mask);
+}
+} // namespace Takion::Compute::CPU
+
+namespace Takion::Compute::CPU::Float
+{
+void PackedGemm(std::size_t m, std::size_t n, std::size_t k, const float* A,
+                std::size_t rowStrideA, std::size_t colStrideA, const float* B,
+                std::size_t rowStrideB, std::size_t colStrideB, float* C,
+                std::size_t ldc, bool accumulate, bool parallel,
+                const GemmEpilogue<float>& epilogue,
+                const GemmBlocking& blocking)
+{
+    GetKernelTable().Gemm(m, n, k, A, rowStrideA, colStrideA, B, rowStrideB,
+                          colStrideB, C, ldc, accumulate, parallel, epilogue,
+                          blocking);
+}
+} // namespace Takion::Compute::CPU::Float
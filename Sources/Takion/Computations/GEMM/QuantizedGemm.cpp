@@ -0,0 +1,189 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/GEMM/QuantizedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Utils/Span.hpp>
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Takion::Compute
+{
+QuantizationParameters ChooseQuantizationParameters(float min, float max)
+{
+    min = std::min(min, 0.0f);
+    max = std::max(max, 0.0f);
+
+    QuantizationParameters parameters;
+    if (max > min)
+        parameters.Scale = (max - min) / 255.0f;
+    parameters.ZeroPoint = std::clamp(
+        static_cast<std::int32_t>(std::nearbyint(-min / parameters.Scale)), 0,
+        255);
+    return parameters;
+}
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU::Quantized
+{
+using namespace Util;
+
+namespace
+{
+//! Returns sums of every column of k x n matrix B
+std::vector<std::int32_t> ColumnSums(const std::int8_t* B, std::size_t n,
+                                     std::size_t k, std::size_t ldB)
+{
+    std::vector<std::int32_t> sums(n, 0);
+    for (std::size_t p = 0; p < k; ++p)
+        for (std::size_t j = 0; j < n; ++j)
+            sums[j] += B[p * ldB + j];
+    return sums;
+}
+
+QuantizedEpilogue MakeEpilogue(const Requantization& requantization,
+                               std::size_t n)
+{
+    if (requantization.Scale.size() != 1 && requantization.Scale.size() != n)
+        throw std::invalid_argument(
+            "Requantization scale should have one value, or one value per "
+            "output column");
+    if (!requantization.Bias.empty() && requantization.Bias.size() != n)
+        throw std::invalid_argument(
+            "Requantization bias should have one value per output column");
+
+    QuantizedEpilogue epilogue;
+    epilogue.Scale = requantization.Scale.data();
+    epilogue.ScaleStride = requantization.Scale.size() == 1 ? 0 : 1;
+    epilogue.ZeroPointA = requantization.ZeroPointA;
+    epilogue.Bias =
+        requantization.Bias.empty() ? nullptr : requantization.Bias.data();
+    epilogue.Activation = requantization.Activation;
+    epilogue.OutputScale = requantization.OutputScale;
+    epilogue.OutputZeroPoint = requantization.OutputZeroPoint;
+    return epilogue;
+}
+
+//! Multiplies numMatrices matrices of A with B and applies epilogue
+//! If broadCastB is true, rows of every matrix of A are contiguous, so the
+//! batch is handled as one (numMatrices * m) x k matrix and every packed
+//! panel of B is reused across all of its rows
+//! Matrix matIdx of the output starts at matIdx * m * ldOut, and is written
+//! to C if the epilogue keeps accumulators, or through the epilogue otherwise
+template <typename TOut>
+void MultiplyMatrices(const std::uint8_t* A, const std::int8_t* B,
+                      std::int32_t* C, TOut* out, std::size_t m,
+                      std::size_t n, std::size_t k, std::size_t ldA,
+                      std::size_t ldB, std::size_t ldOut,
+                      std::size_t numMatrices, bool broadCastB,
+                      QuantizedEpilogue epilogue)
+{
+    const auto& kernels = Int::GetKernelTable();
+    const bool requantize = epilogue.Output != QuantizedOutput::Int32;
+    const auto rows = broadCastB ? m * numMatrices : m;
+    const auto count = broadCastB ? 1 : numMatrices;
+    const auto sizeA = m * ldA;
+    const auto sizeB = k * ldB;
+    const auto sizeOut = m * ldOut;
+    const bool parallelMatrices =
+        count >= static_cast<std::size_t>(omp_get_max_threads());
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelMatrices)
+    for (long matIdx = 0; matIdx < static_cast<long>(count); ++matIdx)
+    {
+        const auto* matB = B + (broadCastB ? 0 : sizeB * matIdx);
+        auto matEpilogue = epilogue;
+        std::vector<std::int32_t> columnSums;
+        if (requantize && epilogue.ZeroPointA != 0)
+        {
+            columnSums = ColumnSums(matB, n, k, ldB);
+            matEpilogue.ColumnSumB = columnSums.data();
+        }
+
+        // Accumulators of requantized outputs are only stored if they have
+        // to be kept between blocks of k
+        std::vector<std::int32_t> accumulators;
+        std::int32_t* matC = nullptr;
+        if (!requantize)
+            matC = C + sizeOut * matIdx;
+        else if (k > QuantizedGemmKC)
+        {
+            accumulators.resize(rows * n);
+            matC = accumulators.data();
+        }
+
+        if constexpr (std::is_same_v<TOut, float>)
+            matEpilogue.FloatOut = out + sizeOut * matIdx;
+        else if constexpr (std::is_same_v<TOut, std::uint8_t>)
+            matEpilogue.UInt8Out = out + sizeOut * matIdx;
+        matEpilogue.LdOut = ldOut;
+
+        kernels.QuantizedGemm(rows, n, k, A + sizeA * matIdx, ldA, matB, ldB,
+                              matC, requantize ? n : ldOut, !parallelMatrices,
+                              matEpilogue);
+    }
+}
+} // namespace
+
+void MultiplyCpu(const Span<std::uint8_t> inputA,
+                 const Span<std::int8_t> inputB, Span<std::int32_t> out,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastB)
+{
+    MultiplyMatrices<std::int32_t>(inputA.Address(0), inputB.Address(0),
+                                   out.Address(0), nullptr, m, n, k, ldA, ldB,
+                                   ldOut, numMatrices, broadCastB,
+                                   QuantizedEpilogue());
+}
+
+void MultiplyCpu(const Span<std::uint8_t> inputA,
+                 const Span<std::int8_t> inputB, Span<float> out,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastB,
+                 const Requantization& requantization)
+{
+    auto epilogue = MakeEpilogue(requantization, n);
+    epilogue.Output = QuantizedOutput::Float;
+    MultiplyMatrices(inputA.Address(0), inputB.Address(0), nullptr,
+                     out.Address(0), m, n, k, ldA, ldB, ldOut, numMatrices,
+                     broadCastB, epilogue);
+}
+
+void MultiplyCpu(const Span<std::uint8_t> inputA,
+                 const Span<std::int8_t> inputB, Span<std::uint8_t> out,
+                 std::size_t m, std::size_t n, std::size_t k,
+                 std::size_t ldA, std::size_t ldB, std::size_t ldOut,
+                 std::size_t numMatrices, bool broadCastB,
+                 const Requantization& requantization)
+{
+    auto epilogue = MakeEpilogue(requantization, n);
+    epilogue.Output = QuantizedOutput::UInt8;
+    MultiplyMatrices(inputA.Address(0), inputB.Address(0), nullptr,
+                     out.Address(0), m, n, k, ldA, ldB, ldOut, numMatrices,
+                     broadCastB, epilogue);
+}
+
+void QuantizeCpu(const Span<float> input, Span<std::uint8_t> out,
+                 std::size_t numRow, std::size_t numCol, std::size_t ldInput,
+                 std::size_t ldOut, const QuantizationParameters& parameters)
+{
+    const auto& kernels = Int::GetKernelTable();
+    const auto* inputPtr = input.Address(0);
+    auto* outPtr = out.Address(0);
+
+#pragma omp parallel for schedule(static) default(shared)
+    for (long rowIdx = 0; rowIdx < static_cast<long>(numRow); ++rowIdx)
+        kernels.Quantize(inputPtr + ldInput * rowIdx, outPtr + ldOut * rowIdx,
+                         numCol, parameters.Scale, parameters.ZeroPoint);
+}
+} // namespace Takion::Compute::CPU::Quantized
@@ -0,0 +1,113 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/SparseGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace Takion::Compute
+{
+namespace
+{
+void ToBlocks(const float* data, std::size_t ld, float threshold,
+              SparseMatrix& matrix)
+{
+    const auto blockRows = matrix.BlockRows();
+    const auto blockCols = matrix.BlockCols();
+    const auto numGroups = (matrix.NumCol + blockCols - 1) / blockCols;
+    std::vector<float> block(blockRows * blockCols);
+
+    matrix.Offsets.assign(1, 0);
+    for (std::size_t group = 0; group < numGroups; ++group)
+    {
+        const auto firstCol = group * blockCols;
+        const auto numCols = std::min(blockCols, matrix.NumCol - firstCol);
+        for (std::size_t firstRow = 0; firstRow < matrix.NumRow;
+             firstRow += blockRows)
+        {
+            const auto numRows = std::min(blockRows, matrix.NumRow - firstRow);
+            bool nonZero = false;
+            std::fill(block.begin(), block.end(), 0.0f);
+            for (std::size_t r = 0; r < numRows; ++r)
+                for (std::size_t c = 0; c < numCols; ++c)
+                {
+                    const auto value = data[(firstRow + r) * ld + firstCol + c];
+                    if (std::abs(value) <= threshold)
+                        continue;
+                    block[r * blockCols + c] = value;
+                    nonZero = true;
+                }
+
+            if (!nonZero)
+                continue;
+            matrix.Indices.emplace_back(static_cast<std::uint32_t>(firstRow));
+            matrix.Values.insert(matrix.Values.end(), block.begin(),
+                                 block.end());
+        }
+        matrix.Offsets.emplace_back(matrix.Indices.size());
+    }
+}
+} // namespace
+
+SparseMatrix SparseMatrix::FromDense(const float* data, std::size_t numRow,
+                                     std::size_t numCol, std::size_t ld,
+                                     SparseFormat format, float threshold)
+{
+    constexpr auto maxIndex = std::numeric_limits<std::uint32_t>::max();
+    if (numRow > maxIndex || numCol > maxIndex)
+        throw std::invalid_argument(
+            "Sparse matrix should have less than 2^32 rows and columns");
+    if (ld < numCol)
+        throw std::invalid_argument(
+            "Row length of the dense matrix should be at least its number of "
+            "columns");
+
+    SparseMatrix matrix;
+    matrix.Format = format;
+    matrix.NumRow = numRow;
+    matrix.NumCol = numCol;
+    ToBlocks(data, ld, threshold, matrix);
+    return matrix;
+}
+} // namespace Takion::Compute
+
+namespace Takion::Compute::CPU::Sparse
+{
+void MultiplyAddCpu(const Span<float> inputA, const SparseMatrix& inputB,
+                    const Span<float> inputC, Span<float> out, std::size_t m,
+                    std::size_t ldA, std::size_t ldOut,
+                    std::size_t numMatrices, bool broadCastC,
+                    ActivationType activation, float scale)
+{
+    const auto& kernels = Float::GetKernelTable();
+
+    GemmEpilogue<float> epilogue;
+    epilogue.Bias = inputC.Base();
+    epilogue.BiasRowStride = ldOut;
+    epilogue.Scale = scale;
+    epilogue.Activation = activation;
+
+    // B is shared by every matrix, so the batch is folded into rows unless
+    // a shared C has several rows (see Gemm in KernelRegistry.cpp)
+    if (!epilogue.Bias || !broadCastC || m == 1)
+    {
+        if (broadCastC)
+            epilogue.BiasRowStride = 0;
+        kernels.SparseGemm(m * numMatrices, inputA.Base(), ldA, inputB,
+                           out.Address(0), ldOut, true, epilogue);
+        return;
+    }
+
+    for (std::size_t matIdx = 0; matIdx < numMatrices; ++matIdx)
+        kernels.SparseGemm(m, inputA.Address(matIdx * m * ldA), ldA, inputB,
+                           out.Address(matIdx * m * ldOut), ldOut, true,
+                           epilogue);
+}
+} // namespace Takion::Compute::CPU::Sparse
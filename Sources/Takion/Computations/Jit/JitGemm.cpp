@@ -0,0 +1,366 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/Jit/JitGemm.hpp>
+#include <Takion/Computations/Simd/InstructionSet.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace Takion::Compute::Jit
+{
+namespace
+{
+//! Register tile of MaxRows x MaxVectors ymm accumulators (ymm0 - ymm11)
+//! Rows of B are loaded to ymm12 - ymm14, and ymm15 holds broadcast
+//! elements of A and masks of partial vectors
+constexpr std::size_t MaxRows = 4;
+constexpr std::size_t MaxVectors = 3;
+constexpr std::size_t VectorWidth = 8;
+constexpr std::size_t KUnroll = 4;
+constexpr int FirstBRegister = 12;
+constexpr int ScratchRegister = 15;
+
+//! Arguments of generated kernels in the System V calling convention
+constexpr Gp RegA = Gp::Rdi;
+constexpr Gp RegB = Gp::Rsi;
+constexpr Gp RegBias = Gp::Rdx;
+constexpr Gp RegOut = Gp::Rcx;
+//! Pointers to the current columns of A and rows of B, and the k counter
+constexpr Gp RegPanelA = Gp::R8;
+constexpr Gp RegPanelB = Gp::R9;
+constexpr Gp RegCounter = Gp::R10;
+
+std::atomic<bool>& Enabled()
+{
+    static std::atomic<bool> enabled([]() {
+        const char* value = std::getenv("TAKION_JIT");
+        return value != nullptr && std::string(value) == "1";
+    }());
+    return enabled;
+}
+
+bool FitsDisplacement(std::size_t numFloats)
+{
+    return numFloats * sizeof(float) <
+           static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+}
+
+std::int32_t Displacement(std::size_t numFloats)
+{
+    return static_cast<std::int32_t>(numFloats * sizeof(float));
+}
+
+struct GemmShapeHash
+{
+    std::size_t operator()(const GemmShape& shape) const
+    {
+        std::size_t hash = static_cast<std::size_t>(shape.Activation);
+        for (const auto value :
+             { shape.M, shape.N, shape.K, shape.LdA, shape.LdB, shape.LdOut,
+               shape.BiasRowStride, std::size_t(shape.HasBias) })
+            hash = hash * 1000003 ^ value;
+        return hash;
+    }
+};
+
+//! Emits code of a GemmKernel tile by tile
+class GemmGenerator
+{
+public:
+    explicit GemmGenerator(const GemmShape& shape)
+        : m_shape(shape)
+    {
+    }
+
+    ExecutableCode Generate()
+    {
+        for (std::size_t row = 0; row < m_shape.M; row += MaxRows)
+            for (std::size_t col = 0; col < m_shape.N;
+                 col += MaxVectors * VectorWidth)
+                m_tile(row, std::min(MaxRows, m_shape.M - row), col,
+                       std::min(MaxVectors * VectorWidth, m_shape.N - col));
+        m_emitter.VZeroUpper();
+        m_emitter.Ret();
+        m_constants();
+        return m_emitter.Finalize();
+    }
+
+private:
+    static int m_accumulator(std::size_t row, std::size_t vector)
+    {
+        return static_cast<int>(row * MaxVectors + vector);
+    }
+
+    //! Computes rows x cols block of out starting at (row, col)
+    void m_tile(std::size_t row, std::size_t rows, std::size_t col,
+                std::size_t cols)
+    {
+        m_rows = rows;
+        m_vectors = (cols + VectorWidth - 1) / VectorWidth;
+        m_tail = cols % VectorWidth;
+
+        m_emitter.Lea(RegPanelA,
+                      Address::Of(RegA, Displacement(row * m_shape.LdA)));
+        m_emitter.Lea(RegPanelB, Address::Of(RegB, Displacement(col)));
+        for (std::size_t i = 0; i < m_rows; ++i)
+            for (std::size_t v = 0; v < m_vectors; ++v)
+                m_emitter.VXorps(m_accumulator(i, v), m_accumulator(i, v),
+                                 m_accumulator(i, v));
+
+        const auto iterations = m_shape.K / KUnroll;
+        if (iterations > 0)
+        {
+            const auto loop = m_emitter.NewLabel();
+            m_emitter.Mov(RegCounter, static_cast<std::uint32_t>(iterations));
+            m_emitter.Bind(loop);
+            for (std::size_t k = 0; k < KUnroll; ++k)
+                m_step(k);
+            m_emitter.Add(RegPanelA, Displacement(KUnroll));
+            m_emitter.Add(RegPanelB, Displacement(KUnroll * m_shape.LdB));
+            m_emitter.Dec(RegCounter);
+            m_emitter.Jnz(loop);
+        }
+        for (std::size_t k = 0; k < m_shape.K % KUnroll; ++k)
+            m_step(k);
+
+        m_epilogue(row, col);
+    }
+
+    //! Accumulates product of column k of A and row k of B (relative to the
+    //! panel pointers) into the tile
+    void m_step(std::size_t k)
+    {
+        for (std::size_t v = 0; v < m_vectors; ++v)
+        {
+            const auto address = Address::Of(
+                RegPanelB, Displacement(k * m_shape.LdB + v * VectorWidth));
+            const auto reg = FirstBRegister + static_cast<int>(v);
+            if (m_isPartial(v))
+            {
+                m_emitter.VMovups(ScratchRegister, m_mask());
+                m_emitter.VMaskMovps(reg, ScratchRegister, address);
+            }
+            else
+                m_emitter.VMovups(reg, address);
+        }
+
+        for (std::size_t i = 0; i < m_rows; ++i)
+        {
+            m_emitter.VBroadcastss(
+                ScratchRegister,
+                Address::Of(RegPanelA, Displacement(i * m_shape.LdA + k)));
+            for (std::size_t v = 0; v < m_vectors; ++v)
+                m_emitter.VFmadd231ps(m_accumulator(i, v),
+                                      FirstBRegister + static_cast<int>(v),
+                                      ScratchRegister);
+        }
+    }
+
+    //! Adds bias, applies activation and stores the tile at (row, col)
+    void m_epilogue(std::size_t row, std::size_t col)
+    {
+        constexpr int zero = 13;
+        constexpr int slope = 12;
+        constexpr int temp = 14;
+        if (m_shape.Activation == ActivationType::ReLU)
+            m_emitter.VXorps(zero, zero, zero);
+        if (m_shape.Activation == ActivationType::LeakyReLU)
+            m_emitter.VBroadcastss(slope, m_slope());
+
+        for (std::size_t i = 0; i < m_rows; ++i)
+            for (std::size_t v = 0; v < m_vectors; ++v)
+            {
+                const auto acc = m_accumulator(i, v);
+                const auto colIdx = col + v * VectorWidth;
+                if (m_shape.HasBias)
+                {
+                    const auto address = Address::Of(
+                        RegBias,
+                        Displacement((row + i) * m_shape.BiasRowStride +
+                                     colIdx));
+                    if (m_isPartial(v))
+                    {
+                        m_emitter.VMovups(ScratchRegister, m_mask());
+                        m_emitter.VMaskMovps(temp, ScratchRegister, address);
+                        m_emitter.VAddps(acc, acc, temp);
+                    }
+                    else
+                        m_emitter.VAddps(acc, acc, address);
+                }
+
+                if (m_shape.Activation == ActivationType::ReLU)
+                    m_emitter.VMaxps(acc, acc, zero);
+                else if (m_shape.Activation == ActivationType::LeakyReLU)
+                {
+                    // Slope is below 1, so the larger value is the result
+                    m_emitter.VMulps(temp, acc, slope);
+                    m_emitter.VMaxps(acc, acc, temp);
+                }
+
+                const auto address = Address::Of(
+                    RegOut, Displacement((row + i) * m_shape.LdOut + colIdx));
+                if (m_isPartial(v))
+                {
+                    m_emitter.VMovups(ScratchRegister, m_mask());
+                    m_emitter.VMaskMovps(address, ScratchRegister, acc);
+                }
+                else
+                    m_emitter.VMovups(address, acc);
+            }
+    }
+
+    [[nodiscard]] bool m_isPartial(std::size_t vector) const
+    {
+        return m_tail != 0 && vector + 1 == m_vectors;
+    }
+
+    //! Mask selecting the columns of the partial vector of the current tile
+    Address m_mask()
+    {
+        if (!m_masks[m_tail])
+            m_masks[m_tail] = m_emitter.NewLabel();
+        return Address::At(*m_masks[m_tail]);
+    }
+
+    Address m_slope()
+    {
+        if (!m_slopeLabel)
+            m_slopeLabel = m_emitter.NewLabel();
+        return Address::At(*m_slopeLabel);
+    }
+
+    //! Emits constants referenced by the code after its last instruction
+    void m_constants()
+    {
+        m_emitter.Align(32);
+        for (std::size_t width = 1; width < VectorWidth; ++width)
+        {
+            if (!m_masks[width])
+                continue;
+            std::int32_t mask[VectorWidth] = {};
+            for (std::size_t lane = 0; lane < width; ++lane)
+                mask[lane] = -1;
+            m_emitter.Bind(*m_masks[width]);
+            m_emitter.Data(mask, sizeof(mask));
+        }
+        if (m_slopeLabel)
+        {
+            m_emitter.Bind(*m_slopeLabel);
+            m_emitter.Data(&LeakyReLUSlope, sizeof(LeakyReLUSlope));
+        }
+    }
+
+    const GemmShape& m_shape;
+    X86Emitter m_emitter;
+    std::size_t m_rows = 0;
+    std::size_t m_vectors = 0;
+    std::size_t m_tail = 0;
+    std::optional<Label> m_masks[VectorWidth];
+    std::optional<Label> m_slopeLabel;
+};
+} // namespace
+
+void SetEnabled(bool enabled)
+{
+    Enabled().store(enabled, std::memory_order_relaxed);
+}
+
+bool IsEnabled()
+{
+    return Enabled().load(std::memory_order_relaxed);
+}
+
+bool IsSupported()
+{
+    return IsPlatformSupported() &&
+           CPU::DetectInstructionSet() >= CPU::InstructionSet::AVX2;
+}
+
+GemmKernel::GemmKernel(const GemmShape& shape)
+    : m_shape(shape),
+      m_code([&shape]() {
+          if (!CanGenerate(shape))
+              throw std::invalid_argument(
+                  "GEMM kernel cannot be generated for given shape");
+          return GemmGenerator(shape).Generate();
+      }()),
+      m_function(reinterpret_cast<Function>(
+          const_cast<void*>(m_code.Entry())))
+{
+}
+
+bool GemmKernel::CanGenerate(const GemmShape& shape)
+{
+    if (!IsPlatformSupported() || shape.M == 0 || shape.N == 0 ||
+        shape.K == 0 || shape.Activation == ActivationType::Sigmoid)
+        return false;
+    if (shape.M * shape.N * shape.K > GemmMaxWork)
+        return false;
+    return FitsDisplacement(shape.M * shape.LdA) &&
+           FitsDisplacement(shape.K * shape.LdB) &&
+           FitsDisplacement(shape.M * shape.LdOut) &&
+           FitsDisplacement(shape.M * shape.BiasRowStride + shape.N);
+}
+
+bool GemmKernel::Matches(const GemmArguments<float>& arguments) const
+{
+    return MakeGemmShape(arguments) == m_shape;
+}
+
+GemmShape MakeGemmShape(const GemmArguments<float>& arguments)
+{
+    GemmShape shape;
+    const bool hasBias = arguments.C != nullptr;
+    if (arguments.Scale != 1.0f ||
+        (hasBias && arguments.BroadCastC && arguments.M != 1 &&
+         arguments.NumMatrices != 1))
+        return shape;
+
+    shape.M = arguments.M * arguments.NumMatrices;
+    shape.N = arguments.N;
+    shape.K = arguments.K;
+    shape.LdA = arguments.LdA;
+    shape.LdB = arguments.LdB;
+    shape.LdOut = arguments.LdOut;
+    shape.HasBias = hasBias;
+    shape.BiasRowStride =
+        hasBias && !(arguments.BroadCastC && arguments.M == 1)
+            ? arguments.LdOut
+            : 0;
+    shape.Activation = arguments.Activation;
+    return shape;
+}
+
+std::shared_ptr<const GemmKernel> CompileGemm(
+    const GemmArguments<float>& arguments)
+{
+    if (!IsEnabled() || !IsSupported() ||
+        CPU::GetInstructionSet() < CPU::InstructionSet::AVX2)
+        return nullptr;
+
+    const auto shape = MakeGemmShape(arguments);
+    if (!GemmKernel::CanGenerate(shape))
+        return nullptr;
+
+    static std::mutex mutex;
+    static std::unordered_map<GemmShape, std::shared_ptr<const GemmKernel>,
+                              GemmShapeHash>
+        kernels;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& kernel = kernels[shape];
+    if (!kernel)
+        kernel = std::make_shared<const GemmKernel>(shape);
+    return kernel;
+}
+} // namespace Takion::Compute::Jit
@@ -0,0 +1,304 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/Jit/X86Emitter.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define TAKION_JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+namespace Takion::Compute::Jit
+{
+namespace
+{
+//! Opcode maps and mandatory prefixes of VEX encoded instructions
+constexpr std::uint8_t Map0F = 1;
+constexpr std::uint8_t Map0F38 = 2;
+constexpr std::uint8_t NoPrefix = 0;
+constexpr std::uint8_t Prefix66 = 1;
+
+int ToInt(Gp reg)
+{
+    return static_cast<int>(reg);
+}
+} // namespace
+
+bool IsPlatformSupported()
+{
+#ifdef TAKION_JIT_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+ExecutableCode::ExecutableCode(const std::vector<std::uint8_t>& bytes)
+{
+#ifdef TAKION_JIT_SUPPORTED
+    m_size = bytes.size();
+    void* memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        throw std::runtime_error("Failed to allocate executable memory");
+    m_memory = memory;
+
+    std::memcpy(m_memory, bytes.data(), m_size);
+    // Pages are never writable and executable at the same time
+    if (mprotect(m_memory, m_size, PROT_READ | PROT_EXEC) != 0)
+    {
+        m_release();
+        throw std::runtime_error("Failed to allocate executable memory");
+    }
+#else
+    (void)bytes;
+    throw std::runtime_error("Not implemented");
+#endif
+}
+
+ExecutableCode::~ExecutableCode()
+{
+    m_release();
+}
+
+ExecutableCode::ExecutableCode(ExecutableCode&& code) noexcept
+    : m_memory(std::exchange(code.m_memory, nullptr)),
+      m_size(std::exchange(code.m_size, 0))
+{
+}
+
+ExecutableCode& ExecutableCode::operator=(ExecutableCode&& code) noexcept
+{
+    if (this != &code)
+    {
+        m_release();
+        m_memory = std::exchange(code.m_memory, nullptr);
+        m_size = std::exchange(code.m_size, 0);
+    }
+    return *this;
+}
+
+void ExecutableCode::m_release()
+{
+#ifdef TAKION_JIT_SUPPORTED
+    if (m_memory)
+        munmap(m_memory, m_size);
+#endif
+    m_memory = nullptr;
+    m_size = 0;
+}
+
+Label X86Emitter::NewLabel()
+{
+    m_labels.emplace_back(-1);
+    return { m_labels.size() - 1 };
+}
+
+void X86Emitter::Bind(Label label)
+{
+    m_labels.at(label.Id) = static_cast<std::ptrdiff_t>(m_bytes.size());
+}
+
+void X86Emitter::Align(std::size_t alignment)
+{
+    while (m_bytes.size() % alignment != 0)
+        m_byte(0);
+}
+
+void X86Emitter::Data(const void* data, std::size_t byteSize)
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    m_bytes.insert(m_bytes.end(), bytes, bytes + byteSize);
+}
+
+void X86Emitter::VXorps(int dst, int a, int b)
+{
+    m_vex(Map0F, NoPrefix, false, dst, a, 0x57, b);
+}
+
+void X86Emitter::VAddps(int dst, int a, const Address& b)
+{
+    m_vex(Map0F, NoPrefix, false, dst, a, 0x58, b);
+}
+
+void X86Emitter::VAddps(int dst, int a, int b)
+{
+    m_vex(Map0F, NoPrefix, false, dst, a, 0x58, b);
+}
+
+void X86Emitter::VMulps(int dst, int a, int b)
+{
+    m_vex(Map0F, NoPrefix, false, dst, a, 0x59, b);
+}
+
+void X86Emitter::VMaxps(int dst, int a, int b)
+{
+    m_vex(Map0F, NoPrefix, false, dst, a, 0x5F, b);
+}
+
+void X86Emitter::VFmadd231ps(int dst, int a, int b)
+{
+    m_vex(Map0F38, Prefix66, false, dst, a, 0xB8, b);
+}
+
+void X86Emitter::VMovups(int dst, const Address& src)
+{
+    m_vex(Map0F, NoPrefix, false, dst, 0, 0x10, src);
+}
+
+void X86Emitter::VMovups(const Address& dst, int src)
+{
+    m_vex(Map0F, NoPrefix, false, src, 0, 0x11, dst);
+}
+
+void X86Emitter::VMaskMovps(int dst, int mask, const Address& src)
+{
+    m_vex(Map0F38, Prefix66, false, dst, mask, 0x2C, src);
+}
+
+void X86Emitter::VMaskMovps(const Address& dst, int mask, int src)
+{
+    m_vex(Map0F38, Prefix66, false, src, mask, 0x2E, dst);
+}
+
+void X86Emitter::VBroadcastss(int dst, const Address& src)
+{
+    m_vex(Map0F38, Prefix66, false, dst, 0, 0x18, src);
+}
+
+void X86Emitter::VZeroUpper()
+{
+    m_byte(0xC5);
+    m_byte(0xF8);
+    m_byte(0x77);
+}
+
+void X86Emitter::Lea(Gp dst, const Address& src)
+{
+    const auto base = src.RipRelative ? 0 : ToInt(src.Base);
+    m_byte(static_cast<std::uint8_t>(0x48 | ((ToInt(dst) >> 3) << 2) |
+                                     (base >> 3)));
+    m_byte(0x8D);
+    m_modRm(ToInt(dst), src);
+}
+
+void X86Emitter::Add(Gp dst, std::int32_t immediate)
+{
+    m_byte(static_cast<std::uint8_t>(0x48 | (ToInt(dst) >> 3)));
+    m_byte(0x81);
+    m_byte(static_cast<std::uint8_t>(0xC0 | (ToInt(dst) & 7)));
+    m_int32(immediate);
+}
+
+void X86Emitter::Mov(Gp dst, std::uint32_t immediate)
+{
+    if (ToInt(dst) >= 8)
+        m_byte(0x41);
+    m_byte(static_cast<std::uint8_t>(0xB8 + (ToInt(dst) & 7)));
+    m_int32(static_cast<std::int32_t>(immediate));
+}
+
+void X86Emitter::Dec(Gp dst)
+{
+    if (ToInt(dst) >= 8)
+        m_byte(0x41);
+    m_byte(0xFF);
+    m_byte(static_cast<std::uint8_t>(0xC8 | (ToInt(dst) & 7)));
+}
+
+void X86Emitter::Jnz(Label target)
+{
+    m_byte(0x0F);
+    m_byte(0x85);
+    m_fixups.push_back({ m_bytes.size(), target });
+    m_int32(0);
+}
+
+void X86Emitter::Ret()
+{
+    m_byte(0xC3);
+}
+
+ExecutableCode X86Emitter::Finalize()
+{
+    // Displacements are the last field of every instruction referencing a
+    // label, so they are relative to the end of the displacement
+    for (const auto& fixup : m_fixups)
+    {
+        const auto target = m_labels.at(fixup.Target.Id);
+        if (target < 0)
+            throw std::runtime_error("Label referenced by code was not bound");
+        const auto displacement = static_cast<std::int32_t>(
+            target - static_cast<std::ptrdiff_t>(fixup.Position + 4));
+        std::memcpy(m_bytes.data() + fixup.Position, &displacement,
+                    sizeof(displacement));
+    }
+    return ExecutableCode(m_bytes);
+}
+
+void X86Emitter::m_byte(std::uint8_t byte)
+{
+    m_bytes.emplace_back(byte);
+}
+
+void X86Emitter::m_int32(std::int32_t value)
+{
+    std::uint8_t bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    Data(bytes, sizeof(bytes));
+}
+
+//! Three byte VEX prefix selecting 256 bit vectors. reg and rm are
+//! extended by the inverted R and B bits, and source is stored inverted in
+//! vvvv (0 for instructions without a source register)
+void X86Emitter::m_vex(std::uint8_t map, std::uint8_t prefix, bool wide,
+                       int reg, int source, std::uint8_t opcode, int rm)
+{
+    m_byte(0xC4);
+    m_byte(static_cast<std::uint8_t>(((~reg >> 3) & 1) << 7 | 1 << 6 |
+                                     ((~rm >> 3) & 1) << 5 | map));
+    m_byte(static_cast<std::uint8_t>((wide ? 1 : 0) << 7 |
+                                     (~source & 15) << 3 | 1 << 2 | prefix));
+    m_byte(opcode);
+    m_byte(static_cast<std::uint8_t>(0xC0 | (reg & 7) << 3 | (rm & 7)));
+}
+
+void X86Emitter::m_vex(std::uint8_t map, std::uint8_t prefix, bool wide,
+                       int reg, int source, std::uint8_t opcode,
+                       const Address& rm)
+{
+    const auto base = rm.RipRelative ? 0 : ToInt(rm.Base);
+    m_byte(0xC4);
+    m_byte(static_cast<std::uint8_t>(((~reg >> 3) & 1) << 7 | 1 << 6 |
+                                     ((~base >> 3) & 1) << 5 | map));
+    m_byte(static_cast<std::uint8_t>((wide ? 1 : 0) << 7 |
+                                     (~source & 15) << 3 | 1 << 2 | prefix));
+    m_byte(opcode);
+    m_modRm(reg, rm);
+}
+
+//! Memory operands always carry a 32 bit displacement. Bases encoded as rsp
+//! or r12 would need a SIB byte and are not supported
+void X86Emitter::m_modRm(int reg, const Address& rm)
+{
+    if (rm.RipRelative)
+    {
+        m_byte(static_cast<std::uint8_t>((reg & 7) << 3 | 5));
+        m_fixups.push_back({ m_bytes.size(), rm.Target });
+        m_int32(0);
+        return;
+    }
+
+    const auto base = ToInt(rm.Base) & 7;
+    if (base == 4)
+        throw std::invalid_argument("rsp and r12 cannot be used as base");
+    m_byte(static_cast<std::uint8_t>(0x80 | (reg & 7) << 3 | base));
+    m_int32(rm.Displacement);
+}
+} // namespace Takion::Compute::Jit
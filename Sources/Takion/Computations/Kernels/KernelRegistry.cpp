@@ -0,0 +1,254 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/Kernels/KernelRegistry.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <omp.h>
+
+namespace Takion::Compute
+{
+namespace
+{
+using CPU::GemmEpilogue;
+using CPU::InstructionSet;
+using CPU::KernelTable;
+
+template <typename T>
+const KernelTable<T>& TableOf(InstructionSet isa)
+{
+    if constexpr (std::is_same_v<T, float>)
+        return CPU::Float::GetKernelTable(isa);
+    else if constexpr (std::is_same_v<T, double>)
+        return CPU::Double::GetKernelTable(isa);
+    else
+        return CPU::Int::GetKernelTable(isa);
+}
+
+//! Runs one GEMM per matrix. Matrices are distributed over threads when there
+//! are enough of them, otherwise every GEMM is parallelized internally
+bool ParallelOverMatrices(std::size_t numMatrices)
+{
+    return numMatrices >= static_cast<std::size_t>(omp_get_max_threads());
+}
+
+//! Multiplies NumMatrices pairs of matrices (see PackedGemm for strides)
+//! Matrix matIdx of every operand starts at matIdx * its size, except for
+//! broadcast operands which are shared between every matrix
+template <typename T, InstructionSet Isa, BroadcastMode Broadcast,
+          KernelLayout Layout>
+void Gemm(const GemmArguments<T>& arguments)
+{
+    constexpr bool transposeA = Layout == KernelLayout::TransposeA ||
+                                Layout == KernelLayout::TransposeAB;
+    constexpr bool transposeB = Layout == KernelLayout::TransposeB ||
+                                Layout == KernelLayout::TransposeAB;
+
+    const auto& kernels = TableOf<T>(Isa);
+    const auto m = arguments.M;
+    const auto n = arguments.N;
+    const auto k = arguments.K;
+    // Stored transposed operand is read with swapped strides
+    const auto rowStrideA = transposeA ? 1 : arguments.LdA;
+    const auto colStrideA = transposeA ? arguments.LdA : 1;
+    const auto rowStrideB = transposeB ? 1 : arguments.LdB;
+    const auto colStrideB = transposeB ? arguments.LdB : 1;
+    const auto sizeOut = m * arguments.LdOut;
+
+    GemmEpilogue<T> epilogue;
+    epilogue.Bias = arguments.C;
+    epilogue.BiasRowStride = arguments.LdOut;
+    epilogue.Scale = arguments.Scale;
+    epilogue.Activation = arguments.Activation;
+
+    if constexpr (Broadcast == BroadcastMode::BroadcastB && !transposeA)
+    {
+        // Rows of every matrix of A are contiguous, so the whole batch is
+        // handled as a single (NumMatrices * M) x K matrix and every packed
+        // panel of B is reused across all of its rows. Batched C lines up
+        // with rows of the folded output, and a shared C with a single row is
+        // added to every one of them
+        if (!arguments.BroadCastC || m == 1)
+        {
+            if (arguments.BroadCastC)
+                epilogue.BiasRowStride = 0;
+            kernels.Gemm(m * arguments.NumMatrices, n, k, arguments.A,
+                         rowStrideA, colStrideA, arguments.B, rowStrideB,
+                         colStrideB, arguments.Out, arguments.LdOut, false,
+                         true, epilogue, arguments.Blocking);
+            return;
+        }
+    }
+
+    const auto strideA = Broadcast == BroadcastMode::BroadcastA
+                             ? 0
+                             : (transposeA ? k : m) * arguments.LdA;
+    const auto strideB = Broadcast == BroadcastMode::BroadcastB
+                             ? 0
+                             : (transposeB ? n : k) * arguments.LdB;
+    const auto strideC = arguments.BroadCastC ? 0 : sizeOut;
+    const auto numMatrices = arguments.NumMatrices;
+    const bool parallelMatrices = ParallelOverMatrices(numMatrices);
+
+#pragma omp parallel for schedule(static) default(shared) if (parallelMatrices)
+    for (long matIdx = 0; static_cast<std::size_t>(matIdx) < numMatrices;
+         ++matIdx)
+    {
+        auto matEpilogue = epilogue;
+        if (epilogue.Bias)
+            matEpilogue.Bias = epilogue.Bias + strideC * matIdx;
+
+        kernels.Gemm(m, n, k, arguments.A + strideA * matIdx, rowStrideA,
+                     colStrideA, arguments.B + strideB * matIdx, rowStrideB,
+                     colStrideB, arguments.Out + sizeOut * matIdx,
+                     arguments.LdOut, false, !parallelMatrices, matEpilogue,
+                     arguments.Blocking);
+    }
+}
+
+template <typename T, InstructionSet Isa>
+void MultiplyTransposedMean(const GemmArguments<T>& arguments)
+{
+    const auto& kernels = TableOf<T>(Isa);
+    // Stacked rows of A are read transposed, so the batch is reduced in the
+    // k loop and the mean is taken by scaling the final tiles
+    const auto batchSize = static_cast<T>(arguments.BatchSize);
+    GemmEpilogue<T> epilogue;
+    if constexpr (std::is_floating_point_v<T>)
+        epilogue.Scale = static_cast<T>(1) / batchSize;
+
+    kernels.Gemm(arguments.M, arguments.N, arguments.K, arguments.A, 1,
+                 arguments.LdA, arguments.B, arguments.LdB, 1, arguments.Out,
+                 arguments.LdOut, false, true, epilogue, arguments.Blocking);
+
+    // Sum is divided afterwards to keep truncating integer division
+    if constexpr (!std::is_floating_point_v<T>)
+        kernels.ScalarDiv(arguments.Out, batchSize, arguments.Out,
+                          arguments.M * arguments.LdOut, 1);
+}
+
+template <typename T, InstructionSet Isa>
+void Transpose(const TransposeArguments<T>& arguments)
+{
+    TableOf<T>(Isa).Transpose(arguments.Input, arguments.Output,
+                              arguments.NumRow, arguments.NumCol,
+                              arguments.LdInput, arguments.LdOutput,
+                              arguments.NumMatrices);
+}
+
+//! Binary elementwise kernel given by Member of KernelTable<T>
+template <typename T, InstructionSet Isa, BroadcastMode Broadcast, auto Member>
+void Binary(const ElementwiseArguments<T>& arguments)
+{
+    const auto size = arguments.Size;
+    (TableOf<T>(Isa).*Member)(
+        arguments.A, arguments.B, arguments.Out, size, arguments.BatchSize,
+        Broadcast == BroadcastMode::BroadcastA ? 0 : size,
+        Broadcast == BroadcastMode::BroadcastB ? 0 : size);
+}
+
+//! Kernel with a scalar operand given by Member of KernelTable<T>
+template <typename T, InstructionSet Isa, auto Member>
+void Scalar(const ElementwiseArguments<T>& arguments)
+{
+    (TableOf<T>(Isa).*Member)(arguments.A, arguments.Scalar, arguments.Out,
+                              arguments.Size, arguments.BatchSize);
+}
+
+template <typename T, InstructionSet Isa>
+void Set(const ElementwiseArguments<T>& arguments)
+{
+    TableOf<T>(Isa).Set(arguments.Out, arguments.Scalar, arguments.Size,
+                        arguments.BatchSize);
+}
+
+template <typename T, InstructionSet Isa>
+void Apply(const ElementwiseArguments<T>& arguments)
+{
+    TableOf<T>(Isa).Math(arguments.A, arguments.Out, arguments.Size,
+                         arguments.BatchSize, arguments.Function);
+}
+
+template <typename T, InstructionSet Isa, BroadcastMode Broadcast,
+          KernelLayout... Layouts>
+void RegisterGemm(KernelRegistry& registry)
+{
+    constexpr auto type = DataTypeOfV<T>;
+    (registry.Register(
+         KernelKey{ KernelOp::Multiply, type, Isa, Broadcast, Layouts },
+         &Gemm<T, Isa, Broadcast, Layouts>),
+     ...);
+    // Epilogue of Multiply is empty, so both share the same variants
+    (registry.Register(
+         KernelKey{ KernelOp::MultiplyAdd, type, Isa, Broadcast, Layouts },
+         &Gemm<T, Isa, Broadcast, Layouts>),
+     ...);
+}
+
+template <typename T, InstructionSet Isa, BroadcastMode Broadcast>
+void RegisterBroadcastKernels(KernelRegistry& registry)
+{
+    constexpr auto type = DataTypeOfV<T>;
+    RegisterGemm<T, Isa, Broadcast, KernelLayout::RowMajor,
+                 KernelLayout::TransposeA, KernelLayout::TransposeB,
+                 KernelLayout::TransposeAB>(registry);
+
+    registry.Register(KernelKey{ KernelOp::Add, type, Isa, Broadcast },
+                      &Binary<T, Isa, Broadcast, &KernelTable<T>::Add>);
+    registry.Register(KernelKey{ KernelOp::Sub, type, Isa, Broadcast },
+                      &Binary<T, Isa, Broadcast, &KernelTable<T>::Sub>);
+    registry.Register(KernelKey{ KernelOp::Dot, type, Isa, Broadcast },
+                      &Binary<T, Isa, Broadcast, &KernelTable<T>::Dot>);
+    registry.Register(KernelKey{ KernelOp::Div, type, Isa, Broadcast },
+                      &Binary<T, Isa, Broadcast, &KernelTable<T>::Div>);
+}
+
+template <typename T, InstructionSet Isa>
+void RegisterKernels(KernelRegistry& registry)
+{
+    constexpr auto type = DataTypeOfV<T>;
+    RegisterBroadcastKernels<T, Isa, BroadcastMode::None>(registry);
+    RegisterBroadcastKernels<T, Isa, BroadcastMode::BroadcastA>(registry);
+    RegisterBroadcastKernels<T, Isa, BroadcastMode::BroadcastB>(registry);
+
+    registry.Register(KernelKey{ KernelOp::MultiplyTransposedMean, type, Isa,
+                                 BroadcastMode::None,
+                                 KernelLayout::TransposeA },
+                      &MultiplyTransposedMean<T, Isa>);
+    registry.Register(KernelKey{ KernelOp::Transpose, type, Isa },
+                      &Transpose<T, Isa>);
+    registry.Register(KernelKey{ KernelOp::ScalarMul, type, Isa },
+                      &Scalar<T, Isa, &KernelTable<T>::ScalarMul>);
+    registry.Register(KernelKey{ KernelOp::ScalarDiv, type, Isa },
+                      &Scalar<T, Isa, &KernelTable<T>::ScalarDiv>);
+    registry.Register(KernelKey{ KernelOp::Set, type, Isa }, &Set<T, Isa>);
+    if constexpr (std::is_floating_point_v<T>)
+        registry.Register(KernelKey{ KernelOp::Apply, type, Isa },
+                          &Apply<T, Isa>);
+}
+
+template <InstructionSet Isa>
+void RegisterInstructionSet(KernelRegistry& registry)
+{
+    RegisterKernels<float, Isa>(registry);
+    RegisterKernels<double, Isa>(registry);
+    RegisterKernels<int, Isa>(registry);
+}
+} // namespace
+
+KernelRegistry& KernelRegistry::Get()
+{
+    static KernelRegistry registry;
+    return registry;
+}
+
+KernelRegistry::KernelRegistry()
+{
+    RegisterInstructionSet<InstructionSet::Scalar>(*this);
+    RegisterInstructionSet<InstructionSet::SSE>(*this);
+    RegisterInstructionSet<InstructionSet::AVX2>(*this);
+    RegisterInstructionSet<InstructionSet::AVX512>(*this);
+}
+} // namespace Takion::Compute
@@ -0,0 +1,70 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+
+namespace Takion::Compute::CPU
+{
+const KernelTable<float>& Float::GetKernelTable(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::AVX512:
+            return Avx512Kernels();
+        case InstructionSet::AVX2:
+            return Avx2Kernels();
+        case InstructionSet::SSE:
+            return SseKernels();
+        default:
+            return ScalarKernels();
+    }
+}
+
+const KernelTable<float>& Float::GetKernelTable()
+{
+    return GetKernelTable(GetInstructionSet());
+}
+
+const KernelTable<double>& Double::GetKernelTable(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::AVX512:
+            return Avx512Kernels();
+        case InstructionSet::AVX2:
+            return Avx2Kernels();
+        case InstructionSet::SSE:
+            return SseKernels();
+        default:
+            return ScalarKernels();
+    }
+}
+
+const KernelTable<double>& Double::GetKernelTable()
+{
+    return GetKernelTable(GetInstructionSet());
+}
+
+const KernelTable<int>& Int::GetKernelTable(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::AVX512:
+            return Avx512Kernels();
+        case InstructionSet::AVX2:
+            return Avx2Kernels();
+        case InstructionSet::SSE:
+            return SseKernels();
+        default:
+            return ScalarKernels();
+    }
+}
+
+const KernelTable<int>& Int::GetKernelTable()
+{
+    return GetKernelTable(GetInstructionSet());
+}
+} // namespace Takion::Compute::CPU
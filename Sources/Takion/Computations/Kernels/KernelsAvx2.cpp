@@ -0,0 +1,70 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <Takion/Computations/Simd/TargetRegion.hpp>
+#include <immintrin.h>
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+TAKION_TARGET_AVX2_BEGIN
+#include <Takion/Computations/Kernels/VectorAvx2.hpp>
+#include <Takion/Computations/Kernels/KernelSet.hpp>
+TAKION_TARGET_END
+
+namespace Takion::Compute::CPU
+{
+const KernelTable<float>& Float::Avx2Kernels()
+{
+    static const auto table = [] {
+        using V = Simd::Avx2::Float32;
+        auto kernels = MakeKernelTable<Kernels::KernelSet<V, 6>>(
+            InstructionSet::AVX2);
+        kernels.Float16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 6, Float16>>();
+        kernels.BFloat16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 6, BFloat16>>();
+        return kernels;
+    }();
+    return table;
+}
+
+const KernelTable<double>& Double::Avx2Kernels()
+{
+    static const auto table =
+        MakeKernelTable<Kernels::KernelSet<Simd::Avx2::Float64, 6>>(
+            InstructionSet::AVX2);
+    return table;
+}
+
+const KernelTable<int>& Int::Avx2Kernels()
+{
+    static const auto table = [] {
+        auto kernels =
+            MakeKernelTable<Kernels::KernelSet<Simd::Avx2::Int32, 6>>(
+                InstructionSet::AVX2);
+        kernels.QuantizedGemm =
+            &Kernels::QuantizedKernelSet<Simd::Avx2::Int32,
+                                         Simd::Avx2::Float32, 6>::Gemm;
+        kernels.Quantize =
+            &Kernels::QuantizedKernelSet<Simd::Avx2::Int32,
+                                         Simd::Avx2::Float32, 6>::Quantize;
+        kernels.BinaryGemm =
+            &Kernels::QuantizedKernelSet<Simd::Avx2::Int32,
+                                         Simd::Avx2::Float32, 6>::BinaryGemm;
+        return kernels;
+    }();
+    return table;
+}
+} // namespace Takion::Compute::CPU
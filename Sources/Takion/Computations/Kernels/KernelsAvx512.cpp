@@ -0,0 +1,80 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <Takion/Computations/Simd/TargetRegion.hpp>
+#include <immintrin.h>
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+TAKION_TARGET_AVX512_BEGIN
+#include <Takion/Computations/Kernels/VectorAvx512.hpp>
+#include <Takion/Computations/Kernels/KernelSet.hpp>
+TAKION_TARGET_END
+
+namespace Takion::Compute::CPU
+{
+const KernelTable<float>& Float::Avx512Kernels()
+{
+    static const auto table = [] {
+        using V = Simd::Avx512::Float32;
+        auto kernels = MakeKernelTable<Kernels::KernelSet<V, 12>>(
+            InstructionSet::AVX512);
+        kernels.Float16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 12, Float16>>();
+        kernels.BFloat16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 12, BFloat16>>();
+        return kernels;
+    }();
+    return table;
+}
+
+const KernelTable<double>& Double::Avx512Kernels()
+{
+    static const auto table =
+        MakeKernelTable<Kernels::KernelSet<Simd::Avx512::Float64, 12>>(
+            InstructionSet::AVX512);
+    return table;
+}
+
+const KernelTable<int>& Int::Avx512Kernels()
+{
+    static const auto table = [] {
+        auto kernels =
+            MakeKernelTable<Kernels::KernelSet<Simd::Avx512::Int32, 12>>(
+                InstructionSet::AVX512);
+        kernels.QuantizedGemm =
+            HasAvx512Vnni()
+                ? &Kernels::QuantizedKernelSet<Simd::Avx512::Int32Vnni,
+                                               Simd::Avx512::Float32,
+                                               12>::Gemm
+                : &Kernels::QuantizedKernelSet<Simd::Avx512::Int32,
+                                               Simd::Avx512::Float32,
+                                               12>::Gemm;
+        kernels.Quantize =
+            &Kernels::QuantizedKernelSet<Simd::Avx512::Int32,
+                                         Simd::Avx512::Float32, 12>::Quantize;
+        kernels.BinaryGemm =
+            HasAvx512Vpopcntdq()
+                ? &Kernels::QuantizedKernelSet<Simd::Avx512::Int32Vpopcntdq,
+                                               Simd::Avx512::Float32,
+                                               12>::BinaryGemm
+                : &Kernels::QuantizedKernelSet<Simd::Avx512::Int32,
+                                               Simd::Avx512::Float32,
+                                               12>::BinaryGemm;
+        return kernels;
+    }();
+    return table;
+}
+} // namespace Takion::Compute::CPU
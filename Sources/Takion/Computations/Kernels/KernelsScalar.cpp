@@ -0,0 +1,67 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// Portable kernels are compiled for the baseline target of the build
+#include <Takion/Computations/Kernels/VectorScalar.hpp>
+#include <Takion/Computations/Kernels/KernelSet.hpp>
+
+namespace Takion::Compute::CPU
+{
+const KernelTable<float>& Float::ScalarKernels()
+{
+    static const auto table = [] {
+        using V = Simd::Scalar::Float32;
+        auto kernels = MakeKernelTable<Kernels::KernelSet<V, 4>>(
+            InstructionSet::Scalar);
+        kernels.Float16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 4, Float16>>();
+        kernels.BFloat16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 4, BFloat16>>();
+        return kernels;
+    }();
+    return table;
+}
+
+const KernelTable<double>& Double::ScalarKernels()
+{
+    static const auto table =
+        MakeKernelTable<Kernels::KernelSet<Simd::Scalar::Float64, 4>>(
+            InstructionSet::Scalar);
+    return table;
+}
+
+const KernelTable<int>& Int::ScalarKernels()
+{
+    static const auto table = [] {
+        auto kernels =
+            MakeKernelTable<Kernels::KernelSet<Simd::Scalar::Int32, 4>>(
+                InstructionSet::Scalar);
+        kernels.QuantizedGemm =
+            &Kernels::QuantizedKernelSet<Simd::Scalar::Int32,
+                                         Simd::Scalar::Float32, 4>::Gemm;
+        kernels.Quantize =
+            &Kernels::QuantizedKernelSet<Simd::Scalar::Int32,
+                                         Simd::Scalar::Float32, 4>::Quantize;
+        kernels.BinaryGemm =
+            &Kernels::QuantizedKernelSet<Simd::Scalar::Int32,
+                                         Simd::Scalar::Float32, 4>::BinaryGemm;
+        return kernels;
+    }();
+    return table;
+}
+} // namespace Takion::Compute::CPU
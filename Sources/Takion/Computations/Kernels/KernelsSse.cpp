@@ -0,0 +1,70 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/GEMM/PackedGemm.hpp>
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <Takion/Computations/Simd/TargetRegion.hpp>
+#include <immintrin.h>
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+TAKION_TARGET_SSE_BEGIN
+#include <Takion/Computations/Kernels/VectorSse.hpp>
+#include <Takion/Computations/Kernels/KernelSet.hpp>
+TAKION_TARGET_END
+
+namespace Takion::Compute::CPU
+{
+const KernelTable<float>& Float::SseKernels()
+{
+    static const auto table = [] {
+        using V = Simd::Sse::Float32;
+        auto kernels = MakeKernelTable<Kernels::KernelSet<V, 6>>(
+            InstructionSet::SSE);
+        kernels.Float16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 6, Float16>>();
+        kernels.BFloat16Kernels =
+            MakeHalfKernelTable<Kernels::HalfKernelSet<V, 6, BFloat16>>();
+        return kernels;
+    }();
+    return table;
+}
+
+const KernelTable<double>& Double::SseKernels()
+{
+    static const auto table =
+        MakeKernelTable<Kernels::KernelSet<Simd::Sse::Float64, 6>>(
+            InstructionSet::SSE);
+    return table;
+}
+
+const KernelTable<int>& Int::SseKernels()
+{
+    static const auto table = [] {
+        auto kernels =
+            MakeKernelTable<Kernels::KernelSet<Simd::Sse::Int32, 6>>(
+                InstructionSet::SSE);
+        kernels.QuantizedGemm =
+            &Kernels::QuantizedKernelSet<Simd::Sse::Int32,
+                                         Simd::Sse::Float32, 6>::Gemm;
+        kernels.Quantize =
+            &Kernels::QuantizedKernelSet<Simd::Sse::Int32,
+                                         Simd::Sse::Float32, 6>::Quantize;
+        kernels.BinaryGemm =
+            &Kernels::QuantizedKernelSet<Simd::Sse::Int32,
+                                         Simd::Sse::Float32, 6>::BinaryGemm;
+        return kernels;
+    }();
+    return table;
+}
+} // namespace Takion::Compute::CPU
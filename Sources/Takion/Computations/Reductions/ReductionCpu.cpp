@@ -0,0 +1,200 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/Kernels/KernelTable.hpp>
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Takion::Compute::CPU
+{
+void* ReductionScratchBuffer(std::size_t slot, std::size_t byteSize)
+{
+    constexpr std::size_t alignment = 64;
+    thread_local std::vector<unsigned char> storage[2];
+
+    if (slot >= 2)
+        throw std::invalid_argument("Invalid reduction scratch buffer slot");
+
+    auto& buffer = storage[slot];
+    if (buffer.size() < byteSize + alignment)
+        buffer.resize(byteSize + alignment);
+
+    const auto address = reinterpret_cast<std::uintptr_t>(buffer.data());
+    const auto mask = ~static_cast<std::uintptr_t>(alignment - 1);
+    return reinterpret_cast<void*>((address + alignment - 1) & mask);
+}
+
+namespace
+{
+template <typename T>
+typename KernelTable<T>::ReduceFunction GetReduceFunction(
+    const KernelTable<T>& kernels, ReduceOp op)
+{
+    switch (op)
+    {
+    case ReduceOp::Sum:
+        return kernels.ReduceSum;
+    case ReduceOp::Mean:
+        return kernels.ReduceMean;
+    case ReduceOp::Max:
+        return kernels.ReduceMax;
+    case ReduceOp::Min:
+        return kernels.ReduceMin;
+    }
+    throw std::invalid_argument("Unknown reduction");
+}
+
+//! Maximum is found with the vectorized reduction first, then each block is
+//! scanned once for the first element equal to it
+template <typename T>
+void ArgMax(const KernelTable<T>& kernels, const T* input, int* output,
+            std::size_t outer, std::size_t axisSize, std::size_t inner,
+            std::size_t outerStride, std::size_t outputStride)
+{
+    auto* maximum =
+        static_cast<T*>(ReductionScratchBuffer(0, sizeof(T) * outer * inner));
+    kernels.ReduceMax(input, maximum, outer, axisSize, inner, outerStride,
+                      inner);
+
+#pragma omp parallel for schedule(static) default(shared) if (outer > 1)
+    for (long outerIdx = 0; outerIdx < static_cast<long>(outer); ++outerIdx)
+    {
+        const auto* src = input + outerStride * outerIdx;
+        const auto* max = maximum + inner * outerIdx;
+        auto* dest = output + outputStride * outerIdx;
+        std::fill(dest, dest + inner, -1);
+
+        std::size_t numFound = 0;
+        for (std::size_t axisIdx = 0; axisIdx < axisSize && numFound < inner;
+             ++axisIdx)
+            for (std::size_t i = 0; i < inner; ++i)
+                if (dest[i] < 0 && src[inner * axisIdx + i] == max[i])
+                {
+                    dest[i] = static_cast<int>(axisIdx);
+                    ++numFound;
+                }
+    }
+}
+
+//! Rows are reduced first, then results of rows in each group
+//! Means are computed from sums, so integer means are truncated only once
+template <typename T>
+void ReduceRowGroups(const KernelTable<T>& kernels, const T* input, T* output,
+                     std::size_t numGroups, std::size_t rowsPerGroup,
+                     std::size_t numCol, std::size_t ld,
+                     std::size_t outputStride, ReduceOp op)
+{
+    if (rowsPerGroup == 1)
+    {
+        GetReduceFunction(kernels, op)(input, output, numGroups, numCol, 1, ld,
+                                       outputStride);
+        return;
+    }
+
+    const auto reduce =
+        GetReduceFunction(kernels, op == ReduceOp::Mean ? ReduceOp::Sum : op);
+    auto* rows = static_cast<T*>(
+        ReductionScratchBuffer(0, sizeof(T) * numGroups * rowsPerGroup));
+    reduce(input, rows, numGroups * rowsPerGroup, numCol, 1, ld, 1);
+    reduce(rows, output, numGroups, rowsPerGroup, 1, rowsPerGroup,
+           outputStride);
+
+    if (op == ReduceOp::Mean)
+        for (std::size_t groupIdx = 0; groupIdx < numGroups; ++groupIdx)
+            output[outputStride * groupIdx] /=
+                static_cast<T>(rowsPerGroup * numCol);
+}
+} // namespace
+
+void Float::ReduceCpu(const Span<float> input, Span<float> output,
+                      std::size_t outer, std::size_t axisSize,
+                      std::size_t inner, std::size_t outerStride,
+                      std::size_t outputStride, ReduceOp op)
+{
+    GetReduceFunction(GetKernelTable(), op)(input.Address(0),
+                                            output.Address(0), outer,
+                                            axisSize, inner, outerStride,
+                                            outputStride);
+}
+
+void Float::ArgMaxCpu(const Span<float> input, Span<int> output,
+                      std::size_t outer, std::size_t axisSize,
+                      std::size_t inner, std::size_t outerStride,
+                      std::size_t outputStride)
+{
+    ArgMax(GetKernelTable(), input.Address(0), output.Address(0), outer,
+           axisSize, inner, outerStride, outputStride);
+}
+
+void Float::ReduceRowGroupsCpu(const Span<float> input, Span<float> output,
+                               std::size_t numGroups, std::size_t rowsPerGroup,
+                               std::size_t numCol, std::size_t ld,
+                               std::size_t outputStride, ReduceOp op)
+{
+    ReduceRowGroups(GetKernelTable(), input.Address(0), output.Address(0),
+                    numGroups, rowsPerGroup, numCol, ld, outputStride, op);
+}
+
+void Double::ReduceCpu(const Span<double> input, Span<double> output,
+                      std::size_t outer, std::size_t axisSize,
+                      std::size_t inner, std::size_t outerStride,
+                      std::size_t outputStride, ReduceOp op)
+{
+    GetReduceFunction(GetKernelTable(), op)(input.Address(0),
+                                            output.Address(0), outer,
+                                            axisSize, inner, outerStride,
+                                            outputStride);
+}
+
+void Double::ArgMaxCpu(const Span<double> input, Span<int> output,
+                      std::size_t outer, std::size_t axisSize,
+                      std::size_t inner, std::size_t outerStride,
+                      std::size_t outputStride)
+{
+    ArgMax(GetKernelTable(), input.Address(0), output.Address(0), outer,
+           axisSize, inner, outerStride, outputStride);
+}
+
+void Double::ReduceRowGroupsCpu(const Span<double> input, Span<double> output,
+                               std::size_t numGroups, std::size_t rowsPerGroup,
+                               std::size_t numCol, std::size_t ld,
+                               std::size_t outputStride, ReduceOp op)
+{
+    ReduceRowGroups(GetKernelTable(), input.Address(0), output.Address(0),
+                    numGroups, rowsPerGroup, numCol, ld, outputStride, op);
+}
+
+void Int::ReduceCpu(const Span<int> input, Span<int> output, std::size_t outer,
+                    std::size_t axisSize, std::size_t inner,
+                    std::size_t outerStride, std::size_t outputStride,
+                    ReduceOp op)
+{
+    GetReduceFunction(GetKernelTable(), op)(input.Address(0),
+                                            output.Address(0), outer,
+                                            axisSize, inner, outerStride,
+                                            outputStride);
+}
+
+void Int::ArgMaxCpu(const Span<int> input, Span<int> output, std::size_t outer,
+                    std::size_t axisSize, std::size_t inner,
+                    std::size_t outerStride, std::size_t outputStride)
+{
+    ArgMax(GetKernelTable(), input.Address(0), output.Address(0), outer,
+           axisSize, inner, outerStride, outputStride);
+}
+
+void Int::ReduceRowGroupsCpu(const Span<int> input, Span<int> output,
+                             std::size_t numGroups, std::size_t rowsPerGroup,
+                             std::size_t numCol, std::size_t ld,
+                             std::size_t outputStride, ReduceOp op)
+{
+    ReduceRowGroups(GetKernelTable(), input.Address(0), output.Address(0),
+                    numGroups, rowsPerGroup, numCol, ld, outputStride, op);
+}
+} // namespace Takion::Compute::CPU
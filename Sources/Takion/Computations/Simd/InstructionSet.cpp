@@ -0,0 +1,207 @@
+// Copyright (c) 2020, Jaewoo Kim
+
+// We are making my contributions/submissions to this project solely in our
+// personal capacity and are not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <Takion/Computations/Simd/InstructionSet.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace Takion::Compute::CPU
+{
+namespace
+{
+#ifdef _MSC_VER
+InstructionSet DetectWithCpuid()
+{
+    int info[4];
+    __cpuid(info, 0);
+    const auto maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512f = (info[1] & (1 << 16)) != 0;
+        avx512bw = (info[1] & (1 << 30)) != 0;
+    }
+
+    // Vector registers are usable only if the OS saves them on context switch
+    const auto xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+    if (avx512f && avx512bw && zmmState)
+        return InstructionSet::AVX512;
+    if (avx && avx2 && fma && f16c && ymmState)
+        return InstructionSet::AVX2;
+    if (sse41)
+        return InstructionSet::SSE;
+    return InstructionSet::Scalar;
+}
+#else
+InstructionSet DetectWithCpuid()
+{
+    // libgcc only reports AVX and AVX-512 features when the OS enabled them
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw"))
+        return InstructionSet::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+        __builtin_cpu_supports("f16c"))
+        return InstructionSet::AVX2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return InstructionSet::SSE;
+    return InstructionSet::Scalar;
+}
+#endif
+
+#ifdef _MSC_VER
+bool DetectVnni()
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[2] & (1 << 11)) != 0;
+}
+
+bool DetectVpopcntdq()
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[2] & (1 << 14)) != 0;
+}
+#else
+bool DetectVnni()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512vnni");
+}
+
+bool DetectVpopcntdq()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512vpopcntdq");
+}
+#endif
+
+InstructionSet DefaultInstructionSet()
+{
+    const auto detected = DetectInstructionSet();
+    const char* name = std::getenv("TAKION_ISA");
+    if (name == nullptr || *name == '\0')
+        return detected;
+
+    const auto requested = ToInstructionSet(name);
+    if (requested > detected)
+        throw std::invalid_argument(
+            "TAKION_ISA requested instruction set " + ToString(requested) +
+            " which is not supported by this processor (detected " +
+            ToString(detected) + ")");
+    return requested;
+}
+
+std::atomic<InstructionSet>& ActiveInstructionSet()
+{
+    static std::atomic<InstructionSet> instructionSet(DefaultInstructionSet());
+    return instructionSet;
+}
+} // namespace
+
+InstructionSet DetectInstructionSet()
+{
+    static const InstructionSet detected = DetectWithCpuid();
+    return detected;
+}
+
+bool HasAvx512Vnni()
+{
+    static const bool vnni =
+        DetectInstructionSet() == InstructionSet::AVX512 && DetectVnni();
+    return vnni;
+}
+
+bool HasAvx512Vpopcntdq()
+{
+    static const bool vpopcntdq =
+        DetectInstructionSet() == InstructionSet::AVX512 && DetectVpopcntdq();
+    return vpopcntdq;
+}
+
+InstructionSet GetInstructionSet()
+{
+    return ActiveInstructionSet().load(std::memory_order_relaxed);
+}
+
+void SetInstructionSet(InstructionSet instructionSet)
+{
+    if (instructionSet > DetectInstructionSet())
+        throw std::invalid_argument(
+            "Instruction set " + ToString(instructionSet) +
+            " is not supported by this processor");
+    ActiveInstructionSet().store(instructionSet, std::memory_order_relaxed);
+}
+
+void ResetInstructionSet()
+{
+    ActiveInstructionSet().store(DetectInstructionSet(),
+                                 std::memory_order_relaxed);
+}
+
+std::string ToString(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::Scalar:
+            return "Scalar";
+        case InstructionSet::SSE:
+            return "SSE";
+        case InstructionSet::AVX2:
+            return "AVX2";
+        case InstructionSet::AVX512:
+            return "AVX512";
+    }
+    return "Unknown";
+}
+
+InstructionSet ToInstructionSet(std::string name)
+{
+    std::transform(name.begin(), name.end(), name.begin(), [](char c) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    });
+
+    if (name == "scalar")
+        return InstructionSet::Scalar;
+    if (name == "sse")
+        return InstructionSet::SSE;
+    if (name == "avx2")
+        return InstructionSet::AVX2;
+    if (name == "avx512")
+        return InstructionSet::AVX512;
+    throw std::invalid_argument("Unknown instruction set : " + name);
+}
+} // namespace Takion::Compute::CPU
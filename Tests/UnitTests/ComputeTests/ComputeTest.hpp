@@ -7,14 +7,23 @@
 #ifndef TAKION_TEST_COMPUTETEST_HPP
 #define TAKION_TEST_COMPUTETEST_HPP
 
+#include <Takion/Computations/GEMM/GemmTuner.hpp>
 #include <Takion/Computations/GEMM/MathKernel.hpp>
+#include <Takion/Computations/Jit/JitGemm.hpp>
 //TODO : Move Device.hpp to Util folder
 #include <Takion/Computations/Device.hpp>
 #include <Takion/Computations/Initializers/InitializerType.hpp>
 #include "SolidComputations.hpp"
 #include <doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
 #include <type_traits>
 #include <iostream>
+#include <vector>
 
 namespace Takion::Test
 {
@@ -72,7 +81,10 @@ void TestMultiply(Compute::Device device)
     {
         const auto func = result.At(idx);
         const auto ans = truth.At(idx);
-        CHECK(func == ans);
+        if constexpr (std::is_floating_point<T>::value)
+            CHECK(func == doctest::Approx(ans));
+        else
+            CHECK(func == ans);
     }
 
     const auto optimizedMulElapsedTime =
@@ -133,7 +145,10 @@ void TestBroadcastMultiply1(Compute::Device device)
     {
         const auto func = result.At(idx);
         const auto ans = truth.At(idx);
-        CHECK(func == ans);
+        if constexpr (std::is_floating_point<T>::value)
+            CHECK(func == doctest::Approx(ans));
+        else
+            CHECK(func == ans);
     }
 
     const auto optimizedMulElapsedTime =
@@ -194,7 +209,10 @@ void TestBroadcastMultiply2(Compute::Device device)
     {
         const auto func = result.At(idx);
         const auto ans = truth.At(idx);
-        CHECK(func == ans);
+        if constexpr (std::is_floating_point<T>::value)
+            CHECK(func == doctest::Approx(ans));
+        else
+            CHECK(func == ans);
     }
 
     const auto optimizedMulElapsedTime =
@@ -207,6 +225,753 @@ void TestBroadcastMultiply2(Compute::Device device)
         << optimizedMulElapsedTime << std::endl;
 }
 
+template <typename T>
+void TestBatchedRowMultiply(Compute::Device device)
+{
+    const auto batchSize = 64;
+    const std::size_t numCol = 200;
+    const std::size_t numMiddle = 300;
+
+    Compute::Zeros<T> zeroInitializer;
+
+    Shape shapeA({ 1, numMiddle });
+    Shape shapeB({ numMiddle, numCol });
+    Shape shapeOut({ 1, numCol });
+
+    Tensor<T> A(shapeA, batchSize, device);
+    Tensor<T> B(shapeB, device);
+    Tensor<T> result(shapeOut, batchSize, device);
+    Tensor<T> truth(shapeOut, batchSize, device);
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        Compute::RandomNormal<T> randomNormalInitializer(static_cast<T>(-10),
+                                                         static_cast<T>(10));
+        randomNormalInitializer.Initialize(A);
+        randomNormalInitializer.Initialize(B);
+    }
+    else
+    {
+        Compute::Ones<T> onesInitializer;
+        onesInitializer.Initialize(A);
+        onesInitializer.Initialize(B);
+    }
+
+    zeroInitializer.Initialize(result);
+    zeroInitializer.Initialize(truth);
+
+    Compute::Multiply(A, B, result);
+    Test::Multiply(A, B, truth);
+
+    const auto size = result.BatchSize * result.TensorShape.Size();
+
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        const auto func = result.At(idx);
+        const auto ans = truth.At(idx);
+        if constexpr (std::is_floating_point<T>::value)
+            CHECK(func == doctest::Approx(ans));
+        else
+            CHECK(func == ans);
+    }
+}
+
+template <typename T>
+void TestTransposedMultiply(Compute::Device device, bool transposeA,
+                            bool transposeB)
+{
+    const auto testCase = [&](std::size_t numRow, std::size_t batchSizeA,
+                              std::size_t batchSizeB) {
+        const auto batchSize = std::max(batchSizeA, batchSizeB);
+        const std::size_t numCol = 181;
+        const std::size_t numMiddle = 75;
+
+        Compute::Zeros<T> zeroInitializer;
+
+        Shape shapeA = transposeA ? Shape({ numMiddle, numRow })
+                                  : Shape({ numRow, numMiddle });
+        Shape shapeB = transposeB ? Shape({ numCol, numMiddle })
+                                  : Shape({ numMiddle, numCol });
+        Shape shapeOut({ numRow, numCol });
+
+        Tensor<T> A(shapeA, batchSizeA, device);
+        Tensor<T> B(shapeB, batchSizeB, device);
+        Tensor<T> result(shapeOut, batchSize, device);
+        Tensor<T> truth(shapeOut, batchSize, device);
+
+        // Reading B with the wrong orientation mismatches inner dimensions
+        CHECK_THROWS(
+            Compute::Multiply(A, B, result, transposeA, !transposeB));
+
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            Compute::RandomNormal<T> randomNormalInitializer(
+                static_cast<T>(-10), static_cast<T>(10));
+            randomNormalInitializer.Initialize(A);
+            randomNormalInitializer.Initialize(B);
+        }
+        else
+        {
+            Compute::Ones<T> onesInitializer;
+            onesInitializer.Initialize(A);
+            onesInitializer.Initialize(B);
+        }
+
+        zeroInitializer.Initialize(result);
+        zeroInitializer.Initialize(truth);
+
+        Compute::Multiply(A, B, result, transposeA, transposeB);
+        Test::Multiply(A, B, truth, transposeA, transposeB);
+
+        const auto size = result.BatchSize * result.TensorShape.Size();
+
+        for (std::size_t idx = 0; idx < size; ++idx)
+        {
+            const auto func = result.At(idx);
+            const auto ans = truth.At(idx);
+            if constexpr (std::is_floating_point<T>::value)
+                CHECK(func == doctest::Approx(ans));
+            else
+                CHECK(func == ans);
+        }
+    };
+
+    testCase(169, 2, 2);
+    testCase(169, 1, 3);
+    testCase(1, 64, 1);
+    testCase(37, 3, 1);
+    testCase(1, 1, 1);
+}
+
+template <typename T>
+void TestTransposedMeanMultiply(Compute::Device device)
+{
+    const auto batchSize = 64;
+    const std::size_t numRow = 3;
+    const std::size_t numColA = 150;
+    const std::size_t numColB = 181;
+
+    Compute::Zeros<T> zeroInitializer;
+
+    Shape shapeA({ numRow, numColA });
+    Shape shapeB({ numRow, numColB });
+    Shape shapeOut({ numColA, numColB });
+
+    Tensor<T> A(shapeA, batchSize, device);
+    Tensor<T> B(shapeB, batchSize, device);
+    Tensor<T> products(shapeOut, batchSize, device);
+    Tensor<T> result(shapeOut, device);
+    Tensor<T> truth(shapeOut, device);
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        Compute::RandomNormal<T> randomNormalInitializer(static_cast<T>(-10),
+                                                         static_cast<T>(10));
+        randomNormalInitializer.Initialize(A);
+        randomNormalInitializer.Initialize(B);
+    }
+    else
+    {
+        Compute::Ones<T> onesInitializer;
+        onesInitializer.Initialize(A);
+        onesInitializer.Initialize(B);
+    }
+
+    zeroInitializer.Initialize(result);
+    zeroInitializer.Initialize(truth);
+
+    Tensor<T> wrongShape(Shape({ numColA, numColB + 1 }), device);
+    CHECK_THROWS(Compute::MultiplyTransposedMean(A, B, wrongShape));
+
+    Compute::MultiplyTransposedMean(A, B, result);
+    Test::Multiply(A, B, products, true, false);
+    Test::Shrink(products, truth);
+
+    const auto size = result.TensorShape.Size();
+
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        const auto func = result.At(idx);
+        const auto ans = truth.At(idx);
+        if constexpr (std::is_floating_point<T>::value)
+            CHECK(func == doctest::Approx(ans));
+        else
+            CHECK(func == ans);
+    }
+}
+
+template <typename T>
+void TestMultiplyAdd(Compute::Device device,
+                     Compute::ActivationType activation, T scale)
+{
+    const auto testCase = [&](std::size_t numRow, std::size_t batchSize,
+                              std::size_t batchSizeB, std::size_t batchSizeC,
+                              std::size_t numCol = 181) {
+        const std::size_t numMiddle = 300;
+
+        Compute::Zeros<T> zeroInitializer;
+
+        Shape shapeA({ numRow, numMiddle });
+        Shape shapeB({ numMiddle, numCol });
+        Shape shapeOut({ numRow, numCol });
+
+        Tensor<T> A(shapeA, batchSize, device);
+        Tensor<T> B(shapeB, batchSizeB, device);
+        Tensor<T> C(shapeOut, batchSizeC, device);
+        Tensor<T> result(shapeOut, batchSize, device);
+        Tensor<T> truth(shapeOut, batchSize, device);
+
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            Compute::RandomNormal<T> randomNormalInitializer(
+                static_cast<T>(0), static_cast<T>(1));
+            randomNormalInitializer.Initialize(A);
+            randomNormalInitializer.Initialize(B);
+            randomNormalInitializer.Initialize(C);
+        }
+        else
+        {
+            Compute::Ones<T> onesInitializer;
+            onesInitializer.Initialize(A);
+            onesInitializer.Initialize(B);
+            Compute::Set(C, static_cast<T>(-400));
+        }
+
+        zeroInitializer.Initialize(result);
+        zeroInitializer.Initialize(truth);
+
+        Compute::MultiplyAdd(A, B, C, result, activation, scale);
+        Test::MultiplyAdd(A, B, C, truth, activation, scale);
+
+        const auto size = result.BatchSize * result.TensorShape.Size();
+
+        for (std::size_t idx = 0; idx < size; ++idx)
+        {
+            const auto func = result.At(idx);
+            const auto ans = truth.At(idx);
+            if constexpr (std::is_floating_point<T>::value)
+                // Zero mean inputs can cancel, so error is relative to the
+                // magnitude of the inputs
+                CHECK(func == doctest::Approx(ans).scale(10));
+            else
+                CHECK(func == ans);
+        }
+    };
+
+    // Batched operands
+    testCase(37, 3, 3, 3);
+    // Batch folded into rows with a bias shared by every sample
+    testCase(1, 64, 1, 1);
+    // Shared B and C with several rows
+    testCase(37, 3, 1, 1);
+    // Single row multiplied by GEMV, on one thread and split over threads
+    testCase(1, 1, 1, 1);
+    testCase(1, 1, 1, 1, 300);
+}
+
+inline void TestQuantizedMultiply(Compute::Device device)
+{
+    const auto testCase = [&](std::size_t numRow, std::size_t numMiddle,
+                              std::size_t batchSize, std::size_t batchSizeB) {
+        const std::size_t numCol = 181;
+
+        Shape shapeA({ numRow, numMiddle });
+        Shape shapeB({ numMiddle, numCol });
+        Shape shapeOut({ numRow, numCol });
+
+        Tensor<std::uint8_t> A(shapeA, batchSize, device);
+        Tensor<std::int8_t> B(shapeB, batchSizeB, device);
+        Tensor<std::int32_t> result(shapeOut, batchSize, device);
+        Tensor<float> realResult(shapeOut, batchSize, device);
+        Tensor<std::uint8_t> quantizedResult(shapeOut, batchSize, device);
+
+        // Weights stay within the range every instruction set multiplies
+        // exactly
+        const auto weightMax = Compute::CPU::QuantizedWeightMax;
+        for (std::size_t idx = 0; idx < batchSize * shapeA.Size(); ++idx)
+            A.At(idx) = static_cast<std::uint8_t>((idx * 37 + 11) % 256);
+        for (std::size_t idx = 0; idx < batchSizeB * shapeB.Size(); ++idx)
+            B.At(idx) = static_cast<std::int8_t>(
+                static_cast<int>((idx * 13 + 5) % (2 * weightMax + 1)) -
+                weightMax);
+
+        Compute::Requantization requantization;
+        requantization.ZeroPointA = 128;
+        requantization.Scale.resize(numCol);
+        requantization.Bias.resize(numCol);
+        for (std::size_t col = 0; col < numCol; ++col)
+        {
+            requantization.Scale[col] = 1e-4f * static_cast<float>(col % 7 + 1);
+            requantization.Bias[col] = static_cast<float>(col % 5) - 2.0f;
+        }
+        requantization.Activation = Compute::ActivationType::ReLU;
+        requantization.OutputScale = 0.05f;
+        requantization.OutputZeroPoint = 3;
+
+        Compute::Multiply(A, B, result);
+        Compute::Multiply(A, B, realResult, requantization);
+        Compute::Multiply(A, B, quantizedResult, requantization);
+
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        {
+            const auto batchIdxB = batchSizeB == 1 ? 0 : batchIdx;
+            for (std::size_t row = 0; row < numRow; ++row)
+                for (std::size_t col = 0; col < numCol; ++col)
+                {
+                    std::int32_t sum = 0;
+                    std::int32_t columnSum = 0;
+                    for (std::size_t k = 0; k < numMiddle; ++k)
+                    {
+                        const auto b = B.At(batchIdxB, { k, col });
+                        sum += A.At(batchIdx, { row, k }) * b;
+                        columnSum += b;
+                    }
+                    CHECK(result.At(batchIdx, { row, col }) == sum);
+
+                    const auto real = std::max(
+                        0.0, static_cast<double>(requantization.Scale[col]) *
+                                 (sum - requantization.ZeroPointA *
+                                            columnSum) +
+                             requantization.Bias[col]);
+                    CHECK(realResult.At(batchIdx, { row, col }) ==
+                          doctest::Approx(real).epsilon(1e-5));
+
+                    // Rounding of values close to a half may differ by one
+                    const auto quantized = std::min(
+                        255.0, std::max(0.0, std::nearbyint(
+                                                 real / requantization
+                                                            .OutputScale) +
+                                                 requantization
+                                                     .OutputZeroPoint));
+                    CHECK(std::abs(quantizedResult.At(batchIdx, { row, col }) -
+                                   quantized) <= 1);
+                }
+        }
+    };
+
+    // Weights shared by every sample, with k not a multiple of four
+    testCase(5, 301, 3, 1);
+    // Batched operands
+    testCase(37, 64, 2, 2);
+    // Accumulators kept between blocks of k
+    testCase(7, Compute::CPU::QuantizedGemmKC + 77, 2, 1);
+}
+
+inline void TestQuantize(Compute::Device device)
+{
+    const std::size_t batchSize = 3;
+    const Shape shape({ 5, 83 });
+    Tensor<float> input(shape, batchSize, device);
+    Tensor<std::uint8_t> out(shape, batchSize, device);
+
+    const std::size_t size = batchSize * shape.Size();
+    for (std::size_t idx = 0; idx < size; ++idx)
+        input.At(idx) = static_cast<float>(idx % 101) * 0.1f - 3.0f;
+
+    const auto parameters = Compute::ChooseQuantizationParameters(-3.0f, 7.0f);
+    CHECK(parameters.ZeroPoint ==
+          static_cast<std::int32_t>(std::nearbyint(3.0f / parameters.Scale)));
+
+    Compute::Quantize(input, out, parameters);
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        // Rounding of values close to a half may differ by one
+        const auto expected = std::min(
+            255.0f, std::max(0.0f, std::nearbyint(input.At(idx) /
+                                                  parameters.Scale) +
+                                       parameters.ZeroPoint));
+        CHECK(std::abs(out.At(idx) - expected) <= 1);
+    }
+}
+
+//! Checks GEMM with sparse B in every format against dense GEMM with the
+//! pruned B. k and n are not multiples of the block size, so blocks past
+//! the matrix are covered
+inline void TestSparseMultiply(Compute::Device device)
+{
+    const auto testCase = [&](Compute::SparseFormat format,
+                              std::size_t numRow, std::size_t batchSize,
+                              std::size_t batchSizeC, float threshold) {
+        const std::size_t numMiddle = 301;
+        const std::size_t numCol = 181;
+
+        Shape shapeA({ numRow, numMiddle });
+        Shape shapeB({ numMiddle, numCol });
+        Shape shapeOut({ numRow, numCol });
+
+        Tensor<float> A(shapeA, batchSize, device);
+        Tensor<float> B(shapeB, 1, device);
+        Tensor<float> C(shapeOut, batchSizeC, device);
+        Tensor<float> result(shapeOut, batchSize, device);
+        Tensor<float> product(shapeOut, batchSize, device);
+        Tensor<float> truth(shapeOut, batchSize, device);
+
+        Compute::RandomNormal<float> randomNormalInitializer(0.0f, 1.0f);
+        randomNormalInitializer.Initialize(A);
+        randomNormalInitializer.Initialize(B);
+        randomNormalInitializer.Initialize(C);
+
+        // About 85% of B is zero, and the rest is pruned by threshold
+        std::size_t numNonZero = 0;
+        for (std::size_t idx = 0; idx < shapeB.Size(); ++idx)
+        {
+            auto& value = B.At(idx);
+            if ((idx * 7919) % 20 > 2 || std::abs(value) <= threshold)
+                value = 0.0f;
+            else
+                ++numNonZero;
+        }
+
+        const auto sparse = Compute::SparseMatrix::FromDense(
+            B.Data.Base(), numMiddle, numCol, B.ColumnElementSize(), format,
+            threshold);
+        if (format == Compute::SparseFormat::Csr)
+            CHECK(sparse.NumBlocks() == numNonZero);
+        CHECK(sparse.ByteSize() < shapeB.Size() * sizeof(float));
+
+        Compute::MultiplyAdd(A, sparse, C, result,
+                             Compute::ActivationType::ReLU);
+        Compute::Multiply(A, sparse, product);
+        Test::MultiplyAdd(A, B, C, truth, Compute::ActivationType::ReLU,
+                          1.0f);
+
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+            for (std::size_t row = 0; row < numRow; ++row)
+                for (std::size_t col = 0; col < numCol; ++col)
+                {
+                    CHECK(result.At(batchIdx, { row, col }) ==
+                          doctest::Approx(truth.At(batchIdx, { row, col }))
+                              .scale(10));
+
+                    float sum = 0.0f;
+                    for (std::size_t k = 0; k < numMiddle; ++k)
+                        sum += A.At(batchIdx, { row, k }) * B.At(0, { k, col });
+                    CHECK(product.At(batchIdx, { row, col }) ==
+                          doctest::Approx(sum).scale(10));
+                }
+
+        Tensor<float> wrongShape(Shape({ numRow, numCol + 1 }), batchSize,
+                                 device);
+        CHECK_THROWS(Compute::Multiply(A, sparse, wrongShape));
+    };
+
+    for (const auto format :
+         { Compute::SparseFormat::Csr, Compute::SparseFormat::Block1x8,
+           Compute::SparseFormat::Block4x8 })
+    {
+        // Batch folded into rows with a bias shared by every sample
+        testCase(format, 1, 64, 1, 0.0f);
+        // Shared bias with several rows, and rows not a multiple of the
+        // rows computed together
+        testCase(format, 37, 3, 1, 0.0f);
+        // Batched bias, with weights pruned by magnitude
+        testCase(format, 6, 2, 2, 0.5f);
+        // Single row
+        testCase(format, 1, 1, 1, 0.0f);
+    }
+}
+
+//! Checks products of sparse inputs in compressed sparse row format against
+//! the same inputs stored densely. Rows of B at columns without non-zero
+//! elements must not be read, so they are set to NaN
+template <typename T>
+void TestCsrMultiply(Compute::Device device)
+{
+    const auto testCase = [&](std::size_t batchSize, std::size_t numCol,
+                              std::size_t batchSizeC) {
+        const std::size_t numFeatures = 997;
+
+        Tensor<T> A(Shape({ numFeatures }), batchSize, device);
+        Tensor<T> B(Shape({ numFeatures, numCol }), device);
+        Tensor<T> C(Shape({ numCol }), batchSizeC, device);
+        Tensor<T> delta(Shape({ numCol }), batchSize, device);
+        Tensor<T> result(Shape({ numCol }), batchSize, device);
+        Tensor<T> product(Shape({ numCol }), batchSize, device);
+        Tensor<T> truth(Shape({ numCol }), batchSize, device);
+        Tensor<T> gradient(Shape({ numFeatures, numCol }), device);
+
+        Compute::RandomNormal<T> randomNormalInitializer(static_cast<T>(0),
+                                                         static_cast<T>(1));
+        randomNormalInitializer.Initialize(B);
+        randomNormalInitializer.Initialize(C);
+        randomNormalInitializer.Initialize(delta);
+        Compute::Zeros<T> zeroInitializer;
+        zeroInitializer.Initialize(A);
+
+        // About 5 features per sample, some shared between samples. Last
+        // sample has no features
+        Compute::CsrMatrix<T> sparse;
+        sparse.NumCol = numFeatures;
+        std::vector<bool> used(numFeatures, false);
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        {
+            std::vector<std::uint32_t> columns;
+            std::vector<T> values;
+            for (std::size_t i = 0; i < 5 && batchIdx + 1 < batchSize; ++i)
+            {
+                const auto column = static_cast<std::uint32_t>(
+                    (batchIdx * 131 + i * i * 53) % numFeatures);
+                const auto value =
+                    static_cast<T>(static_cast<int>(i) - 2) + T(0.25);
+                columns.emplace_back(column);
+                values.emplace_back(value);
+                A.At(batchIdx, { column }) = value;
+                used[column] = true;
+            }
+            sparse.AppendRow(columns, values);
+        }
+
+        Compute::MultiplyAdd(A, B, C, truth, Compute::ActivationType::ReLU);
+        Compute::MultiplyTransposedMean(A, delta, gradient);
+
+        for (std::size_t row = 0; row < numFeatures; ++row)
+            if (!used[row])
+                for (std::size_t col = 0; col < numCol; ++col)
+                    B.At(0, { row, col }) =
+                        std::numeric_limits<T>::quiet_NaN();
+
+        Compute::MultiplyAdd(sparse, B, C, result,
+                             Compute::ActivationType::ReLU);
+        Compute::Multiply(sparse, B, product);
+
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+            for (std::size_t col = 0; col < numCol; ++col)
+            {
+                CHECK(result.At(batchIdx, { col }) ==
+                      doctest::Approx(truth.At(batchIdx, { col })));
+
+                T sum = 0;
+                for (auto idx = sparse.RowOffsets[batchIdx];
+                     idx < sparse.RowOffsets[batchIdx + 1]; ++idx)
+                    sum += sparse.Values[idx] *
+                           B.At(0, { sparse.Columns[idx], col });
+                CHECK(product.At(batchIdx, { col }) == doctest::Approx(sum));
+            }
+
+        Compute::RowSparseMatrix<T> sparseGradient;
+        Compute::MultiplyTransposedMean(sparse, delta, sparseGradient);
+        CHECK(sparseGradient.NumRow == numFeatures);
+        CHECK(sparseGradient.NumCol == numCol);
+        CHECK(std::is_sorted(sparseGradient.Rows.begin(),
+                             sparseGradient.Rows.end()));
+        CHECK(sparseGradient.Rows.size() ==
+              static_cast<std::size_t>(
+                  std::count(used.begin(), used.end(), true)));
+        for (std::size_t idx = 0; idx < sparseGradient.Rows.size(); ++idx)
+            for (std::size_t col = 0; col < numCol; ++col)
+                CHECK(sparseGradient.Values[idx * numCol + col] ==
+                      doctest::Approx(
+                          gradient.At(0, { sparseGradient.Rows[idx], col })));
+
+        Tensor<T> wrongShape(Shape({ numCol + 1 }), batchSize, device);
+        CHECK_THROWS(Compute::Multiply(sparse, B, wrongShape));
+    };
+
+    // Bias shared by every sample, with full and partial column chunks
+    testCase(64, 181, 1);
+    // Batched bias with fewer columns than a vector
+    testCase(3, 5, 3);
+    // Single sample without features
+    testCase(1, 64, 1);
+}
+
+//! Checks packed signs and their XOR-popcount product against products of
+//! the unpacked values. Column counts around multiples of 64 cover partial
+//! words and partial vectors of words
+inline void TestBinaryMultiply(Compute::Device device)
+{
+    const auto testCase = [&](std::size_t batchSize, std::size_t k,
+                              std::size_t n) {
+        Tensor<float> A(Shape({ k }), batchSize, device);
+        Tensor<float> B(Shape({ k, n }), device);
+        Tensor<float> bias(Shape({ n }), device);
+        Tensor<float> valuesA(Shape({ k }), batchSize, device);
+        Tensor<float> valuesB(Shape({ n, k }), device);
+        Tensor<float> result(Shape({ n }), batchSize, device);
+        Tensor<float> product(Shape({ n }), batchSize, device);
+
+        Compute::RandomNormal<float> randomNormalInitializer(0.0f, 1.0f);
+        randomNormalInitializer.Initialize(A);
+        randomNormalInitializer.Initialize(B);
+        randomNormalInitializer.Initialize(bias);
+        // Zero has the sign of positive values
+        A.At(0, { 0 }) = 0.0f;
+
+        Compute::BinaryMatrix binaryA;
+        Compute::BinaryMatrix binaryB;
+        Compute::PackSigns(A, binaryA);
+        Compute::PackSigns(B, binaryB, true);
+        CHECK(binaryA.NumRow == batchSize);
+        CHECK(binaryB.NumRow == n);
+        CHECK(binaryB.NumCol == k);
+
+        Compute::UnpackSigns(binaryA, valuesA);
+        Compute::UnpackSigns(binaryB, valuesB);
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        {
+            float sum = 0.0f;
+            for (std::size_t idx = 0; idx < k; ++idx)
+                sum += std::abs(A.At(batchIdx, { idx }));
+            const auto scale = sum / static_cast<float>(k);
+            for (std::size_t idx = 0; idx < k; ++idx)
+                CHECK(valuesA.At(batchIdx, { idx }) ==
+                      doctest::Approx(A.At(batchIdx, { idx }) < 0.0f
+                                          ? -scale
+                                          : scale));
+        }
+        for (std::size_t col = 0; col < n; ++col)
+            for (std::size_t idx = 0; idx < k; ++idx)
+                CHECK((valuesB.At(0, { col, idx }) < 0.0f) ==
+                      (B.At(0, { idx, col }) < 0.0f));
+
+        Compute::MultiplyAdd(binaryA, binaryB, bias, result,
+                             Compute::ActivationType::ReLU);
+        Compute::Multiply(binaryA, binaryB, product);
+
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+            for (std::size_t col = 0; col < n; ++col)
+            {
+                double sum = 0;
+                for (std::size_t idx = 0; idx < k; ++idx)
+                    sum += static_cast<double>(valuesA.At(batchIdx, { idx })) *
+                           valuesB.At(0, { col, idx });
+                CHECK(product.At(batchIdx, { col }) ==
+                      doctest::Approx(sum).epsilon(1e-4));
+                CHECK(result.At(batchIdx, { col }) ==
+                      doctest::Approx(
+                          std::max(sum + bias.At(0, { col }), 0.0))
+                          .epsilon(1e-4));
+            }
+
+        Tensor<float> wrongShape(Shape({ n + 1 }), batchSize, device);
+        CHECK_THROWS(Compute::Multiply(binaryA, binaryB, wrongShape));
+    };
+
+    // Partial words and partial vectors of words
+    testCase(3, 200, 10);
+    // Single sample of a single word
+    testCase(1, 64, 7);
+    testCase(5, 1, 3);
+    // Many words per row, with columns past the last block of rows of B
+    testCase(2, 1000, 33);
+    testCase(4, 513, 64);
+}
+
+//! Checks conversion, GEMM and elementwise operations of tensors stored in
+//! 16 bit type T16 against float references computed from the same rounded
+//! values. Odd column counts cover partial vectors
+template <typename T16>
+void TestHalfPrecision(Compute::Device device)
+{
+    const std::size_t batchSize = 3;
+    const std::size_t m = 7;
+    const std::size_t k = 37;
+    const std::size_t n = 29;
+    // Relative error of a single rounding to T16
+    const float epsilon =
+        std::is_same_v<T16, Float16> ? 1.0f / 2048 : 1.0f / 256;
+
+    Tensor<float> A(Shape({ m, k }), batchSize, device);
+    Tensor<float> B(Shape({ k, n }), device);
+    Tensor<float> bias(Shape({ m, n }), device);
+    Tensor<T16> A16(Shape({ m, k }), batchSize, device);
+    Tensor<T16> B16(Shape({ k, n }), device);
+    Tensor<float> roundTrip(Shape({ m, k }), batchSize, device);
+
+    for (std::size_t idx = 0; idx < batchSize * m * k; ++idx)
+        A.At(idx) = static_cast<float>(idx % 23) * 0.37f - 4.0f;
+    for (std::size_t idx = 0; idx < k * n; ++idx)
+        B.At(idx) = static_cast<float>(idx % 17) * 0.11f - 0.9f;
+    for (std::size_t idx = 0; idx < m * n; ++idx)
+        bias.At(idx) = static_cast<float>(idx % 31) * 0.25f - 3.0f;
+
+    Compute::Convert(A, A16);
+    Compute::Convert(B, B16);
+    Compute::Convert(A16, roundTrip);
+    for (std::size_t idx = 0; idx < batchSize * m * k; ++idx)
+    {
+        CHECK(A16.At(idx).Bits == T16(A.At(idx)).Bits);
+        CHECK(roundTrip.At(idx) == static_cast<float>(T16(A.At(idx))));
+    }
+
+    // Products of rounded operands are accumulated in float
+    const auto reference = [&](std::size_t batchIdx, std::size_t i,
+                               std::size_t j) {
+        double sum = 0;
+        for (std::size_t p = 0; p < k; ++p)
+            sum += static_cast<double>(
+                       static_cast<float>(A16.At(batchIdx, { i, p }))) *
+                   static_cast<float>(B16.At(0, { p, j }));
+        return sum;
+    };
+
+    Tensor<float> out(Shape({ m, n }), batchSize, device);
+    Tensor<T16> out16(Shape({ m, n }), batchSize, device);
+    Compute::MultiplyAdd(A16, B16, bias, out, Compute::ActivationType::ReLU);
+    Compute::Multiply(A16, B16, out16);
+    for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                const auto product = reference(batchIdx, i, j);
+                const auto ans = std::max(
+                    0.0, product + bias.At(0, { i, j }));
+                CHECK(std::abs(out.At(batchIdx, { i, j }) - ans) <=
+                      1e-4 * (1 + std::abs(ans)));
+                CHECK(std::abs(static_cast<float>(out16.At(batchIdx, { i, j })) -
+                               product) <=
+                      epsilon * (1e-3 + std::abs(product)));
+            }
+
+    // Gradients of Dense: float delta with 16 bit weight and input
+    Tensor<float> delta(Shape({ m, n }), batchSize, device);
+    for (std::size_t idx = 0; idx < batchSize * m * n; ++idx)
+        delta.At(idx) = static_cast<float>(idx % 13) * 0.2f - 1.3f;
+    Tensor<float> backward(Shape({ m, k }), batchSize, device);
+    Tensor<float> weightUpdate(Shape({ k, n }), device);
+    Compute::Multiply(delta, B16, backward, false, true);
+    Compute::MultiplyTransposedMean(A16, delta, weightUpdate);
+
+    for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t p = 0; p < k; ++p)
+            {
+                double ans = 0;
+                for (std::size_t j = 0; j < n; ++j)
+                    ans += static_cast<double>(delta.At(batchIdx, { i, j })) *
+                           static_cast<float>(B16.At(0, { p, j }));
+                CHECK(std::abs(backward.At(batchIdx, { i, p }) - ans) <=
+                      1e-4 * (1 + std::abs(ans)));
+            }
+    for (std::size_t p = 0; p < k; ++p)
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            double ans = 0;
+            for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+                for (std::size_t i = 0; i < m; ++i)
+                    ans += static_cast<double>(static_cast<float>(
+                               A16.At(batchIdx, { i, p }))) *
+                           delta.At(batchIdx, { i, j });
+            ans /= batchSize;
+            CHECK(std::abs(weightUpdate.At(0, { p, j }) - ans) <=
+                  1e-4 * (1 + std::abs(ans)));
+        }
+
+    // Elementwise operations round only the result
+    Tensor<T16> sum(Shape({ m, k }), batchSize, device);
+    Tensor<T16> applied(Shape({ m, k }), batchSize, device);
+    Compute::Add(A16, A16, sum);
+    Compute::ScalarMul(sum, T16(0.5f));
+    Compute::Apply(A16, applied, Compute::Tanh());
+    for (std::size_t idx = 0; idx < batchSize * m * k; ++idx)
+    {
+        const auto value = static_cast<float>(A16.At(idx));
+        CHECK(static_cast<float>(sum.At(idx)) == value);
+        CHECK(std::abs(static_cast<float>(applied.At(idx)) -
+                       std::tanh(value)) <= epsilon);
+    }
+}
+
 template <typename T>
 void TestTranspose(Compute::Device device)
 {
@@ -231,8 +996,10 @@ void TestTranspose(Compute::Device device)
     }
     else
     {
-        Compute::Ones<T> onesInitializer;
-        onesInitializer.Initialize(in);
+        // Every element is distinct, so any wrong permutation is detected
+        const auto size = batchSize * shapeIn.Size();
+        for (std::size_t idx = 0; idx < size; ++idx)
+            in.At(idx) = static_cast<T>(idx);
     }
 
     zeroInitializer.Initialize(result);
@@ -804,6 +1571,447 @@ void TestBroadcastDot2(Compute::Device device)
         << " Optimized version (microseconds) : "
         << optimizedMulElapsedTime << std::endl;
 }
+
+template <typename T>
+void TestReduce(Compute::Device device, std::size_t batchSize,
+                const Shape& shape)
+{
+    const std::vector<Compute::ReduceOp> ops = {
+        Compute::ReduceOp::Sum, Compute::ReduceOp::Mean,
+        Compute::ReduceOp::Max, Compute::ReduceOp::Min
+    };
+
+    Tensor<T> in(shape, batchSize, device);
+    const auto sampleSize = shape.Size();
+    for (std::size_t idx = 0; idx < batchSize * sampleSize; ++idx)
+    {
+        // Repeated values check that the first maximum is chosen by ArgMax
+        // Sums stay exact in float, so they do not depend on the order
+        in.At(idx) = static_cast<T>((idx * 7919) % 17);
+        if constexpr (std::is_floating_point<T>::value)
+            in.At(idx) /= static_cast<T>(4);
+    }
+
+    const auto check = [](T func, T ans) {
+        if constexpr (std::is_floating_point<T>::value)
+            CHECK(func == doctest::Approx(ans));
+        else
+            CHECK(func == ans);
+    };
+
+    for (std::size_t axis = 0; axis <= shape.Dim(); ++axis)
+    {
+        auto outShape = shape;
+        auto outBatchSize = batchSize;
+        if (axis == Compute::BatchAxis)
+            outBatchSize = 1;
+        else
+            outShape.ChangeDimension(axis - 1, 1);
+        const auto outSize = outBatchSize * outShape.Size();
+
+        for (const auto op : ops)
+        {
+            Tensor<T> result(outShape, outBatchSize, device);
+            Tensor<T> truth(outShape, outBatchSize, device);
+            Compute::Reduce(in, result, axis, op);
+            Test::Reduce(in, truth, axis, op);
+
+            for (std::size_t idx = 0; idx < outSize; ++idx)
+                check(result.At(idx), truth.At(idx));
+        }
+
+        Tensor<int> result(outShape, outBatchSize, device);
+        Tensor<int> truth(outShape, outBatchSize, device);
+        Compute::ArgMax(in, result, axis);
+        Test::ArgMax(in, truth, axis);
+
+        for (std::size_t idx = 0; idx < outSize; ++idx)
+            CHECK(result.At(idx) == truth.At(idx));
+    }
+
+    for (const auto op : ops)
+    {
+        Tensor<T> result(Shape({ 1 }), batchSize, device);
+        Compute::ReduceSamples(in, result, op);
+
+        T total = in.At(0);
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        {
+            T truth = in.At(batchIdx * sampleSize);
+            for (std::size_t idx = 1; idx < sampleSize; ++idx)
+            {
+                const auto val = in.At(batchIdx * sampleSize + idx);
+                if (op == Compute::ReduceOp::Max)
+                    truth = std::max(truth, val);
+                else if (op == Compute::ReduceOp::Min)
+                    truth = std::min(truth, val);
+                else
+                    truth += val;
+            }
+
+            if (batchIdx > 0 && op == Compute::ReduceOp::Max)
+                total = std::max(total, truth);
+            else if (batchIdx > 0 && op == Compute::ReduceOp::Min)
+                total = std::min(total, truth);
+            else if (batchIdx > 0)
+                total += truth;
+            else
+                total = truth;
+
+            if (op == Compute::ReduceOp::Mean)
+                truth /= static_cast<T>(sampleSize);
+            check(result.At(batchIdx), truth);
+        }
+
+        if (op == Compute::ReduceOp::Mean)
+            total /= static_cast<T>(batchSize * sampleSize);
+        check(Compute::ReduceAll(in, op), total);
+    }
+}
+
+template <typename T, typename Function>
+void TestApplyFunction(Compute::Device device, std::size_t batchSize,
+                       const Shape& shape, Function function, T low, T high,
+                       double (*reference)(double))
+{
+    Tensor<T> in(shape, batchSize, device);
+    Tensor<T> out(shape, batchSize, device);
+    const auto total = batchSize * shape.Size();
+    for (std::size_t idx = 0; idx < total; ++idx)
+        in.At(idx) = static_cast<T>(
+            low + (high - low) * static_cast<T>(idx) / static_cast<T>(total));
+
+    Compute::Apply(in, out, function);
+
+    for (std::size_t idx = 0; idx < total; ++idx)
+    {
+        const auto ans = reference(static_cast<double>(in.At(idx)));
+        // Vector kernels are accurate to a few units in the last place
+        const auto tolerance =
+            4 * std::numeric_limits<T>::epsilon() *
+            std::max(std::abs(ans),
+                     static_cast<double>(std::numeric_limits<T>::min()));
+        CHECK(std::abs(out.At(idx) - ans) <= tolerance);
+    }
+}
+
+template <typename T>
+void TestApply(Compute::Device device, std::size_t batchSize,
+               const Shape& shape)
+{
+    TestApplyFunction<T>(device, batchSize, shape, Compute::Exp(), -100, 88,
+                         [](double x) { return std::exp(x); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::Log(), 1e-30f,
+                         1e30f, [](double x) { return std::log(x); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::Log(), 1e-3f, 3,
+                         [](double x) { return std::log(x); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::NegativeLog(),
+                         1e-3f, 1, [](double x) { return -std::log(x); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::Tanh(), -10, 10,
+                         [](double x) { return std::tanh(x); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::Sigmoid(), -80,
+                         80, [](double x) { return 1 / (1 + std::exp(-x)); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::Erf(), -5, 5,
+                         [](double x) { return std::erf(x); });
+    TestApplyFunction<T>(device, batchSize, shape, Compute::LeakyReLU(), -5,
+                         5, [](double x) {
+                             return x > 0 ? x : Compute::LeakyReLUSlope * x;
+                         });
+
+    // Special values follow std:: functions
+    const std::vector<T> specials = {
+        0, -0.0f, 1, -1, std::numeric_limits<T>::infinity(),
+        -std::numeric_limits<T>::infinity(),
+        std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min(),
+        std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(),
+        std::numeric_limits<T>::quiet_NaN()
+    };
+    Tensor<T> in(Shape({ specials.size() }), 1, device);
+    Tensor<T> out(Shape({ specials.size() }), 1, device);
+    for (std::size_t idx = 0; idx < specials.size(); ++idx)
+        in.At(idx) = specials[idx];
+
+    const auto checkSpecial = [&](auto function, auto reference) {
+        Compute::Apply(in, out, function);
+        for (std::size_t idx = 0; idx < specials.size(); ++idx)
+        {
+            const auto ans = reference(specials[idx]);
+            if (std::isnan(ans))
+                CHECK(std::isnan(out.At(idx)));
+            else if (std::isinf(ans) || ans == 0)
+                CHECK(out.At(idx) == ans);
+            else
+                CHECK(out.At(idx) == doctest::Approx(ans));
+        }
+    };
+    checkSpecial(Compute::Exp(), [](T x) { return std::exp(x); });
+    checkSpecial(Compute::Log(), [](T x) { return std::log(x); });
+    checkSpecial(Compute::Tanh(), [](T x) { return std::tanh(x); });
+    checkSpecial(Compute::Sigmoid(),
+                 [](T x) { return static_cast<T>(1) / (1 + std::exp(-x)); });
+    checkSpecial(Compute::Erf(), [](T x) { return std::erf(x); });
+}
+
+inline void TestKernelRegistry()
+{
+    using Compute::BroadcastMode;
+    using Compute::DataType;
+    using Compute::KernelKey;
+    using Compute::KernelLayout;
+    using Compute::KernelOp;
+    auto& registry = Compute::KernelRegistry::Get();
+
+    for (auto level = static_cast<int>(Compute::CPU::InstructionSet::Scalar);
+         level <= static_cast<int>(Compute::CPU::InstructionSet::AVX512);
+         ++level)
+    {
+        const auto isa = static_cast<Compute::CPU::InstructionSet>(level);
+        for (const auto type :
+             { DataType::Float32, DataType::Float64, DataType::Int32 })
+        {
+            for (const auto broadcast :
+                 { BroadcastMode::None, BroadcastMode::BroadcastA,
+                   BroadcastMode::BroadcastB })
+            {
+                for (const auto layout :
+                     { KernelLayout::RowMajor, KernelLayout::TransposeA,
+                       KernelLayout::TransposeB, KernelLayout::TransposeAB })
+                {
+                    CHECK(registry.Contains(
+                        { KernelOp::Multiply, type, isa, broadcast, layout }));
+                    CHECK(registry.Contains({ KernelOp::MultiplyAdd, type,
+                                              isa, broadcast, layout }));
+                }
+                CHECK(registry.Contains({ KernelOp::Add, type, isa,
+                                          broadcast }));
+                CHECK(registry.Contains({ KernelOp::Div, type, isa,
+                                          broadcast }));
+            }
+            CHECK(registry.Contains({ KernelOp::Transpose, type, isa }));
+            CHECK(registry.Contains({ KernelOp::Set, type, isa }));
+            CHECK(registry.Contains({ KernelOp::Apply, type, isa }) ==
+                  (type != DataType::Int32));
+        }
+    }
+
+    // Types without kernels fail when they are resolved, not when called
+    CHECK_THROWS(Compute::ResolveElementwiseKernel<long>(KernelOp::Add));
+
+    // Registered kernels replace built in ones for their key only
+    const KernelKey key{ KernelOp::Set, DataType::Float32,
+                         Compute::CPU::GetInstructionSet() };
+    const auto builtIn =
+        registry.Resolve<Compute::ElementwiseKernelFunction<float>>(key);
+    Compute::ElementwiseKernelFunction<float> custom =
+        [](const Compute::ElementwiseArguments<float>& arguments) {
+            for (std::size_t idx = 0; idx < arguments.Size; ++idx)
+                arguments.Out[idx] = 2 * arguments.Scalar;
+        };
+    registry.Register(key, custom);
+
+    std::vector<float> data(5, 0.0f);
+    Compute::ElementwiseArguments<float> arguments;
+    arguments.Out = data.data();
+    arguments.Size = data.size();
+    arguments.Scalar = 3.0f;
+    Compute::ResolveElementwiseKernel<float>(KernelOp::Set)(arguments);
+    for (const auto value : data)
+        CHECK(value == 6.0f);
+
+    registry.Register(key, builtIn);
+    Compute::ResolveElementwiseKernel<float>(KernelOp::Set)(arguments);
+    for (const auto value : data)
+        CHECK(value == 3.0f);
+}
+
+inline void TestGemmTuner()
+{
+    using Compute::KernelLayout;
+    auto& tuner = Compute::GemmTuner::Get();
+    const auto candidates = Compute::GemmTuner::Candidates();
+
+    // Blocking changes the order of blocks only, so every candidate and
+    // blocks smaller than a register tile compute the same product
+    const std::size_t m = 37, n = 29, k = 53;
+    std::vector<float> A(m * k), B(k * n);
+    for (std::size_t idx = 0; idx < A.size(); ++idx)
+        A[idx] = static_cast<float>(idx % 7) - 3.0f;
+    for (std::size_t idx = 0; idx < B.size(); ++idx)
+        B[idx] = static_cast<float>(idx % 5) - 2.0f;
+
+    Compute::GemmArguments<float> arguments;
+    arguments.A = A.data();
+    arguments.B = B.data();
+    arguments.M = m;
+    arguments.N = n;
+    arguments.K = k;
+    arguments.LdA = k;
+    arguments.LdB = n;
+    arguments.LdOut = n;
+    const auto kernel = Compute::ResolveGemmKernel<float>(
+        Compute::KernelOp::Multiply, Compute::BroadcastMode::None,
+        KernelLayout::RowMajor);
+
+    std::vector<float> expected(m * n), out(m * n);
+    arguments.Out = expected.data();
+    kernel(arguments);
+    for (const auto& blocking :
+         { Compute::CPU::GemmBlocking{ 1, 1, 1 },
+           Compute::CPU::GemmBlocking{ 13, 7, 17 }, candidates.back() })
+    {
+        arguments.Out = out.data();
+        arguments.Blocking = blocking;
+        kernel(arguments);
+        CHECK(out == expected);
+    }
+
+    const auto key = Compute::MakeGemmTuningKey(
+        arguments, Compute::BroadcastMode::None, KernelLayout::RowMajor);
+    const bool enabled = tuner.IsEnabled();
+    tuner.SetEnabled(false);
+    tuner.Clear();
+    CHECK(!tuner.Find(key));
+    CHECK(tuner.Resolve(key) == Compute::CPU::GemmBlocking());
+    CHECK(!tuner.Find(key));
+
+    const auto tuned = tuner.Tune(key);
+    CHECK(std::find(candidates.begin(), candidates.end(), tuned) !=
+          candidates.end());
+    CHECK(tuner.Resolve(key) == tuned);
+
+    // Tuned blockings are restored from the cache file
+    const auto path = (std::filesystem::temp_directory_path() /
+                       "takion_gemm_tuning_test.cache")
+                          .string();
+    tuner.Save(path);
+    tuner.Clear();
+    CHECK(!tuner.Find(key));
+    tuner.Load(path);
+    CHECK(tuner.Find(key) == tuned);
+
+    {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        std::fputs("0 AVX2 0 1 2\n", file);
+        std::fclose(file);
+    }
+    CHECK_THROWS(tuner.Load(path));
+    std::remove(path.c_str());
+    tuner.Clear();
+    tuner.SetEnabled(enabled);
+}
+
+inline void TestJitGemm()
+{
+    using Compute::ActivationType;
+    if (!Compute::Jit::IsSupported())
+        return;
+
+    struct Case
+    {
+        std::size_t M, N, K, LdA, LdB, LdOut, NumMatrices;
+        bool BroadCastC;
+        ActivationType Activation;
+    };
+    // Shapes cover partial tiles of rows and columns, K below and above the
+    // unrolled loop and padded rows
+    const Case cases[] = {
+        { 1, 10, 785, 785, 16, 16, 1, true, ActivationType::None },
+        { 1, 128, 37, 40, 128, 128, 3, true, ActivationType::ReLU },
+        { 6, 29, 3, 8, 32, 32, 2, false, ActivationType::LeakyReLU },
+        { 5, 7, 1, 1, 7, 8, 1, true, ActivationType::ReLU },
+        { 2, 53, 17, 24, 56, 56, 2, false, ActivationType::None },
+    };
+
+    const bool enabled = Compute::Jit::IsEnabled();
+    Compute::Jit::SetEnabled(false);
+    Compute::GemmArguments<float> arguments;
+    CHECK(!Compute::Jit::CompileGemm(arguments));
+    Compute::Jit::SetEnabled(true);
+
+    for (const auto& test : cases)
+    {
+        const auto numMatrices = test.NumMatrices;
+        std::vector<float> A(test.M * test.LdA * numMatrices);
+        std::vector<float> B(test.K * test.LdB);
+        std::vector<float> C(test.M * test.LdOut *
+                             (test.BroadCastC ? 1 : numMatrices));
+        for (std::size_t idx = 0; idx < A.size(); ++idx)
+            A[idx] = static_cast<float>(idx % 13) * 0.25f - 1.5f;
+        for (std::size_t idx = 0; idx < B.size(); ++idx)
+            B[idx] = static_cast<float>(idx % 7) * 0.5f - 1.5f;
+        for (std::size_t idx = 0; idx < C.size(); ++idx)
+            C[idx] = static_cast<float>(idx % 5) - 2.0f;
+
+        // Padding of out is not written
+        const float padding = 123.0f;
+        std::vector<float> out(test.M * test.LdOut * numMatrices, padding);
+
+        arguments.A = A.data();
+        arguments.B = B.data();
+        arguments.C = C.data();
+        arguments.Out = out.data();
+        arguments.M = test.M;
+        arguments.N = test.N;
+        arguments.K = test.K;
+        arguments.LdA = test.LdA;
+        arguments.LdB = test.LdB;
+        arguments.LdOut = test.LdOut;
+        arguments.NumMatrices = numMatrices;
+        arguments.BroadCastC = test.BroadCastC;
+        arguments.Activation = test.Activation;
+
+        const auto kernel = Compute::Jit::CompileGemm(arguments);
+        CHECK(kernel);
+        if (!kernel)
+            continue;
+        CHECK(kernel->Matches(arguments));
+        CHECK(Compute::Jit::CompileGemm(arguments) == kernel);
+        (*kernel)(arguments);
+
+        for (std::size_t matIdx = 0; matIdx < numMatrices; ++matIdx)
+            for (std::size_t row = 0; row < test.M; ++row)
+                for (std::size_t col = 0; col < test.LdOut; ++col)
+                {
+                    const auto outIdx = (matIdx * test.M + row) * test.LdOut +
+                                        col;
+                    if (col >= test.N)
+                    {
+                        CHECK(out[outIdx] == padding);
+                        continue;
+                    }
+
+                    const auto biasIdx =
+                        ((test.BroadCastC ? 0 : matIdx) * test.M + row) *
+                            test.LdOut +
+                        col;
+                    double expected = C[biasIdx];
+                    for (std::size_t k = 0; k < test.K; ++k)
+                        expected +=
+                            static_cast<double>(
+                                A[(matIdx * test.M + row) * test.LdA + k]) *
+                            B[k * test.LdB + col];
+                    if (test.Activation == ActivationType::ReLU)
+                        expected = std::max(expected, 0.0);
+                    if (test.Activation == ActivationType::LeakyReLU &&
+                        expected < 0.0)
+                        expected *= Compute::LeakyReLUSlope;
+                    CHECK(std::abs(out[outIdx] - expected) <=
+                          1e-4 * (1.0 + std::abs(expected)));
+                }
+    }
+
+    // Shapes without generated kernels fall back to the kernel registry
+    arguments.Activation = ActivationType::Sigmoid;
+    CHECK(!Compute::Jit::CompileGemm(arguments));
+    arguments.Activation = ActivationType::None;
+    arguments.Scale = 2.0f;
+    CHECK(!Compute::Jit::CompileGemm(arguments));
+    arguments.Scale = 1.0f;
+    arguments.BroadCastC = true;
+    CHECK(!Compute::Jit::CompileGemm(arguments));
+
+    Compute::Jit::SetEnabled(enabled);
+}
 }
 
 #endif
@@ -7,7 +7,12 @@
 #ifndef TAKION_TEST_SOLIDCOMPUTATIONS_HPP
 #define TAKION_TEST_SOLIDCOMPUTATIONS_HPP
 
+#include <Takion/Computations/GEMM/GemmEpilogue.hpp>
+#include <Takion/Computations/Reductions/ReductionCpu.hpp>
 #include <Takion/Tensors/Tensor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace Takion::Test
 {
@@ -82,6 +87,72 @@ void Multiply(const Tensor<T>& A, const Tensor<T>& B,
     }
 }
 
+template <typename T>
+void Multiply(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out,
+              bool transposeA, bool transposeB)
+{
+    const auto numRow = out.TensorShape.NumRow();
+    const auto numCol = out.TensorShape.NumCol();
+    const auto numMiddle =
+        transposeA ? A.TensorShape.NumRow() : A.TensorShape.NumCol();
+
+    for (std::size_t batchIdx = 0; batchIdx < out.BatchSize; ++batchIdx)
+    {
+        const auto batchIdxA = A.BatchSize == 1 ? 0 : batchIdx;
+        const auto batchIdxB = B.BatchSize == 1 ? 0 : batchIdx;
+        for (std::size_t rowIdx = 0; rowIdx < numRow; ++rowIdx)
+            for (std::size_t colIdx = 0; colIdx < numCol; ++colIdx)
+            {
+                T sum = static_cast<T>(0);
+                for (std::size_t midIdx = 0; midIdx < numMiddle; ++midIdx)
+                {
+                    const auto a =
+                        transposeA ? A.At(batchIdxA, { midIdx, rowIdx })
+                                   : A.At(batchIdxA, { rowIdx, midIdx });
+                    const auto b =
+                        transposeB ? B.At(batchIdxB, { colIdx, midIdx })
+                                   : B.At(batchIdxB, { midIdx, colIdx });
+                    sum += a * b;
+                }
+                out.At(batchIdx, { rowIdx, colIdx }) = sum;
+            }
+    }
+}
+
+template <typename T>
+void MultiplyAdd(const Tensor<T>& A, const Tensor<T>& B, const Tensor<T>& C,
+                 Tensor<T>& out, Compute::ActivationType activation,
+                 T scale)
+{
+    const auto numRow = out.TensorShape.NumRow();
+    const auto numCol = out.TensorShape.NumCol();
+
+    Multiply(A, B, out);
+
+    for (std::size_t batchIdx = 0; batchIdx < out.BatchSize; ++batchIdx)
+        for (std::size_t rowIdx = 0; rowIdx < numRow; ++rowIdx)
+            for (std::size_t colIdx = 0; colIdx < numCol; ++colIdx)
+            {
+                const auto cBatchIdx = C.BatchSize == 1 ? 0 : batchIdx;
+                T value = scale * out.At(batchIdx, { rowIdx, colIdx }) +
+                          C.At(cBatchIdx, { rowIdx, colIdx });
+
+                if (activation == Compute::ActivationType::ReLU)
+                    value = value > static_cast<T>(0) ? value
+                                                      : static_cast<T>(0);
+                else if (activation == Compute::ActivationType::LeakyReLU)
+                    value = value > static_cast<T>(0)
+                                ? value
+                                : static_cast<T>(Compute::LeakyReLUSlope *
+                                                 value);
+                else if (activation == Compute::ActivationType::Sigmoid)
+                    value = static_cast<T>(static_cast<T>(1) /
+                                           (1 + std::exp(-value)));
+
+                out.At(batchIdx, { rowIdx, colIdx }) = value;
+            }
+}
+
 template <typename T>
 void Transpose(const Tensor<T>& in, Tensor<T>& out)
 {
@@ -96,8 +167,8 @@ void Transpose(const Tensor<T>& in, Tensor<T>& out)
         for (std::size_t rowIdx = 0; rowIdx < numRow; ++rowIdx)
             for (std::size_t colIdx = 0; colIdx < numCol; ++colIdx)
             {
-                out.At(matOffset + numCol * rowIdx + colIdx) =
-                    in.At(matOffset + numRow * colIdx + rowIdx);
+                out.At(matOffset + numRow * colIdx + rowIdx) =
+                    in.At(matOffset + numCol * rowIdx + colIdx);
             }
     }
 }
@@ -119,6 +190,94 @@ void Shrink(const Tensor<T>& in, Tensor<T>& out)
         out.At(idx) /= static_cast<T>(batchSize);
 }
 
+//! Calls function(outBatchIdx, outIndex, inBatchIdx, inIndex, axisIdx) for
+//! every element of in, where outIndex is the index of the element of output
+//! it is reduced into
+template <typename T, typename Function>
+void ForEachReduced(const Tensor<T>& in, std::size_t axis, Function function)
+{
+    const auto shape = in.TensorShape;
+    const auto size = shape.Size();
+
+    for (std::size_t batchIdx = 0; batchIdx < in.BatchSize; ++batchIdx)
+        for (std::size_t flatIdx = 0; flatIdx < size; ++flatIdx)
+        {
+            std::vector<std::size_t> index(shape.Dim());
+            auto remaining = flatIdx;
+            for (auto dim = shape.Dim(); dim > 0; --dim)
+            {
+                index[dim - 1] = remaining % shape.At(dim - 1);
+                remaining /= shape.At(dim - 1);
+            }
+
+            auto outIndex = index;
+            auto outBatchIdx = batchIdx;
+            std::size_t axisIdx;
+            if (axis == 0)
+            {
+                axisIdx = batchIdx;
+                outBatchIdx = 0;
+            }
+            else
+            {
+                axisIdx = index[axis - 1];
+                outIndex[axis - 1] = 0;
+            }
+            function(outBatchIdx, outIndex, batchIdx, index, axisIdx);
+        }
+}
+
+template <typename T>
+void Reduce(const Tensor<T>& in, Tensor<T>& out, std::size_t axis,
+            Compute::ReduceOp op)
+{
+    ForEachReduced(in, axis, [&](std::size_t outBatchIdx,
+                                 const std::vector<std::size_t>& outIndex,
+                                 std::size_t batchIdx,
+                                 const std::vector<std::size_t>& index,
+                                 std::size_t axisIdx) {
+        const auto val = in.At(batchIdx, index);
+        auto& dest = out.At(outBatchIdx, outIndex);
+        if (axisIdx == 0)
+            dest = val;
+        else if (op == Compute::ReduceOp::Max)
+            dest = std::max(dest, val);
+        else if (op == Compute::ReduceOp::Min)
+            dest = std::min(dest, val);
+        else
+            dest += val;
+    });
+
+    if (op == Compute::ReduceOp::Mean)
+    {
+        const auto axisSize =
+            axis == 0 ? in.BatchSize : in.TensorShape.At(axis - 1);
+        for (std::size_t idx = 0; idx < out.BatchSize * out.TensorShape.Size();
+             ++idx)
+            out.At(idx) /= static_cast<T>(axisSize);
+    }
+}
+
+template <typename T>
+void ArgMax(const Tensor<T>& in, Tensor<int>& out, std::size_t axis)
+{
+    Tensor<T> max(out.TensorShape, out.BatchSize, out.Device);
+
+    ForEachReduced(in, axis, [&](std::size_t outBatchIdx,
+                                 const std::vector<std::size_t>& outIndex,
+                                 std::size_t batchIdx,
+                                 const std::vector<std::size_t>& index,
+                                 std::size_t axisIdx) {
+        const auto val = in.At(batchIdx, index);
+        auto& maxVal = max.At(outBatchIdx, outIndex);
+        if (axisIdx == 0 || val > maxVal)
+        {
+            maxVal = val;
+            out.At(outBatchIdx, outIndex) = static_cast<int>(axisIdx);
+        }
+    });
+}
+
 template <typename T>
 void Add(const Tensor<T>& A, const Tensor<T>& B, Tensor<T>& out)
 {
@@ -5,6 +5,9 @@
 // property of any third parties.
 
 #include <Takion/FrontEnd/Model.hpp>
+#include <doctest.h>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -215,6 +218,556 @@ void SimpleGraphTestSigmoid()
     model.Fit(5000);
 }
 
+void ActivationFusionTest(bool sigmoid)
+{
+    //! Dense followed by ReLU or Sigmoid is fused by Compile
+    //! Output of the activation must still match input * weight + bias
+    //! activated on host
+    const std::size_t batchSize = 3;
+    const std::size_t inputSize = 37;
+    const std::size_t numUnits = 19;
+
+    std::vector<float> input(batchSize * inputSize);
+    std::vector<float> weight(inputSize * numUnits);
+    std::vector<float> bias(numUnits);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<float>(i % 7) * 0.1f - 0.3f;
+    for (std::size_t i = 0; i < weight.size(); ++i)
+        weight[i] = static_cast<float>(i % 11) * 0.05f - 0.25f;
+    for (std::size_t i = 0; i < bias.size(); ++i)
+        bias[i] = static_cast<float>(i % 5) * 0.2f - 0.4f;
+
+    Model<float> model(Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+                       batchSize);
+    auto tensor = model.Constant(Shape({ inputSize }), input, "input");
+    const auto label = model.Constant(
+        Shape({ numUnits }), std::vector<float>(batchSize * numUnits, 1),
+        "label");
+    tensor = model.Dense(
+        tensor, numUnits,
+        std::make_unique<Compute::VectorInitializer<float>>(weight),
+        std::make_unique<Compute::VectorInitializer<float>>(bias));
+    tensor = sigmoid ? model.Sigmoid(tensor) : model.ReLU(tensor);
+    model.MSE(tensor, label, "MseLoss");
+
+    model.Compile("SGD", Parameter({}, { { "LearningRate", 0.001f } }, {}));
+    model.Predict();
+
+    const auto output = model.Output(tensor);
+    for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        for (std::size_t col = 0; col < numUnits; ++col)
+        {
+            double sum = bias[col];
+            for (std::size_t k = 0; k < inputSize; ++k)
+                sum += static_cast<double>(input[batchIdx * inputSize + k]) *
+                    weight[k * numUnits + col];
+            const double expected =
+                sigmoid
+                    ? 1.0 / (1.0 + std::exp(-sum))
+                    : (sum > 0 ? sum : Compute::LeakyReLUSlope * sum);
+            CHECK(std::abs(output.Data.at(batchIdx * numUnits + col) -
+                           expected) < 1e-4);
+        }
+}
+
+void QuantizedPredictTest()
+{
+    //! Dense units converted to int8 after calibration must predict close to
+    //! the float model they were converted from
+    const std::size_t batchSize = 128;
+    const std::size_t inputSize = 512;
+    const std::size_t hiddenSize = 512;
+    const std::size_t outputSize = 10;
+    const std::size_t numRepeat = 10;
+
+    std::vector<float> input(batchSize * inputSize);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.37f);
+    const auto makeWeight = [](std::size_t size, float scale) {
+        std::vector<float> weight(size);
+        for (std::size_t i = 0; i < size; ++i)
+            weight[i] = std::cos(static_cast<float>(i) * 1.71f) * scale;
+        return weight;
+    };
+
+    Model<float> model(Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+                       batchSize);
+    const auto fetcher = model.Fetcher(Shape({ inputSize }), "input");
+    auto tensor = model.Dense(
+        fetcher, hiddenSize,
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(inputSize * hiddenSize, 0.1f)),
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(hiddenSize, 0.2f)));
+    tensor = model.ReLU(tensor);
+    tensor = model.Dense(
+        tensor, outputSize,
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(hiddenSize * outputSize, 0.05f)),
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(outputSize, 0.2f)));
+    tensor = model.Sigmoid(tensor);
+    const auto label = model.Fetcher(Shape({ outputSize }), "label");
+    model.MSE(tensor, label, "MseLoss");
+    model.Compile("SGD", Parameter({}, { { "LearningRate", 0.001f } }, {}));
+
+    const auto t1 = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < numRepeat; ++i)
+        model.Predict({ { fetcher, input } });
+    const auto t2 = std::chrono::system_clock::now();
+    const auto expected = model.Output(tensor);
+
+    model.Calibrate({ { fetcher, input } });
+    model.Quantize();
+
+    const auto t3 = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < numRepeat; ++i)
+        model.Predict({ { fetcher, input } });
+    const auto t4 = std::chrono::system_clock::now();
+    const auto output = model.Output(tensor);
+
+    for (std::size_t idx = 0; idx < batchSize * outputSize; ++idx)
+        CHECK(std::abs(output.Data.at(idx) - expected.Data.at(idx)) < 0.02f);
+
+    const auto floatElapsedTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+            .count() / numRepeat;
+    const auto quantizedElapsedTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3)
+            .count() / numRepeat;
+
+    std::cout << "Float Predict (microseconds) : " << floatElapsedTime
+        << " Quantized Predict (microseconds) : " << quantizedElapsedTime
+        << std::endl;
+
+    // Float weights are released by quantization
+    CHECK_THROWS(model.Train({ { fetcher, input } }, label,
+                             std::vector<float>(batchSize * outputSize, 1)));
+}
+
+void SparsePredictTest(Compute::SparseFormat format)
+{
+    //! Dense units whose weights are stored in sparse format must predict
+    //! the same as the float model they were converted from. Most weights
+    //! are zero, as in pruned models
+    const std::size_t batchSize = 64;
+    const std::size_t inputSize = 512;
+    const std::size_t hiddenSize = 512;
+    const std::size_t outputSize = 10;
+    const std::size_t numRepeat = 10;
+
+    std::vector<float> input(batchSize * inputSize);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.37f);
+    const auto makeWeight = [](std::size_t size, float scale) {
+        std::vector<float> weight(size);
+        for (std::size_t i = 0; i < size; ++i)
+            weight[i] = (i * 7919) % 10 < 9
+                            ? 0.0f
+                            : std::cos(static_cast<float>(i) * 1.71f) * scale;
+        return weight;
+    };
+
+    Model<float> model(Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+                       batchSize);
+    const auto fetcher = model.Fetcher(Shape({ inputSize }), "input");
+    auto tensor = model.Dense(
+        fetcher, hiddenSize,
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(inputSize * hiddenSize, 0.3f)),
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(hiddenSize, 0.2f)));
+    tensor = model.ReLU(tensor);
+    tensor = model.Dense(
+        tensor, outputSize,
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(hiddenSize * outputSize, 0.3f)),
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(outputSize, 0.2f)));
+    tensor = model.Sigmoid(tensor);
+    const auto label = model.Fetcher(Shape({ outputSize }), "label");
+    model.MSE(tensor, label, "MseLoss");
+    model.Compile("SGD", Parameter({}, { { "LearningRate", 0.001f } }, {}));
+
+    const auto t1 = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < numRepeat; ++i)
+        model.Predict({ { fetcher, input } });
+    const auto t2 = std::chrono::system_clock::now();
+    const auto expected = model.Output(tensor);
+
+    model.Sparsify(format);
+
+    const auto t3 = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < numRepeat; ++i)
+        model.Predict({ { fetcher, input } });
+    const auto t4 = std::chrono::system_clock::now();
+    const auto output = model.Output(tensor);
+
+    for (std::size_t idx = 0; idx < batchSize * outputSize; ++idx)
+        CHECK(output.Data.at(idx) ==
+              doctest::Approx(expected.Data.at(idx)).epsilon(1e-4));
+
+    const auto denseElapsedTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+            .count() / numRepeat;
+    const auto sparseElapsedTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3)
+            .count() / numRepeat;
+
+    std::cout << "Dense Predict (microseconds) : " << denseElapsedTime
+        << " Sparse Predict (microseconds) : " << sparseElapsedTime
+        << std::endl;
+
+    // Float weights are released by conversion
+    CHECK_THROWS(model.Train({ { fetcher, input } }, label,
+                             std::vector<float>(batchSize * outputSize, 1)));
+}
+
+void SparseInputTrainTest()
+{
+    //! Dense units reading sparse features must predict and train like
+    //! units reading the same features stored densely. Features are also
+    //! fed at a dimension whose dense batch would not fit in memory
+    const std::size_t batchSize = 16;
+    const std::size_t inputSize = 2000;
+    const std::size_t hiddenSize = 32;
+    const std::size_t outputSize = 4;
+    const std::size_t numSteps = 10;
+
+    const auto makeBatch = [&](std::size_t numFeatures, std::size_t step) {
+        Compute::CsrMatrix<float> batch;
+        batch.NumCol = numFeatures;
+        for (std::size_t batchIdx = 0; batchIdx < batchSize; ++batchIdx)
+        {
+            std::vector<std::uint32_t> columns;
+            std::vector<float> values;
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                columns.emplace_back(static_cast<std::uint32_t>(
+                    (step * 7 + batchIdx * 577 + i * 8191) % numFeatures));
+                values.emplace_back(
+                    std::sin(static_cast<float>(batchIdx + i) * 0.7f));
+            }
+            batch.AppendRow(columns, values);
+        }
+        return batch;
+    };
+    const auto makeWeight = [](std::size_t size, float scale) {
+        std::vector<float> weight(size);
+        for (std::size_t i = 0; i < size; ++i)
+            weight[i] = std::cos(static_cast<float>(i) * 1.71f) * scale;
+        return weight;
+    };
+    std::vector<float> labelData(batchSize * outputSize);
+    for (std::size_t i = 0; i < labelData.size(); ++i)
+        labelData[i] = i % 3 == 0 ? 1.0f : 0.0f;
+
+    const auto run = [&](bool sparse) {
+        Model<float> model(
+            Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+            batchSize);
+        const auto fetcher =
+            sparse ? model.SparseFetcher(Shape({ inputSize }), "input")
+                   : model.Fetcher(Shape({ inputSize }), "input");
+        auto tensor = model.Dense(
+            fetcher, hiddenSize,
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(inputSize * hiddenSize, 0.3f)),
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(hiddenSize, 0.2f)));
+        tensor = model.ReLU(tensor);
+        tensor = model.Dense(
+            tensor, outputSize,
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(hiddenSize * outputSize, 0.2f)),
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(outputSize, 0.2f)));
+        tensor = model.Sigmoid(tensor);
+        const auto label = model.Fetcher(Shape({ outputSize }), "label");
+        const auto loss = model.MSE(tensor, label, "MseLoss");
+        model.Compile("SGD", Parameter({}, { { "LearningRate", 0.5f } }, {}));
+
+        std::vector<float> result;
+        for (std::size_t step = 0; step < numSteps; ++step)
+        {
+            // Every other batch repeats, so trained rows are read again
+            const auto batch = makeBatch(inputSize, step % 2);
+            if (sparse)
+            {
+                model.SetSparseData(fetcher, batch);
+                model.Train({}, label, labelData);
+            }
+            else
+            {
+                std::vector<float> input(batchSize * inputSize, 0.0f);
+                for (std::size_t row = 0; row < batchSize; ++row)
+                    for (auto idx = batch.RowOffsets[row];
+                         idx < batch.RowOffsets[row + 1]; ++idx)
+                        input[row * inputSize + batch.Columns[idx]] +=
+                            batch.Values[idx];
+                model.Train({ { fetcher, input } }, label, labelData);
+            }
+            result.push_back(model.GetLoss(loss));
+        }
+        for (const auto value : model.Output(tensor).Data)
+            result.push_back(value);
+        return result;
+    };
+
+    const auto expected = run(false);
+    const auto output = run(true);
+    for (std::size_t idx = 0; idx < expected.size(); ++idx)
+        CHECK(output.at(idx) ==
+              doctest::Approx(expected.at(idx)).epsilon(1e-4));
+    CHECK(output.at(numSteps - 1) < output.at(0));
+
+    // 2^20 features with batch size of 16 would take 64MB as dense input
+    const std::size_t numFeatures = std::size_t(1) << 20;
+    Model<float> model(Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+                       batchSize);
+    const auto fetcher = model.SparseFetcher(Shape({ numFeatures }), "input");
+    auto tensor = model.Dense(fetcher, outputSize);
+    tensor = model.Sigmoid(tensor);
+    const auto label = model.Fetcher(Shape({ outputSize }), "label");
+    const auto loss = model.MSE(tensor, label, "MseLoss");
+    model.Compile("SGD", Parameter({}, { { "LearningRate", 0.5f } }, {}));
+
+    const auto batch = makeBatch(numFeatures, 0);
+    model.SetSparseData(fetcher, batch);
+    model.Train({}, label, labelData);
+    const auto firstLoss = model.GetLoss(loss);
+    const auto t1 = std::chrono::system_clock::now();
+    for (std::size_t step = 1; step < numSteps; ++step)
+        model.Train({}, label, labelData);
+    const auto t2 = std::chrono::system_clock::now();
+    CHECK(model.GetLoss(loss) < firstLoss);
+    std::cout << "Sparse input Train (microseconds) : "
+        << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1)
+           .count() / (numSteps - 1)
+        << std::endl;
+
+    // Batches are checked against the shape of the fetcher
+    auto wrongBatch = batch;
+    wrongBatch.Columns.front() = static_cast<std::uint32_t>(numFeatures);
+    model.SetSparseData(fetcher, wrongBatch);
+    CHECK_THROWS(model.Predict());
+}
+
+void HalfPrecisionTest(Compute::Precision precision)
+{
+    //! Dense units storing weights and inputs in 16 bits must predict and
+    //! train close to the float model, as they accumulate in float and keep
+    //! float master weights
+    const std::size_t batchSize = 32;
+    const std::size_t inputSize = 200;
+    const std::size_t hiddenSize = 100;
+    const std::size_t outputSize = 10;
+    const std::size_t numSteps = 20;
+    const float tolerance =
+        precision == Compute::Precision::Float16 ? 0.005f : 0.03f;
+
+    std::vector<float> input(batchSize * inputSize);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.37f);
+    std::vector<float> labelData(batchSize * outputSize);
+    for (std::size_t i = 0; i < labelData.size(); ++i)
+        labelData[i] = i % 3 == 0 ? 1.0f : 0.0f;
+    const auto makeWeight = [](std::size_t size, float scale) {
+        std::vector<float> weight(size);
+        for (std::size_t i = 0; i < size; ++i)
+            weight[i] = std::cos(static_cast<float>(i) * 1.71f) * scale;
+        return weight;
+    };
+
+    const auto run = [&](bool half) {
+        Model<float> model(
+            Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+            batchSize);
+        const auto fetcher = model.Fetcher(Shape({ inputSize }), "input");
+        auto tensor = model.Dense(
+            fetcher, hiddenSize,
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(inputSize * hiddenSize, 0.1f)),
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(hiddenSize, 0.2f)));
+        tensor = model.ReLU(tensor);
+        tensor = model.Dense(
+            tensor, outputSize,
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(hiddenSize * outputSize, 0.05f)),
+            std::make_unique<Compute::VectorInitializer<float>>(
+                makeWeight(outputSize, 0.2f)));
+        tensor = model.Sigmoid(tensor);
+        const auto label = model.Fetcher(Shape({ outputSize }), "label");
+        const auto loss = model.MSE(tensor, label, "MseLoss");
+        model.Compile("SGD", Parameter({}, { { "LearningRate", 0.1f } }, {}));
+        if (half)
+            model.SetPrecision(precision);
+
+        model.Predict({ { fetcher, input } });
+        std::vector<float> result = model.Output(tensor).Data;
+        for (std::size_t step = 0; step < numSteps; ++step)
+            model.Train({ { fetcher, input } }, label, labelData);
+        result.push_back(model.GetLoss(loss));
+        return result;
+    };
+
+    const auto expected = run(false);
+    const auto output = run(true);
+    for (std::size_t idx = 0; idx < batchSize * outputSize; ++idx)
+        CHECK(std::abs(output.at(idx) - expected.at(idx)) < tolerance);
+    CHECK(std::abs(output.back() - expected.back()) <
+          tolerance * expected.back() + 1e-4f);
+}
+
+void BinaryTrainTest()
+{
+    //! Dense units with binary precision must learn through the
+    //! straight-through estimator, and predict the same once binarized
+    const std::size_t batchSize = 32;
+    const std::size_t inputSize = 256;
+    const std::size_t hiddenSize = 64;
+    const std::size_t outputSize = 10;
+    const std::size_t numSteps = 30;
+
+    std::vector<float> input(batchSize * inputSize);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.37f);
+    std::vector<float> labelData(batchSize * outputSize);
+    for (std::size_t i = 0; i < labelData.size(); ++i)
+        labelData[i] = i % 3 == 0 ? 1.0f : 0.0f;
+    const auto makeWeight = [](std::size_t size, float scale) {
+        std::vector<float> weight(size);
+        for (std::size_t i = 0; i < size; ++i)
+            weight[i] = std::cos(static_cast<float>(i) * 1.71f) * scale;
+        return weight;
+    };
+
+    Model<float> model(Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+                       batchSize);
+    const auto fetcher = model.Fetcher(Shape({ inputSize }), "input");
+    // Signs of ReLU outputs would all be positive, so hidden values are
+    // passed on as they are
+    auto tensor = model.Dense(
+        fetcher, hiddenSize,
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(inputSize * hiddenSize, 0.1f)),
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(hiddenSize, 0.2f)));
+    tensor = model.Dense(
+        tensor, outputSize,
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(hiddenSize * outputSize, 0.05f)),
+        std::make_unique<Compute::VectorInitializer<float>>(
+            makeWeight(outputSize, 0.2f)));
+    tensor = model.Sigmoid(tensor);
+    const auto label = model.Fetcher(Shape({ outputSize }), "label");
+    const auto loss = model.MSE(tensor, label, "MseLoss");
+    model.Compile("SGD", Parameter({}, { { "LearningRate", 0.1f } }, {}));
+    model.SetPrecision(Compute::Precision::Binary);
+
+    model.Train({ { fetcher, input } }, label, labelData);
+    const auto initialLoss = model.GetLoss(loss);
+    for (std::size_t step = 1; step < numSteps; ++step)
+        model.Train({ { fetcher, input } }, label, labelData);
+    CHECK(model.GetLoss(loss) < initialLoss);
+
+    model.Predict({ { fetcher, input } });
+    const auto expected = model.Output(tensor);
+    model.Binarize();
+
+    const std::size_t numRepeat = 10;
+    const auto begin = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < numRepeat; ++i)
+        model.Predict({ { fetcher, input } });
+    const auto end = std::chrono::system_clock::now();
+    const auto output = model.Output(tensor);
+    for (std::size_t idx = 0; idx < batchSize * outputSize; ++idx)
+        CHECK(output.Data.at(idx) == expected.Data.at(idx));
+
+    std::cout << "Binary Predict (microseconds) : "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - begin)
+                         .count() /
+                     numRepeat
+              << std::endl;
+
+    // Float weights are released by binarization
+    CHECK_THROWS(model.Train({ { fetcher, input } }, label, labelData));
+}
+
+void DoublePrecisionTest()
+{
+    //! Model<double> must predict and train like Model<float> on the same
+    //! network, and its loss must decrease while training
+    const std::size_t batchSize = 32;
+    const std::size_t inputSize = 200;
+    const std::size_t hiddenSize = 100;
+    const std::size_t outputSize = 10;
+    const std::size_t numSteps = 20;
+
+    const auto run = [&](auto zero) {
+        using T = decltype(zero);
+        std::vector<T> input(batchSize * inputSize);
+        for (std::size_t i = 0; i < input.size(); ++i)
+            input[i] = static_cast<T>(std::sin(static_cast<float>(i) * 0.37f));
+        std::vector<T> labelData(batchSize * outputSize);
+        for (std::size_t i = 0; i < labelData.size(); ++i)
+            labelData[i] = i % 3 == 0 ? 1 : 0;
+        const auto makeWeight = [](std::size_t size, float scale) {
+            std::vector<T> weight(size);
+            for (std::size_t i = 0; i < size; ++i)
+                weight[i] = static_cast<T>(
+                    std::cos(static_cast<float>(i) * 1.71f) * scale);
+            return weight;
+        };
+
+        Model<T> model(Compute::Device(0, Compute::DeviceType::CPU, "device0"),
+                       batchSize);
+        const auto fetcher = model.Fetcher(Shape({ inputSize }), "input");
+        auto tensor = model.Dense(
+            fetcher, hiddenSize,
+            std::make_unique<Compute::VectorInitializer<T>>(
+                makeWeight(inputSize * hiddenSize, 0.1f)),
+            std::make_unique<Compute::VectorInitializer<T>>(
+                makeWeight(hiddenSize, 0.2f)));
+        tensor = model.ReLU(tensor);
+        tensor = model.Dense(
+            tensor, outputSize,
+            std::make_unique<Compute::VectorInitializer<T>>(
+                makeWeight(hiddenSize * outputSize, 0.05f)),
+            std::make_unique<Compute::VectorInitializer<T>>(
+                makeWeight(outputSize, 0.2f)));
+        tensor = model.Sigmoid(tensor);
+        const auto label = model.Fetcher(Shape({ outputSize }), "label");
+        const auto loss = model.MSE(tensor, label, "MseLoss");
+        model.Compile("SGD", Parameter({}, { { "LearningRate", 0.1f } }, {}));
+
+        model.Predict({ { fetcher, input } });
+        std::vector<double> result;
+        for (const auto value : model.Output(tensor).Data)
+            result.push_back(static_cast<double>(value));
+        model.Train({ { fetcher, input } }, label, labelData);
+        result.push_back(static_cast<double>(model.GetLoss(loss)));
+        for (std::size_t step = 1; step < numSteps; ++step)
+            model.Train({ { fetcher, input } }, label, labelData);
+        result.push_back(static_cast<double>(model.GetLoss(loss)));
+        return result;
+    };
+
+    const auto expected = run(0.0f);
+    const auto output = run(0.0);
+    for (std::size_t idx = 0; idx < batchSize * outputSize; ++idx)
+    {
+        CHECK(output.at(idx) != 0.0);
+        CHECK(std::abs(output.at(idx) - expected.at(idx)) < 1e-4);
+    }
+    const auto firstLoss = output.at(output.size() - 2);
+    const auto lastLoss = output.back();
+    CHECK(lastLoss < firstLoss);
+    CHECK(std::abs(lastLoss - expected.back()) < 1e-3 * expected.back());
+}
+
 template <typename T>
 float EvaluateAccuracy(const std::vector<T>& prediction,
                        const std::vector<T>& label, Shape labelShape,
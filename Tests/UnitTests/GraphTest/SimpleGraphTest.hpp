@@ -7,12 +7,29 @@
 #ifndef TAKION_TEST_SIMPLEGRAPHTEST_HPP
 #define TAKION_TEST_SIMPLEGRAPHTEST_HPP
 
+#include <Takion/Computations/GEMM/SparseGemm.hpp>
+#include <Takion/Utils/HalfPrecision.hpp>
+
 namespace Takion::Test
 {
 void SimpleGraphTestReLU();
 
 void SimpleGraphTestSigmoid();
 
+void ActivationFusionTest(bool sigmoid);
+
+void QuantizedPredictTest();
+
+void SparsePredictTest(Compute::SparseFormat format);
+
+void SparseInputTrainTest();
+
+void HalfPrecisionTest(Compute::Precision precision);
+
+void BinaryTrainTest();
+
+void DoublePrecisionTest();
+
 void MnistTrainTest();
 
 void MnistTrainTest2();
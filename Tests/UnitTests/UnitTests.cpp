@@ -12,6 +12,7 @@
 #include "UtilTests/TensorTest.hpp"
 #include "ComputeTests/ComputeTest.hpp"
 #include "GraphTest/SimpleGraphTest.hpp"
+#include <Takion/Computations/Simd/InstructionSet.hpp>
 #include <doctest.h>
 #include <iostream>
 
@@ -90,17 +91,108 @@ TEST_CASE("Computation test")
                 std::cout << "TensorMultiply - int" << std::endl;
                 TestMultiply<int>(device);
             }
+            SUBCASE("double")
+            {
+                std::cout << "TensorMultiply - double" << std::endl;
+                TestMultiply<double>(device);
+                TestBroadcastMultiply1<double>(device);
+                TestBroadcastMultiply2<double>(device);
+                TestBatchedRowMultiply<double>(device);
+            }
             SUBCASE("BroadcastMultiply - float")
             {
                 std::cout << "TensorBroadcastMultiply - float" << std::endl;
                 TestBroadcastMultiply1<float>(device);
                 TestBroadcastMultiply2<float>(device);
+                TestBatchedRowMultiply<float>(device);
             }
             SUBCASE("BroadcastMultiply - int")
             {
                 std::cout << "TensorBroadcastMultiply - int" << std::endl;
                 TestBroadcastMultiply1<int>(device);
                 TestBroadcastMultiply2<int>(device);
+                TestBatchedRowMultiply<int>(device);
+            }
+            SUBCASE("TransposedMultiply - float")
+            {
+                std::cout << "TensorTransposedMultiply - float" << std::endl;
+                TestTransposedMultiply<float>(device, true, false);
+                TestTransposedMultiply<float>(device, false, true);
+                TestTransposedMultiply<float>(device, true, true);
+        TestTransposedMultiply<float>(device, false, true);
+                TestTransposedMeanMultiply<float>(device);
+            }
+            SUBCASE("TransposedMultiply - int")
+            {
+                std::cout << "TensorTransposedMultiply - int" << std::endl;
+                TestTransposedMultiply<int>(device, true, false);
+                TestTransposedMultiply<int>(device, false, true);
+                TestTransposedMultiply<int>(device, true, true);
+                TestTransposedMeanMultiply<int>(device);
+            }
+            SUBCASE("TransposedMultiply - double")
+            {
+                std::cout << "TensorTransposedMultiply - double" << std::endl;
+                TestTransposedMultiply<double>(device, true, false);
+                TestTransposedMultiply<double>(device, false, true);
+                TestTransposedMultiply<double>(device, true, true);
+                TestTransposedMeanMultiply<double>(device);
+            }
+            SUBCASE("MultiplyAdd - float")
+            {
+                std::cout << "TensorMultiplyAdd - float" << std::endl;
+                TestMultiplyAdd<float>(device, Compute::ActivationType::None,
+                                       1.0f);
+                TestMultiplyAdd<float>(device, Compute::ActivationType::ReLU,
+                                       1.0f);
+                TestMultiplyAdd<float>(
+                    device, Compute::ActivationType::LeakyReLU, 0.5f);
+                TestMultiplyAdd<float>(device,
+                                       Compute::ActivationType::Sigmoid, 0.1f);
+            }
+            SUBCASE("MultiplyAdd - int")
+            {
+                std::cout << "TensorMultiplyAdd - int" << std::endl;
+                TestMultiplyAdd<int>(device, Compute::ActivationType::None, 2);
+                TestMultiplyAdd<int>(device, Compute::ActivationType::ReLU, 1);
+            }
+            SUBCASE("MultiplyAdd - double")
+            {
+                std::cout << "TensorMultiplyAdd - double" << std::endl;
+                TestMultiplyAdd<double>(device, Compute::ActivationType::ReLU,
+                                        1.0);
+                TestMultiplyAdd<double>(
+                    device, Compute::ActivationType::LeakyReLU, 0.5);
+                TestMultiplyAdd<double>(device,
+                                        Compute::ActivationType::Sigmoid, 0.1);
+            }
+            SUBCASE("Quantized")
+            {
+                std::cout << "QuantizedMultiply" << std::endl;
+                TestQuantizedMultiply(device);
+                TestQuantize(device);
+            }
+            SUBCASE("Sparse")
+            {
+                std::cout << "SparseMultiply" << std::endl;
+                TestSparseMultiply(device);
+            }
+            SUBCASE("Sparse input")
+            {
+                std::cout << "CsrMultiply" << std::endl;
+                TestCsrMultiply<float>(device);
+                TestCsrMultiply<double>(device);
+            }
+            SUBCASE("Binary")
+            {
+                std::cout << "BinaryMultiply" << std::endl;
+                TestBinaryMultiply(device);
+            }
+            SUBCASE("Half precision")
+            {
+                std::cout << "HalfPrecision" << std::endl;
+                TestHalfPrecision<Float16>(device);
+                TestHalfPrecision<BFloat16>(device);
             }
         }
 
@@ -128,6 +220,13 @@ TEST_CASE("Computation test")
                 TestBroadcastAdd1<int>(device);
                 TestBroadcastAdd2<int>(device);
             }
+            SUBCASE("double")
+            {
+                std::cout << "TensorAdd - double" << std::endl;
+                TestAdd<double>(device);
+                TestBroadcastAdd1<double>(device);
+                TestBroadcastAdd2<double>(device);
+            }
         }
 
         SUBCASE("Shrink")
@@ -142,6 +241,42 @@ TEST_CASE("Computation test")
                 std::cout << "TensorShrink - int" << std::endl;
                 TestShrink<int>(device);
             }
+            SUBCASE("double")
+            {
+                std::cout << "TensorShrink - double" << std::endl;
+                TestShrink<double>(device);
+            }
+        }
+
+        SUBCASE("Reduce")
+        {
+            SUBCASE("float")
+            {
+                std::cout << "TensorReduce - float" << std::endl;
+                TestReduce<float>(device, 20, Shape({ 3, 5, 37 }));
+                TestReduce<float>(device, 40000, Shape({ 10 }));
+                TestReduce<float>(device, 2, Shape({ 200000 }));
+            }
+            SUBCASE("int")
+            {
+                std::cout << "TensorReduce - int" << std::endl;
+                TestReduce<int>(device, 20, Shape({ 3, 5, 37 }));
+                TestReduce<int>(device, 40000, Shape({ 10 }));
+                TestReduce<int>(device, 2, Shape({ 200000 }));
+            }
+            SUBCASE("double")
+            {
+                std::cout << "TensorReduce - double" << std::endl;
+                TestReduce<double>(device, 20, Shape({ 3, 5, 37 }));
+                TestReduce<double>(device, 2, Shape({ 200000 }));
+            }
+        }
+
+        SUBCASE("Apply")
+        {
+            std::cout << "Apply - float" << std::endl;
+            TestApply<float>(device, 20, Shape({ 3, 5, 37 }));
+            TestApply<float>(device, 2, Shape({ 100000 }));
         }
 
         SUBCASE("Dot")
@@ -168,6 +303,13 @@ TEST_CASE("Computation test")
                 TestBroadcastDot1<int>(device);
                 TestBroadcastDot2<int>(device);
             }
+            SUBCASE("double")
+            {
+                std::cout << "TensorDot - double" << std::endl;
+                TestDot<double>(device);
+                TestBroadcastDot1<double>(device);
+                TestBroadcastDot2<double>(device);
+            }
         }
 
         SUBCASE("Transpose")
@@ -182,10 +324,85 @@ TEST_CASE("Computation test")
                 std::cout << "Transpose - int" << std::endl;
                 TestTranspose<int>(device);
             }
+            SUBCASE("double")
+            {
+                std::cout << "Transpose - double" << std::endl;
+                TestTranspose<double>(device);
+            }
         }
     }
 }
 
+TEST_CASE("Instruction set dispatch")
+{
+    // Kernels of every instruction set the processor supports are checked,
+    // not only the one selected by default
+    Compute::Device device(0, Compute::DeviceType::CPU, "device");
+    const auto previous = Compute::CPU::GetInstructionSet();
+    const auto detected = Compute::CPU::DetectInstructionSet();
+
+    for (auto level = static_cast<int>(Compute::CPU::InstructionSet::Scalar);
+         level <= static_cast<int>(detected); ++level)
+    {
+        const auto instructionSet =
+            static_cast<Compute::CPU::InstructionSet>(level);
+        Compute::CPU::SetInstructionSet(instructionSet);
+        std::cout << "Instruction set - "
+                  << Compute::CPU::ToString(instructionSet) << std::endl;
+
+        TestMultiply<float>(device);
+        TestMultiply<int>(device);
+        TestBatchedRowMultiply<float>(device);
+        TestTransposedMultiply<float>(device, true, true);
+        TestTransposedMeanMultiply<float>(device);
+        TestMultiplyAdd<float>(device, Compute::ActivationType::LeakyReLU,
+                               0.5f);
+        TestMultiplyAdd<float>(device, Compute::ActivationType::Sigmoid, 0.1f);
+        TestMultiplyAdd<int>(device, Compute::ActivationType::ReLU, 1);
+        TestMultiply<double>(device);
+        TestBatchedRowMultiply<double>(device);
+        TestTransposedMultiply<double>(device, true, true);
+        TestMultiplyAdd<double>(device, Compute::ActivationType::Sigmoid, 0.1);
+        TestAdd<float>(device);
+        TestAdd<double>(device);
+        TestDot<int>(device);
+        TestShrink<float>(device);
+        TestShrink<double>(device);
+        TestTranspose<float>(device);
+        TestTranspose<int>(device);
+        TestTranspose<double>(device);
+        TestReduce<float>(device, 20, Shape({ 3, 5, 37 }));
+        TestReduce<int>(device, 20, Shape({ 3, 5, 37 }));
+        TestReduce<double>(device, 20, Shape({ 3, 5, 37 }));
+        TestApply<float>(device, 20, Shape({ 3, 5, 37 }));
+        TestQuantizedMultiply(device);
+        TestQuantize(device);
+        TestSparseMultiply(device);
+        TestCsrMultiply<float>(device);
+        TestCsrMultiply<double>(device);
+        TestBinaryMultiply(device);
+        TestHalfPrecision<Float16>(device);
+        TestHalfPrecision<BFloat16>(device);
+    }
+
+    Compute::CPU::SetInstructionSet(previous);
+}
+
+TEST_CASE("Kernel registry")
+{
+    TestKernelRegistry();
+}
+
+TEST_CASE("GEMM tuner")
+{
+    TestGemmTuner();
+}
+
+TEST_CASE("JIT GEMM")
+{
+    TestJitGemm();
+}
+
 TEST_CASE("GraphTest")
 {
     // SUBCASE("SimpleGraph - ReLU")
@@ -198,6 +415,61 @@ TEST_CASE("GraphTest")
     //     SimpleGraphTestSigmoid();
     // }
 
+    SUBCASE("Activation fusion - ReLU")
+    {
+        ActivationFusionTest(false);
+    }
+
+    SUBCASE("Activation fusion - Sigmoid")
+    {
+        ActivationFusionTest(true);
+    }
+
+    SUBCASE("Quantized Predict")
+    {
+        QuantizedPredictTest();
+    }
+
+    SUBCASE("Sparse Predict - CSR")
+    {
+        SparsePredictTest(Compute::SparseFormat::Csr);
+    }
+
+    SUBCASE("Sparse Predict - Block 1x8")
+    {
+        SparsePredictTest(Compute::SparseFormat::Block1x8);
+    }
+
+    SUBCASE("Sparse Predict - Block 4x8")
+    {
+        SparsePredictTest(Compute::SparseFormat::Block4x8);
+    }
+
+    SUBCASE("Sparse input")
+    {
+        SparseInputTrainTest();
+    }
+
+    SUBCASE("Half precision - Float16")
+    {
+        HalfPrecisionTest(Compute::Precision::Float16);
+    }
+
+    SUBCASE("Half precision - BFloat16")
+    {
+        HalfPrecisionTest(Compute::Precision::BFloat16);
+    }
+
+    SUBCASE("Binary precision")
+    {
+        BinaryTrainTest();
+    }
+
+    SUBCASE("Double precision")
+    {
+        DoublePrecisionTest();
+    }
+
     SUBCASE("MNIST - ReLU")
     {
         MnistTrainTest2();